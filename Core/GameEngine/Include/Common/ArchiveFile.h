@@ -31,8 +31,10 @@
 #include "Lib/BaseType.h"
 #include "Common/AsciiString.h"
 #include "Common/ArchiveFileSystem.h"
+#include "Common/ArchivedPathIndex.h"
 
 class File;
+class ArchiveFileMapping;
 
 /**
   *	An archive file is itself a collection of sub files. Each file inside the archive file
@@ -63,10 +65,15 @@ public:
 	void									getFileListInDirectory(const DetailedArchivedDirectoryInfo *dirInfo, const AsciiString& currentDirectory, const AsciiString& searchName, FilenameList &filenameList, Bool searchSubdirectories) const;
 
 	void									addFile(const AsciiString& path, const ArchivedFileInfo *fileInfo); ///< add this file to our directory tree.
+	Bool									getFileOffset(const AsciiString& filename, UnsignedInt *offset) const; ///< get the position of the file in the archive file.
 
 protected:
 	const ArchivedFileInfo *		getArchivedFileInfo(const AsciiString& filename) const;	///< return the ArchivedFileInfo from the directory tree.
+	File *								openMappedFile(const ArchivedFileInfo *fileInfo, Int access);	///< open a read only view of the file in the mapping of the archive, or return null.
 
 	File *m_file; ///< file pointer to the archive file on disk.  Kept open so we don't have to continuously open and close the file all the time.
+	ArchiveFileMapping *m_mapping; ///< TheSuperHackers @performance Mapping of the archive file into memory, created on the first read only open.
+	Bool m_mappingFailed; ///< The archive file cannot be mapped, so its files are copied to the heap.
 	DetailedArchivedDirectoryInfo m_rootDirectory;
+	ArchivedPathIndex<const ArchivedFileInfo *> m_fileIndex; ///< TheSuperHackers @performance The files of m_rootDirectory by their full path.
 };
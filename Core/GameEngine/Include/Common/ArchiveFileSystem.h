@@ -53,6 +53,7 @@
 #include "Common/AsciiString.h"
 #include "Common/FileSystem.h" // for typedefs, etc.
 #include "Common/STLTypedefs.h"
+#include "Common/ArchivedPathIndex.h"
 
 //----------------------------------------------------------------------------
 //           Forward References
@@ -86,6 +87,7 @@ typedef std::map<AsciiString, ArchivedDirectoryInfo> ArchivedDirectoryInfoMap; /
 typedef std::map<AsciiString, ArchivedFileInfo> ArchivedFileInfoMap; // Archived file name to archived file info
 typedef std::map<AsciiString, ArchiveFile *> ArchiveFileMap; // Archive file name to archive data
 typedef std::multimap<AsciiString, ArchiveFile *> ArchivedFileLocationMap; // Archived file name to archive data
+typedef std::vector<ArchiveFile *> ArchiveFileList; // Archives of the same file, the one that overrides the others first
 
 class ArchivedDirectoryInfo
 {
@@ -129,7 +131,8 @@ public:
 	virtual void postProcessLoad() override = 0;
 
 	// ArchiveFile operations
-	virtual ArchiveFile*	openArchiveFile( const Char *filename ) = 0;		///< Create new or return existing Archive file from file name
+	ArchiveFile*					openArchiveFile( const Char *filename );		///< Create new or return existing Archive file from file name
+	virtual ArchiveFile*	tryOpenArchiveFile( const Char *filename, AsciiString &error ) = 0;	///< Same as openArchiveFile, but describes problems in error instead of reporting them, so it can run on a worker thread
 	virtual void					closeArchiveFile( const Char *filename ) = 0;		///< Close the one specified big file.
 	virtual void					closeAllArchiveFiles() = 0;								///< Close all Archive files currently open
 
@@ -161,11 +164,15 @@ protected:
 	};
 
 	ArchivedDirectoryInfoResult getArchivedDirectoryInfo(const Char* directory);
+	ArchiveFile* findArchiveFile(const Char *filename, FileInstance instance) const;	///< return the archive of the file from the index of full paths.
+	static File* openLocalFile(const Char *filename);	///< open a file of the local file system for reading, under a lock because the local file system is not thread safe.
 
 	virtual void loadIntoDirectoryTree(ArchiveFile *archiveFile, Bool overwrite = FALSE);	///< load the archive file's header information and apply it to the global archive directory tree.
+	Bool loadArchiveFiles(const std::vector<AsciiString> &filenames, Bool overwrite);	///< open the archive files in parallel and load them into the directory tree in the order of the list.
 
 	ArchiveFileMap m_archiveFileMap;
 	ArchivedDirectoryInfo m_rootDirectory;
+	ArchivedPathIndex<ArchiveFileList> m_fileIndex; ///< TheSuperHackers @performance The archives of every file in m_rootDirectory by its full path, in the same order.
 };
 
 
@@ -0,0 +1,186 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: ArchivedPathIndex.h //////////////////////////////////////////////////////////////////////
+// Flat hash table from the full path of an archived file to a value
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Common/AsciiString.h"
+
+#include <ctype.h>
+#include <string.h>
+
+// TheSuperHackers @performance Flat open addressing hash table from the normalized full path of an archived
+// file to a value. A lookup hashes the path once, instead of walking the directory tree one directory at a
+// time with a string compare per level.
+template <typename ValueType>
+class ArchivedPathIndex
+{
+public:
+
+	enum { MAX_KEY_LENGTH = _MAX_PATH };
+
+	ArchivedPathIndex() : m_count(0) {}
+
+	void clear()
+	{
+		m_slots.clear();
+		m_count = 0;
+	}
+
+	Int getCount() const { return m_count; }
+
+	/**
+	 * Writes the key of a path to key: lower case, with single backslashes between the directories. Paths
+	 * are split like the directory trees split them. The part that contains the last dot is the file name
+	 * and anything after it is ignored. Without a dot, every part is a directory and the key ends with a
+	 * backslash. Returns FALSE if the key does not fit.
+	 */
+	static Bool makeKey(const Char *path, Char *key, Bool *hasFileName = nullptr)
+	{
+		const Char *lastDot = strrchr(path, '.');
+		Int length = 0;
+		Bool fileName = FALSE;
+		const Char *c = path;
+
+		for (;;)
+		{
+			while (*c == '\\' || *c == '/')
+				++c;
+			if (*c == 0)
+				break;
+
+			const Char *start = c;
+			while (*c != 0 && *c != '\\' && *c != '/')
+			{
+				if (length >= MAX_KEY_LENGTH - 2)
+					return FALSE;
+				key[length++] = (Char)tolower((unsigned char)*c);
+				++c;
+			}
+
+			if (lastDot != nullptr && lastDot >= start && lastDot < c)
+			{
+				fileName = TRUE;
+				break;
+			}
+			key[length++] = '\\';
+		}
+
+		key[length] = 0;
+		if (hasFileName != nullptr)
+			*hasFileName = fileName;
+		return TRUE;
+	}
+
+	// Returns the value of the key, and adds a default value first if the key is new.
+	ValueType &insert(const Char *key)
+	{
+		if ((m_count + 1) * 2 > (Int)m_slots.size())
+			grow();
+
+		const UnsignedInt hash = hashKey(key);
+		const UnsignedInt mask = (UnsignedInt)m_slots.size() - 1;
+		UnsignedInt index = hash & mask;
+		while (m_slots[index].m_used)
+		{
+			if (m_slots[index].m_hash == hash && strcmp(m_slots[index].m_key.str(), key) == 0)
+				return m_slots[index].m_value;
+			index = (index + 1) & mask;
+		}
+
+		Slot &slot = m_slots[index];
+		slot.m_key = key;
+		slot.m_hash = hash;
+		slot.m_used = TRUE;
+		++m_count;
+		return slot.m_value;
+	}
+
+	const ValueType *find(const Char *key) const
+	{
+		if (m_count == 0)
+			return nullptr;
+
+		const UnsignedInt hash = hashKey(key);
+		const UnsignedInt mask = (UnsignedInt)m_slots.size() - 1;
+		UnsignedInt index = hash & mask;
+		while (m_slots[index].m_used)
+		{
+			if (m_slots[index].m_hash == hash && strcmp(m_slots[index].m_key.str(), key) == 0)
+				return &m_slots[index].m_value;
+			index = (index + 1) & mask;
+		}
+		return nullptr;
+	}
+
+private:
+
+	struct Slot
+	{
+		Slot() : m_hash(0), m_used(FALSE), m_value() {}
+
+		AsciiString m_key;
+		UnsignedInt m_hash;
+		Bool m_used;
+		ValueType m_value;
+	};
+
+	// FNV-1a
+	static UnsignedInt hashKey(const Char *key)
+	{
+		UnsignedInt hash = 2166136261u;
+		while (*key != 0)
+		{
+			hash ^= (unsigned char)*key++;
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	// Doubles the table, so that at most half of the slots are used.
+	void grow()
+	{
+		std::vector<Slot> oldSlots;
+		oldSlots.swap(m_slots);
+		m_slots.resize(oldSlots.empty() ? 256 : oldSlots.size() * 2);
+
+		const UnsignedInt mask = (UnsignedInt)m_slots.size() - 1;
+		for (size_t i = 0; i < oldSlots.size(); ++i)
+		{
+			Slot &oldSlot = oldSlots[i];
+			if (!oldSlot.m_used)
+				continue;
+
+			UnsignedInt index = oldSlot.m_hash & mask;
+			while (m_slots[index].m_used)
+				index = (index + 1) & mask;
+
+			Slot &slot = m_slots[index];
+			slot.m_key = oldSlot.m_key;
+			slot.m_hash = oldSlot.m_hash;
+			slot.m_used = TRUE;
+			std::swap(slot.m_value, oldSlot.m_value);
+		}
+	}
+
+	std::vector<Slot> m_slots;
+	Int m_count;
+};
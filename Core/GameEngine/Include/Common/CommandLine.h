@@ -34,4 +34,8 @@ public:
 
 	static void parseCommandLineForStartup();
 	static void parseCommandLineForEngineInit();
+
+	// TheSuperHackers @fix Returns the arguments of this process without the replays to simulate and the number
+	// of jobs, each with a leading space and quoted where needed, so that replay worker processes get the same settings.
+	static AsciiString getArgumentsForReplayWorker();
 };
@@ -105,6 +105,13 @@
 #define RETAIL_COMPATIBLE_PATHFINDING_ALLOCATION (1)
 #endif
 
+// Schedule the sleepy update modules with the heap, which wakes modules that are due in the same frame and phase in the
+// retail order. The timing wheel is faster, but wakes such modules in the order in which they were scheduled.
+// The CMake option RTS_BUILD_OPTION_SLEEPY_UPDATE_WHEEL builds with the timing wheel.
+#ifndef RETAIL_COMPATIBLE_SLEEPY_UPDATES
+#define RETAIL_COMPATIBLE_SLEEPY_UPDATES (1)
+#endif
+
 #ifndef RETAIL_COMPATIBLE_CIRCLE_FILL_ALGORITHM
 #define RETAIL_COMPATIBLE_CIRCLE_FILL_ALGORITHM (1) // Use the original circle fill algorithm, which is more efficient but less accurate
 #endif
@@ -59,6 +59,13 @@
 	#define MEMORYPOOL_DEBUG
 #endif
 
+// TheSuperHackers @performance Every thread caches a few free blocks of each MemoryPool, so that most
+// allocations and frees do not need to take TheMemoryPoolCriticalSection. The debug builds track every
+// block individually and therefore go without the caches.
+#if !defined(MEMORYPOOL_DEBUG) && !defined(DISABLE_MEMORYPOOL_THREAD_CACHE)
+	#define MEMORYPOOL_THREAD_CACHE
+#endif
+
 // SYSTEM INCLUDES ////////////////////////////////////////////////////////////
 
 #include <new.h>
@@ -223,6 +230,7 @@ class MemoryPool;
 class MemoryPoolFactory;
 class DynamicMemoryAllocator;
 class BlockCheckpointInfo;
+struct MemoryPoolThreadCache;
 
 // TYPE DEFINES ///////////////////////////////////////////////////////////////
 
@@ -300,12 +308,17 @@ private:
 	Int								m_allocationSize;						///< size of the blocks allocated by this pool, in bytes
 	Int								m_initialAllocationCount;		///< number of blocks to be allocated in initial blob
 	Int								m_overflowAllocationCount;	///< number of blocks to be allocated in any subsequent blob(s)
-	Int								m_usedBlocksInPool;					///< total number of blocks in use in the pool.
+	long							m_usedBlocksInPool;					///< total number of blocks in use in the pool. (changed with Interlocked functions)
 	Int								m_totalBlocksInPool;				///< total number of blocks in all blobs of this pool (used or not).
-	Int								m_peakUsedBlocksInPool;			///< high-water mark of m_usedBlocksInPool
+	long							m_peakUsedBlocksInPool;			///< high-water mark of m_usedBlocksInPool (changed with Interlocked functions)
 	MemoryPoolBlob		*m_firstBlob;								///< head of linked list: first blob for this pool.
 	MemoryPoolBlob		*m_lastBlob;								///< tail of linked list: last blob for this pool. (needed for efficiency)
 	MemoryPoolBlob		*m_firstBlobWithFreeBlocks;	///< first blob in this pool that has at least one unallocated block.
+#ifdef MEMORYPOOL_THREAD_CACHE
+	Int								m_threadCacheIndex;					///< slot of this pool in the thread caches, or -1 if the blocks are not cached
+	Int								m_threadCacheSize;					///< max number of blocks a thread caches for this pool
+	long							m_threadCacheSerial;				///< changes whenever the blobs are thrown away, which invalidates all cached blocks
+#endif
 
 private:
 	/// create a new blob with the given number of blocks.
@@ -314,6 +327,26 @@ private:
 	/// destroy a blob.
 	Int freeBlob(MemoryPoolBlob *blob);
 
+	/// take a block from the blobs, creating a new blob if necessary. the caller must hold the critical section.
+	MemoryPoolSingleBlock *allocateSingleBlockFromBlobs(DECLARE_LITERALSTRING_ARG1);
+
+	/// return a block to its blob. the caller must hold the critical section.
+	void freeSingleBlockToBlob(MemoryPoolSingleBlock *block);
+
+	/// count a block as used, and update the high-water mark.
+	void addUsedBlock();
+
+#ifdef MEMORYPOOL_THREAD_CACHE
+	/// return the block cache of the calling thread for this pool, or null if the blocks are not cached.
+	MemoryPoolThreadCache *getThreadCache();
+
+	/// move a batch of blocks from the blobs into the given thread cache.
+	void refillThreadCache(MemoryPoolThreadCache *cache);
+
+	/// move up to count blocks from the given thread cache back into the blobs.
+	void drainThreadCache(MemoryPoolThreadCache *cache, Int count);
+#endif
+
 public:
 
 	// 'public' funcs that are really only for use by MemoryPoolFactory
@@ -372,11 +405,17 @@ public:
 	/// return the initial allocation count for this pool
 	Int getInitialBlockCount();
 
+	/// return the overflow allocation count for this pool
+	Int getOverflowBlockCount();
+
 	Int countBlobsInPool();
 
 	/// if this pool has any empty blobs, return them to the system.
 	Int releaseEmpties();
 
+	/// return the blocks cached by the calling thread to this pool.
+	void releaseThreadCache();
+
 	/// destroy all blocks and blobs in this pool.
 	void reset();
 
@@ -403,7 +442,7 @@ private:
 	MemoryPoolFactory					*m_factory;						///< the factory that created us
 	DynamicMemoryAllocator		*m_nextDmaInFactory;	///< linked list node, managed by factory
 	Int												m_numPools;						///< number of subpools (up to MAX_DYNAMICMEMORYALLOCATOR_SUBPOOLS)
-	Int												m_usedBlocksInDma;		///< total number of blocks allocated, from subpools and "raw"
+	long											m_usedBlocksInDma;		///< total number of blocks allocated, from subpools and "raw" (changed with Interlocked functions)
 	MemoryPool								*m_pools[MAX_DYNAMICMEMORYALLOCATOR_SUBPOOLS];	///< the subpools
 	MemoryPoolSingleBlock			*m_rawBlocks;					///< linked list of "raw" blocks allocated directly from system
 
@@ -545,8 +584,22 @@ public:
 	/// destroy the contents of all pools and dmas. (the pools and dma's are not destroyed, just reset)
 	void reset();
 
+	/**
+		return the blocks cached by the calling thread to their pools. threads other than the main thread
+		should call this before they exit, otherwise their cached blocks are lost until the pools are reset.
+	*/
+	void releaseThreadCaches();
+
 	void memoryPoolUsageReport( const char* filename, FILE *appendToFileInstead = nullptr );
 
+	/**
+		write the peak block count of every pool, plus some headroom, as pool sizes to the given file.
+		pool sizes already in the file are only ever raised, so that several matches can be profiled
+		into the same file. the file is written in the MemoryPools.ini format, or as the entries of
+		GameMemoryInitPools/GameMemoryInitDMA if its name ends with ".inl". return false on failure.
+	*/
+	Bool writePoolSizeProfile( const char* filename );
+
 	#ifdef MEMORYPOOL_DEBUG
 
 		/// perform internal consistency checking
@@ -781,6 +834,7 @@ inline Int MemoryPool::getUsedBlockCount() { return m_usedBlocksInPool; }
 inline Int MemoryPool::getTotalBlockCount() { return m_totalBlocksInPool; }
 inline Int MemoryPool::getPeakBlockCount() { return m_peakUsedBlocksInPool; }
 inline Int MemoryPool::getInitialBlockCount() { return m_initialAllocationCount; }
+inline Int MemoryPool::getOverflowBlockCount() { return m_overflowAllocationCount; }
 
 // ----------------------------------------------------------------------------
 inline DynamicMemoryAllocator *DynamicMemoryAllocator::getNextDmaInList() { return m_nextDmaInFactory; }
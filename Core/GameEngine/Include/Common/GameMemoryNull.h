@@ -66,6 +66,10 @@ public:
 
 	void memoryPoolUsageReport( const char* filename, FILE *appendToFileInstead = nullptr );
 
+	void releaseThreadCaches() {}
+
+	Bool writePoolSizeProfile( const char* filename ) { return false; }
+
 #ifdef MEMORYPOOL_DEBUG
 
 	void debugMemoryReport(Int flags, Int startCheckpoint, Int endCheckpoint, FILE *fp = nullptr );
@@ -34,11 +34,13 @@
 #include "Common/STLTypedefs.h"
 #include "Common/AsciiString.h"
 #include "Common/GameCommon.h"
+#include "Common/INICache.h"
 
 //-------------------------------------------------------------------------------------------------
 class INI;
 class Xfer;
 class File;
+class INIFieldParseIndex;
 enum ScienceType CPP_11(: Int);
 
 //-------------------------------------------------------------------------------------------------
@@ -132,6 +134,7 @@ private:
 	enum { MAX_MULTI_FIELDS = 16 };
 
 	const FieldParse* m_fieldParse[MAX_MULTI_FIELDS];
+	const INIFieldParseIndex* m_fieldParseIndex[MAX_MULTI_FIELDS];	///< token index of each table
 	UnsignedInt				m_extraOffset[MAX_MULTI_FIELDS];
 	Int								m_count;
 
@@ -146,6 +149,7 @@ public:
 
 	Int getCount() const { return m_count; }
 	const FieldParse* getNthFieldParse(Int i) const { return m_fieldParse[i]; }
+	const INIFieldParseIndex* getNthFieldParseIndex(Int i) const { return m_fieldParseIndex[i]; }
 	UnsignedInt getNthExtraOffset(Int i) const { return m_extraOffset[i]; }
 };
 
@@ -402,6 +406,14 @@ protected:
 	UnsignedInt m_lineNum;										///< current line number that's been read
 	char m_buffer[ INI_MAX_CHARS_PER_LINE+1 ];///< buffer to read file contents into
 	Bool m_endOfFile;													///< TRUE when we've hit EOF
+
+	// TheSuperHackers @performance State of the INI cache for the file currently loading
+	const char *m_cachedLines;								///< next line to hand out from the INI cache, or null to read the lines from the file
+	Int m_cachedLinesLeft;										///< number of lines from the INI cache left to hand out
+	Bool m_recordLines;												///< TRUE to store the lines of the file in the INI cache when it is loaded
+	std::vector<char> m_recordedLines;				///< lines of the file for the INI cache
+	Int m_recordedLineCount;									///< number of lines in m_recordedLines
+	INICache::SourceStamp m_source;						///< where the file is stored, to find its lines in the INI cache
 #ifdef DEBUG_CRASHING
 	char m_curBlockStart[ INI_MAX_CHARS_PER_LINE+1 ];	///< first line of cur block
 #endif
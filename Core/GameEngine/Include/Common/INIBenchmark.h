@@ -0,0 +1,49 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: INIBenchmark.h ///////////////////////////////////////////////////////////////////////////
+// Measures the parse time and the field lookups of the INI files loaded at startup
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+class MultiIniFieldParse;
+
+// TheSuperHackers @feature Measures the parse time of the INI files that the game loads at startup. While the
+// engine starts, INI::load times each file and INI::initFromINIMulti records the field of each line with the
+// parse tables of its block. Afterwards the recorded field lookups are replayed with the old linear scan of the
+// tables and with the token indexes, and both are printed together with the load time. The replay checks that
+// both find the same entries.
+class INIBenchmark
+{
+public:
+
+	static Bool isRecording();
+
+	static void recordLoad(Int64 ticks, Int lineCount);
+	static void recordFieldLookup(const MultiIniFieldParse &parseTableList, const char *field);
+
+	// Returns exit code 1 if the linear scan and the token indexes found different entries, 0 otherwise.
+	static int run(Int repeats);
+
+	static Int64 getTicks();
+
+private:
+
+	static Real ticksToMs(Int64 ticks);
+};
@@ -0,0 +1,89 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: INICache.h ///////////////////////////////////////////////////////////////////////////////
+// Binary cache of the lines that INI::readLine makes of each INI file
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Common/AsciiString.h"
+#include "Common/STLTypedefs.h"
+
+// TheSuperHackers @performance Keeps the lines that INI::readLine makes of each INI file in a binary file
+// in the user data directory, keyed by the name of the source file and by where it is stored: its size and
+// time, and for a file in an archive the archive and the position in it. The lines are stored without
+// comments and with the white space already replaced, as a length and the characters each. When the source
+// is unchanged, INI::load hands these lines to the parse functions without reading the source at all. The
+// lines are the same, so the INI CRC and the parsed data are the same.
+class INICache
+{
+public:
+
+	// Where a version of a source file is stored, which the file systems know without reading the file.
+	struct SourceStamp
+	{
+		SourceStamp() : m_offset(0), m_size(0), m_timestamp(0) {}
+
+		Bool operator==(const SourceStamp &other) const;
+		Bool operator!=(const SourceStamp &other) const { return !(*this == other); }
+
+		AsciiString m_archiveName;	///< archive that holds the file, or empty for a file on disk
+		UnsignedInt m_offset;	///< position of the file in its archive
+		UnsignedInt m_size;
+		Int64 m_timestamp;	///< last write time of the file on disk, or else of its archive
+	};
+
+	// The lines of one source file.
+	struct Entry
+	{
+		Entry() : m_lineCount(0) {}
+
+		SourceStamp m_source;
+		Int m_lineCount;
+		std::vector<char> m_lines;	///< per line a 16 bit length and the characters
+	};
+
+	INICache();
+
+	// Reads the cache file. A missing or unknown file leaves the cache empty.
+	void load(const AsciiString &filename);
+
+	// Writes the cache file if lines were stored since it was read.
+	void save();
+
+	// Returns the lines of the source, or null if the cache has none for this version of the source.
+	const Entry *find(const AsciiString &sourceName, const SourceStamp &source) const;
+
+	void store(const AsciiString &sourceName, const SourceStamp &source, Int lineCount, const std::vector<char> &lines);
+
+	// Gets where the file that TheFileSystem opens by this name is stored. Returns FALSE if there is no such file.
+	static Bool getSourceStamp(const AsciiString &sourceName, SourceStamp *source);
+
+private:
+
+	typedef std::map<AsciiString, Entry> EntryMap;
+
+	static AsciiString makeKey(const AsciiString &sourceName);
+
+	EntryMap m_entries;
+	AsciiString m_filename;
+	Bool m_dirty;
+};
+
+extern INICache *TheINICache;
@@ -0,0 +1,136 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: INIFieldParseIndex.h /////////////////////////////////////////////////////////////////////
+// Hashed token lookup in the FieldParse tables of the INI parser
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Common/STLTypedefs.h"
+
+#include <string.h>
+
+struct FieldParse;
+
+// TheSuperHackers @performance Flat open addressing hash table from the tokens of a parse table to its entries.
+// The entry type needs a token member. Like the linear scan that it replaces, it compares the tokens case
+// sensitively, and the first entry with a token wins.
+template <typename EntryType>
+class INITokenIndex
+{
+public:
+
+	INITokenIndex() : m_mask(0) {}
+
+	// FNV-1a. Hash the token once and pass the hash to all tables that the token is looked up in.
+	static UnsignedInt hashToken(const char *token)
+	{
+		UnsignedInt hash = 2166136261u;
+		while (*token != 0)
+		{
+			hash ^= (unsigned char)*token++;
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	void build(const EntryType *entries, Int count)
+	{
+		UnsignedInt size = 16;
+		while (size < (UnsignedInt)count * 2)
+			size *= 2;
+
+		m_slots.clear();
+		m_slots.resize(size);
+		m_mask = size - 1;
+
+		for (Int i = 0; i < count; ++i)
+		{
+			const EntryType *entry = &entries[i];
+			const UnsignedInt hash = hashToken(entry->token);
+			if (find(entry->token, hash) != nullptr)
+				continue;
+
+			UnsignedInt index = hash & m_mask;
+			while (m_slots[index].m_entry != nullptr)
+				index = (index + 1) & m_mask;
+
+			m_slots[index].m_hash = hash;
+			m_slots[index].m_entry = entry;
+		}
+	}
+
+	const EntryType *find(const char *token, UnsignedInt hash) const
+	{
+		if (m_slots.empty())
+			return nullptr;
+
+		UnsignedInt index = hash & m_mask;
+		while (m_slots[index].m_entry != nullptr)
+		{
+			if (m_slots[index].m_hash == hash && strcmp(m_slots[index].m_entry->token, token) == 0)
+				return m_slots[index].m_entry;
+			index = (index + 1) & m_mask;
+		}
+		return nullptr;
+	}
+
+private:
+
+	struct Slot
+	{
+		Slot() : m_hash(0), m_entry(nullptr) {}
+
+		UnsignedInt m_hash;
+		const EntryType *m_entry;
+	};
+
+	std::vector<Slot> m_slots;
+	UnsignedInt m_mask;
+};
+
+// TheSuperHackers @performance The token index of one FieldParse table. INI::initFromINIMulti looks the field of
+// each line up in here instead of comparing it with every token of every table of the block.
+class INIFieldParseIndex
+{
+public:
+
+	INIFieldParseIndex() : m_anyToken(nullptr) {}
+
+	// Returns the index of the table and builds it on first use. The parse tables are static, so the index
+	// is kept for the rest of the run and looked up by the address of the table.
+	static const INIFieldParseIndex *get(const FieldParse *parseTable);
+
+	// Returns the first entry with the token, else the terminator of the table if it parses any token, else null.
+	const FieldParse *find(const char *token, UnsignedInt hash) const;
+
+	static UnsignedInt hashToken(const char *token) { return INITokenIndex<FieldParse>::hashToken(token); }
+
+	// The linear scan that the index replaces. Returns the same entries as find.
+	static const FieldParse *findLinear(const FieldParse *parseTable, const char *token);
+
+private:
+
+	typedef std::map<const FieldParse *, INIFieldParseIndex> IndexMap;
+
+	INITokenIndex<FieldParse> m_tokens;
+	const FieldParse *m_anyToken;	///< the terminator of the table, if it has a parse function for all other tokens
+
+	static IndexMap s_indexes;
+};
@@ -0,0 +1,84 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: MappedArchiveFile.h //////////////////////////////////////////////////////////////////////
+// Read only files that point straight into the memory mapping of their archive
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Common/RAMFile.h"
+
+// TheSuperHackers @performance A read only mapping of a whole archive file into memory. The files that are
+// opened from the archive point into the mapping and keep it alive until they are closed, so the archive can
+// be closed before its files.
+class ArchiveFileMapping
+{
+public:
+
+	// Returns null if the file cannot be mapped, or mapping it would take too much of the address space.
+	static ArchiveFileMapping *create(const char *path);
+
+	void addRef();
+	void release();
+
+	const char *getData() const { return m_data; }
+	Int getSize() const { return m_size; }
+
+private:
+
+	ArchiveFileMapping(const char *data, Int size);
+	~ArchiveFileMapping();
+
+	const char *m_data;
+	Int m_size;
+	volatile long m_refCount;
+
+	// Reserves the bytes of a new mapping, or returns false if they would take too much of the address space.
+	static Bool reserveMappedBytes(Int64 size);
+	static void unreserveMappedBytes(Int64 size);
+
+	static Int64 s_mappedBytes;	///< Bytes of all live mappings. Only touch it in a critical section.
+};
+
+// TheSuperHackers @performance A RAMFile whose data is a range of an archive mapping instead of a copy on
+// the heap. Opening it neither allocates nor reads, and read() copies straight out of the mapping.
+class MappedArchiveFile : public RAMFile
+{
+	MEMORY_POOL_GLUE_WITH_USERLOOKUP_CREATE(MappedArchiveFile, "MappedArchiveFile")
+
+protected:
+
+	ArchiveFileMapping *m_mapping;	///< The mapping that m_data points into, or null if m_data is owned.
+
+public:
+
+	MappedArchiveFile();
+	//virtual				~MappedArchiveFile();
+
+	virtual void	close() override;
+
+	Bool openFromMapping(ArchiveFileMapping *mapping, const AsciiString& filename, Int offset, Int size);
+
+	// The caller owns the returned buffer, so this copies the data out of the mapping.
+	virtual char* readEntireAndClose() override;
+
+protected:
+
+	void releaseMapping();
+};
@@ -35,6 +35,12 @@ extern void InitRandom( UnsignedInt seed );
 extern UnsignedInt GetGameLogicRandomSeed();   ///< Get the seed (used for replays)
 extern UnsignedInt GetGameLogicRandomSeedCRC();///< Get the seed (used for CRCs)
 
+class Snapshot;
+
+// TheSuperHackers @fix The seeds of the logic random values for save games. Without them a loaded game
+// continues with the random values of the game that was started last, instead of the saved ones.
+extern Snapshot *TheGameLogicRandomState;
+
 struct RandomValueClass
 {
 	virtual Int GetRandomValueInt( Int lo, Int hi, const char *file, Int line ) const = 0;
@@ -0,0 +1,104 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// The sections of GameLogic::update that are timed individually during a replay benchmark.
+enum ReplayBenchmarkSection CPP_11(: Int)
+{
+	REPLAY_BENCHMARK_SCRIPT_ENGINE,
+	REPLAY_BENCHMARK_TERRAIN_LOGIC,
+	REPLAY_BENCHMARK_CRC,
+	REPLAY_BENCHMARK_SLEEPY_UPDATES,
+	REPLAY_BENCHMARK_AI,
+	REPLAY_BENCHMARK_BUILD_ASSISTANT,
+	REPLAY_BENCHMARK_PARTITION_MANAGER,
+	REPLAY_BENCHMARK_DESTROY_LIST,
+
+	REPLAY_BENCHMARK_SECTION_COUNT
+};
+
+// TheSuperHackers @feature Records the wall time of every logic frame during headless replay simulation,
+// split by the sections of GameLogic::update, and writes a CSV summary with frame time percentiles.
+class ReplayBenchmark
+{
+public:
+
+	static void setEnabled(Bool enabled) { s_enabled = enabled; }
+	static Bool isEnabled() { return s_enabled; }
+
+	static void beginReplay(const AsciiString &filename);
+	static void endReplay(Bool success);
+
+	static void beginFrame();
+	static void endFrame();
+
+	static void addSectionTime(ReplayBenchmarkSection section, Int64 ticks);
+
+	// Writes one row per replay and one row for all replays combined.
+	// Returns false if the file cannot be written.
+	static Bool writeReport(const AsciiString &filename);
+
+	// Discards all recorded replays.
+	static void reset();
+
+	static Int64 getTicks();
+
+private:
+
+	struct ReplayResult
+	{
+		AsciiString filename;
+		Bool success;
+		std::vector<Int64> frameTicks;
+		Int64 sectionTicks[REPLAY_BENCHMARK_SECTION_COUNT];
+		Int64 sectionMaxTicks[REPLAY_BENCHMARK_SECTION_COUNT];
+	};
+
+	static void writeRow(FILE *fp, const char *name, const char *result, const std::vector<Int64> &frameTicks,
+		const Int64 *sectionTicks, const Int64 *sectionMaxTicks);
+	static Real ticksToMs(Int64 ticks);
+
+private:
+
+	static Bool s_enabled;
+	static Int64 s_frequency;
+	static Int64 s_frameStartTicks;
+	static std::vector<ReplayResult> s_results;
+};
+
+// Adds the time spent in the enclosing scope to a benchmark section, if the benchmark is running.
+class ReplayBenchmarkScope
+{
+public:
+	ReplayBenchmarkScope(ReplayBenchmarkSection section)
+		: m_section(section)
+		, m_start(ReplayBenchmark::isEnabled() ? ReplayBenchmark::getTicks() : 0)
+	{
+	}
+
+	~ReplayBenchmarkScope()
+	{
+		if (ReplayBenchmark::isEnabled())
+			ReplayBenchmark::addSectionTime(m_section, ReplayBenchmark::getTicks() - m_start);
+	}
+
+private:
+	ReplayBenchmarkSection m_section;
+	Int64 m_start;
+};
@@ -0,0 +1,328 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: TimingWheel.h ////////////////////////////////////////////////////////////////////////////
+// Hierarchical timing wheel for scheduling sleepy update modules
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+
+// TheSuperHackers @performance A hierarchical timing wheel that schedules items by the priority value of
+// sleepy update modules, which holds the frame in the upper 30 bits and the phase in the lower 2 bits.
+// Pushing, erasing and rescheduling an item is O(1). Items that are due in the current block of
+// NEAR_SLOTS frames are kept in one list per frame and phase, items of the next FAR_SLOTS blocks in one
+// list per block, and all later items in a single overflow list. The lists of a block are distributed
+// when the wheel reaches that block, so each item is moved at most twice.
+//
+// Items with the same priority are returned in the order in which they were pushed or rescheduled. Every
+// push and reschedule numbers the item, and moving a list down links each item behind the last item of
+// its new list with a lower number, so the lists stay in this order however their items arrive.
+// Note that this is not the order of the binary heap in GameLogic, whose order for equal priorities
+// depends on the history of the heap. Items due before the current frame are treated as due now.
+//
+// T is a pointer to a type that provides:
+//   UnsignedInt friend_getPriority() const;
+//   Int friend_getIndexInLogic() const;
+//   void friend_setIndexInLogic(Int index);
+// The wheel stores the index of its internal node in the item.
+template <typename T>
+class TimingWheel
+{
+public:
+
+	enum
+	{
+		PHASE_BITS = 2,
+		PHASE_COUNT = 1 << PHASE_BITS,
+		NEAR_BITS = 8,
+		NEAR_SLOTS = 1 << NEAR_BITS,	///< frames per block
+		FAR_BITS = 6,
+		FAR_SLOTS = 1 << FAR_BITS,	///< blocks that are scheduled ahead of the overflow list
+
+		NEAR_LIST_COUNT = NEAR_SLOTS * PHASE_COUNT,
+		OVERFLOW_LIST = NEAR_LIST_COUNT + FAR_SLOTS,
+		LIST_COUNT = OVERFLOW_LIST + 1
+	};
+
+	TimingWheel() { clear(0); }
+
+	/// Removes all items and sets the current frame. Does not touch the removed items.
+	void clear(UnsignedInt frame);
+
+	/// Removes all items and marks them as not pushed.
+	void release(UnsignedInt frame);
+
+	Int size() const { return m_count; }
+	Bool empty() const { return m_count == 0; }
+
+	/// Returns true if the item is pushed into this wheel.
+	Bool contains(T item) const;
+
+	void push(T item);
+	void erase(T item);
+
+	/// Moves the item to the position of its current priority.
+	void reschedule(T item);
+
+	/// Returns the first item that is due at or before the given frame, or null if there is none.
+	/// Advances the current frame up to the given frame as long as no earlier item is due.
+	T peek(UnsignedInt now);
+
+private:
+
+	struct Node
+	{
+		T item;
+		UnsignedInt64 order;	///< when the item was pushed or rescheduled last
+		Int prev;
+		Int next;
+		Int list;
+	};
+
+	Int getListForPriority(UnsignedInt priority) const;
+	void link(Int nodeIndex, Int list);
+	void linkInOrder(Int nodeIndex, Int list);
+	void unlink(Int nodeIndex);
+	void moveList(Int list);
+	void advanceFrame();
+
+	std::vector<Node> m_nodes;
+	Int m_freeNode;	///< first unused node, linked by Node::next
+	Int m_count;
+	UnsignedInt64 m_nextOrder;
+	UnsignedInt m_frame;	///< the current frame; all lists of earlier frames are empty
+	Int m_head[LIST_COUNT];
+	Int m_tail[LIST_COUNT];
+};
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void TimingWheel<T>::clear(UnsignedInt frame)
+{
+	m_nodes.clear();
+	m_freeNode = -1;
+	m_count = 0;
+	m_nextOrder = 0;
+	m_frame = frame;
+	for (Int i = 0; i < LIST_COUNT; ++i)
+	{
+		m_head[i] = -1;
+		m_tail[i] = -1;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void TimingWheel<T>::release(UnsignedInt frame)
+{
+	for (size_t i = 0; i < m_nodes.size(); ++i)
+	{
+		if (m_nodes[i].item)
+			m_nodes[i].item->friend_setIndexInLogic(-1);
+	}
+	clear(frame);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+Bool TimingWheel<T>::contains(T item) const
+{
+	const Int index = item->friend_getIndexInLogic();
+	return index >= 0 && index < (Int)m_nodes.size() && m_nodes[index].item == item;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+Int TimingWheel<T>::getListForPriority(UnsignedInt priority) const
+{
+	UnsignedInt frame = priority >> PHASE_BITS;
+	const UnsignedInt phase = priority & (PHASE_COUNT - 1);
+	if (frame < m_frame)
+		frame = m_frame;
+
+	const UnsignedInt blocksAhead = (frame >> NEAR_BITS) - (m_frame >> NEAR_BITS);
+	if (blocksAhead == 0)
+		return (Int)((frame & (NEAR_SLOTS - 1)) * PHASE_COUNT + phase);
+
+	if (blocksAhead < FAR_SLOTS)
+		return (Int)(NEAR_LIST_COUNT + ((frame >> NEAR_BITS) & (FAR_SLOTS - 1)));
+
+	return OVERFLOW_LIST;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void TimingWheel<T>::link(Int nodeIndex, Int list)
+{
+	Node &node = m_nodes[nodeIndex];
+	node.list = list;
+	node.next = -1;
+	node.prev = m_tail[list];
+	if (node.prev >= 0)
+		m_nodes[node.prev].next = nodeIndex;
+	else
+		m_head[list] = nodeIndex;
+	m_tail[list] = nodeIndex;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Links the node behind the last node of the list that was scheduled before it.
+template <typename T>
+void TimingWheel<T>::linkInOrder(Int nodeIndex, Int list)
+{
+	Node &node = m_nodes[nodeIndex];
+	Int prev = m_tail[list];
+	while (prev >= 0 && m_nodes[prev].order > node.order)
+		prev = m_nodes[prev].prev;
+
+	node.list = list;
+	node.prev = prev;
+	node.next = prev >= 0 ? m_nodes[prev].next : m_head[list];
+	if (node.next >= 0)
+		m_nodes[node.next].prev = nodeIndex;
+	else
+		m_tail[list] = nodeIndex;
+	if (prev >= 0)
+		m_nodes[prev].next = nodeIndex;
+	else
+		m_head[list] = nodeIndex;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void TimingWheel<T>::unlink(Int nodeIndex)
+{
+	Node &node = m_nodes[nodeIndex];
+	if (node.prev >= 0)
+		m_nodes[node.prev].next = node.next;
+	else
+		m_head[node.list] = node.next;
+	if (node.next >= 0)
+		m_nodes[node.next].prev = node.prev;
+	else
+		m_tail[node.list] = node.prev;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void TimingWheel<T>::push(T item)
+{
+	Int nodeIndex = m_freeNode;
+	if (nodeIndex >= 0)
+	{
+		m_freeNode = m_nodes[nodeIndex].next;
+	}
+	else
+	{
+		nodeIndex = (Int)m_nodes.size();
+		m_nodes.push_back(Node());
+	}
+
+	m_nodes[nodeIndex].item = item;
+	m_nodes[nodeIndex].order = m_nextOrder++;
+	link(nodeIndex, getListForPriority(item->friend_getPriority()));
+	item->friend_setIndexInLogic(nodeIndex);
+	++m_count;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void TimingWheel<T>::erase(T item)
+{
+	const Int nodeIndex = item->friend_getIndexInLogic();
+	unlink(nodeIndex);
+
+	Node &node = m_nodes[nodeIndex];
+	node.item = T();
+	node.list = -1;
+	node.next = m_freeNode;
+	m_freeNode = nodeIndex;
+
+	item->friend_setIndexInLogic(-1);
+	--m_count;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void TimingWheel<T>::reschedule(T item)
+{
+	const Int nodeIndex = item->friend_getIndexInLogic();
+	unlink(nodeIndex);
+	m_nodes[nodeIndex].order = m_nextOrder++;
+	link(nodeIndex, getListForPriority(item->friend_getPriority()));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Links all items of the list again according to the current frame, keeping the order of each list.
+template <typename T>
+void TimingWheel<T>::moveList(Int list)
+{
+	Int nodeIndex = m_head[list];
+	m_head[list] = -1;
+	m_tail[list] = -1;
+
+	while (nodeIndex >= 0)
+	{
+		const Int next = m_nodes[nodeIndex].next;
+		linkInOrder(nodeIndex, getListForPriority(m_nodes[nodeIndex].item->friend_getPriority()));
+		nodeIndex = next;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void TimingWheel<T>::advanceFrame()
+{
+	++m_frame;
+	if ((m_frame & (NEAR_SLOTS - 1)) != 0)
+		return;
+
+	// Entered a new block: distribute its items to the frame lists, then move the items of the block
+	// that came into reach out of the overflow list. The overflow list keeps the items it does not move.
+	moveList(NEAR_LIST_COUNT + ((m_frame >> NEAR_BITS) & (FAR_SLOTS - 1)));
+	moveList(OVERFLOW_LIST);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+T TimingWheel<T>::peek(UnsignedInt now)
+{
+	if (m_count == 0)
+	{
+		if (m_frame < now)
+			m_frame = now;
+		return T();
+	}
+
+	for (;;)
+	{
+		const Int firstList = (Int)((m_frame & (NEAR_SLOTS - 1)) * PHASE_COUNT);
+		for (Int list = firstList; list < firstList + PHASE_COUNT; ++list)
+		{
+			if (m_head[list] >= 0)
+				return m_nodes[m_head[list]].item;
+		}
+
+		if (m_frame >= now)
+			return T();
+
+		advanceFrame();
+	}
+}
@@ -18,9 +18,15 @@
 
 #pragma once
 
+#ifndef _WIN32
+#include <sys/types.h>
+#endif
+
 // Helper class that allows you to start a worker process and retrieve its exit code
 // and console output as a string.
 // It also makes sure that the started process is killed in case our process exits in any way.
+// TheSuperHackers @feature On non-Windows platforms, the worker is started with fork/exec through
+// the shell and its console output is read from a non-blocking pipe.
 class WorkerProcess
 {
 public:
@@ -35,9 +41,14 @@ public:
 	// returns true iff the process exited.
 	bool isDone() const;
 
-	DWORD getExitCode() const;
+	Int getExitCode() const;
 	AsciiString getStdOutput() const;
 
+	// Returns the next line of console output that was not returned before, without the line break.
+	// The last line is only returned when it is complete or when the process exited.
+	// Returns false if there is no such line yet.
+	bool getNextStdOutputLine(AsciiString &line);
+
 	// Terminate Process if it's running
 	void kill();
 
@@ -46,11 +57,19 @@ private:
 	// returns false if the worker is still running
 	bool fetchStdOutput();
 
+	void closeHandles();
+
 private:
+#ifdef _WIN32
 	HANDLE m_processHandle;
 	HANDLE m_readHandle;
 	HANDLE m_jobHandle;
+#else
+	pid_t m_pid;
+	int m_readFd;
+#endif
 	AsciiString m_stdOutput;
-	DWORD m_exitcode;
+	Int m_stdOutputLinePos;
+	Int m_exitcode;
 	bool m_isDone;
 };
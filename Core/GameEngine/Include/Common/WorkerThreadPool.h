@@ -0,0 +1,82 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: WorkerThreadPool.h ///////////////////////////////////////////////////////////////////////
+// A small pool of threads that splits loops over independent items
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// A loop body for WorkerThreadPool::runParallel. run() is called from several threads at once with
+// distinct ranges of items, so it must only write to the data of its own items. The logic singletons
+// such as ThePartitionManager are shared with the calling thread, so run() may read them but not change them.
+class ParallelJob
+{
+public:
+	virtual ~ParallelJob() {}
+
+	// Processes the items in [begin, end).
+	virtual void run(Int begin, Int end) = 0;
+};
+
+// TheSuperHackers @performance Runs the batches of a ParallelJob on a fixed set of threads plus the
+// calling thread. The worker threads take over the floating point control word of the calling thread,
+// so that they compute the same results as the calling thread would. If the pool has no threads, or
+// another thread is using it already, the calling thread runs all items on its own.
+class WorkerThreadPool
+{
+public:
+
+	WorkerThreadPool(Int threadCount);
+	~WorkerThreadPool();
+
+	// Returns the number of threads besides the calling thread.
+	Int getThreadCount() const { return m_threadCount; }
+
+	// Calls job.run for all items in [0, count) in batches of batchSize items and returns when all
+	// batches are done. The order in which the batches run is undefined.
+	void runParallel(ParallelJob &job, Int count, Int batchSize);
+
+	// Returns the number of threads for the processors of this machine, leaving one for the calling thread.
+	static Int getDefaultThreadCount();
+
+private:
+
+	void runBatches();
+
+#ifdef _WIN32
+	static DWORD WINAPI threadProc(LPVOID param);
+
+	HANDLE *m_threads;
+	HANDLE m_startSemaphore;	///< released once per worker that takes part in a run
+	HANDLE m_doneEvent;	///< set by the last worker that finished its part of a run
+#endif
+	Int m_threadCount;
+
+	ParallelJob *m_job;
+	Int m_count;
+	Int m_batchSize;
+	UnsignedInt m_fpControl;
+	Bool m_quit;
+
+	volatile long m_nextItem;
+	volatile long m_pendingWorkers;
+	volatile long m_busy;
+};
+
+extern WorkerThreadPool *TheWorkerThreadPool;
@@ -35,6 +35,8 @@
 //          - XferCRC: Calculate gamestate CRC
 //            - XferDeepCRC: This derives from XferCRC and also writes the gamestate data relevant
 //              to crc calculation to a file (only used in developer builds)
+//            - XferCRCRecorder: This derives from XferCRC and records the crc data of a snapshot,
+//              so that it can be reused while the snapshot does not change
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
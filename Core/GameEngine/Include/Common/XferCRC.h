@@ -35,6 +35,35 @@
 // FORWARD REFERENCES /////////////////////////////////////////////////////////////////////////////
 class Snapshot;
 
+//-------------------------------------------------------------------------------------------------
+/** TheSuperHackers @performance Stores the data that a snapshot passes to a CRC calculation, so
+	* that it can be added to later CRC calculations without walking the snapshot again, as long
+	* as the snapshot state does not change. Data with a size that is not a multiple of 4 bytes is
+	* CRC'd differently than the same bytes within contiguous data, so the recording is split into
+	* segments that end after such data. This keeps the CRC identical. */
+//-------------------------------------------------------------------------------------------------
+class CRCRecording
+{
+
+public:
+
+	CRCRecording() : m_isValid( FALSE ) { }
+
+	Bool isValid() const { return m_isValid; }
+	void invalidate() { m_isValid = FALSE; }
+	Bool isEqual( const CRCRecording &other ) const { return m_data == other.m_data && m_segmentEnds == other.m_segmentEnds; }
+
+private:
+
+	friend class XferCRC;
+	friend class XferCRCRecorder;
+
+	std::vector<UnsignedByte> m_data;
+	std::vector<UnsignedShort> m_segmentEnds;							///< end offsets of the segments in m_data
+	Bool m_isValid;
+
+};
+
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 class XferCRC : public Xfer
@@ -56,6 +85,7 @@ public:
 
 	// Xfer CRC methods
 	virtual UnsignedInt getCRC();										///< get computed CRC in network byte order
+	void xferRecording( const CRCRecording *recording );				///< add the recorded data to the CRC
 
 protected:
 
@@ -66,3 +96,26 @@ protected:
 	UnsignedInt m_crc;
 
 };
+
+//-------------------------------------------------------------------------------------------------
+/** Records the CRC data into a CRCRecording instead of calculating a CRC */
+//-------------------------------------------------------------------------------------------------
+class XferCRCRecorder : public XferCRC
+{
+
+public:
+
+	XferCRCRecorder( CRCRecording *recording );
+	virtual ~XferCRCRecorder() override;
+
+	// Xfer methods
+	virtual void open( AsciiString identifier ) override;		///< start a new recording
+	virtual void close() override;											///< finish and validate the recording
+
+protected:
+
+	virtual void xferImplementation( void *data, Int dataSize ) override;
+
+	CRCRecording *m_recording;
+
+};
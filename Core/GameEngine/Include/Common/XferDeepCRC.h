@@ -54,10 +54,18 @@ public:
 	virtual void xferMarkerLabel( AsciiString asciiStringData ) override;  ///< xfer ascii string (need our own)
 	virtual void xferAsciiString( AsciiString *asciiStringData ) override;  ///< xfer ascii string (need our own)
 	virtual void xferUnicodeString( UnicodeString *unicodeStringData ) override;	///< xfer unicode string (need our own);
+	virtual void xferSnapshot( Snapshot *snapshot ) override;		///< entry point for xfering a snapshot
+
+	// TheSuperHackers @feature Optionally writes a text index next to the dump, which records the
+	// data offsets of all labels and snapshot boundaries. This allows tools to split the dump per
+	// section and per object. Must be called after open.
+	void openIndex( AsciiString indexFileName );
 
 protected:
 
 	virtual void xferImplementation( void *data, Int dataSize ) override;
 
 	FILE * m_fileFP;																			///< pointer to file
+	FILE * m_indexFP;																			///< pointer to index file, can be null
+	UnsignedInt m_dataSize;																///< bytes written to file
 };
@@ -0,0 +1,57 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: XferSaveRAM.h ////////////////////////////////////////////////////////////////////////////
+// Desc:   Xfer memory write implementation
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// USER INCLUDES //////////////////////////////////////////////////////////////////////////////////
+#include "Common/XferSave.h"
+
+//-------------------------------------------------------------------------------------------------
+/** Writes the same data as XferSave, but into a growing memory buffer instead of a file */
+//-------------------------------------------------------------------------------------------------
+class XferSaveRAM : public XferSave
+{
+
+public:
+
+	XferSaveRAM();
+	virtual ~XferSaveRAM() override;
+
+	// Xfer methods
+	virtual void open( AsciiString identifier ) override;		///< start writing to an empty buffer
+	virtual void close() override;											///< stop writing, the buffer stays valid
+	virtual Int beginBlock() override;									///< write placeholder block size
+	virtual void endBlock() override;									///< backup to last begin block and write size
+	virtual void skip( Int dataSize ) override;							///< write dataSize zero bytes
+
+	const UnsignedByte *getData() const { return m_data.empty() ? nullptr : &m_data[0]; }
+	Int getDataSize() const { return (Int)m_data.size(); }
+
+protected:
+
+	virtual void xferImplementation( void *data, Int dataSize ) override;		///< the xfer implementation
+
+	std::vector<UnsignedByte> m_data;												///< the written data
+	std::vector<Int> m_blockPositions;											///< stack of begin block positions
+	Bool m_isOpen;
+
+};
@@ -208,6 +208,7 @@ enum {MAX_WALL_PIECES = 128};
 class PathfindCellInfo
 {
 	friend class PathfindCell;
+	friend class PathfindCellList;
 public:
 #if RETAIL_COMPATIBLE_PATHFINDING
 	static void forceCleanPathFindCellInfos();
@@ -230,6 +231,9 @@ protected:
 
 	UnsignedShort m_totalCost, m_costSoFar;	///< cost estimates for A* search
 
+	Int m_openIndex;														///< index in the open list heap, or -1
+	UnsignedInt m_openOrder;												///< when this was put on the open list heap, breaks ties of m_totalCost
+
 	/// have to include cell's coordinates, since cells are often accessed via pointer only
 	ICoord2D m_pos;
 
@@ -249,28 +253,43 @@ protected:
 };
 
 // TheSuperHackers @info The PathfindCellList class acts as a new management class for the pathfindcell open and closed lists
+// TheSuperHackers @performance With the fixed pathfinding, the open list is a binary heap ordered by the total cost and
+// then by the order in which the cells were put on the list. The head is the same cell that the sorted list would have
+// at its head, because the insertion sorts also put a cell behind all cells of the same cost, but an insert or removal
+// takes O(log n) instead of O(n). The closed list is always a linked list.
 class PathfindCellList
 {
 	friend class PathfindCell;
 
 public:
-	PathfindCellList() : m_head(nullptr), m_tail(nullptr) {}
+	PathfindCellList() : m_head(nullptr), m_nextOpenOrder(0) {}
 
 #if RETAIL_COMPATIBLE_PATHFINDING
-	void reset(PathfindCell* newHead = nullptr) { m_head = newHead; m_tail = nullptr; }
+	void reset(PathfindCell* newHead = nullptr) { m_head = newHead; m_heap.clear(); m_nextOpenOrder = 0; }
 #else
-	void reset() { m_head = nullptr; m_tail = nullptr; }
+	void reset() { m_head = nullptr; m_heap.clear(); m_nextOpenOrder = 0; }
 #endif
 
 	PathfindCell* getHead() const { return m_head; }
 
-	Bool empty() const { return m_head == nullptr; }
+	/// return the cell after the given one, in list order for linked lists and in array order for the heap
+	PathfindCell* getNext(PathfindCell* cell) const;
 
-	Bool canReverseSort(PathfindCell& currentCell) const;
+	Bool empty() const { return m_head == nullptr; }
 
 private:
+	static Bool useHeap();
+	static Bool isHeapBefore(const PathfindCellInfo* a, const PathfindCellInfo* b);
+
+	void heapPush(PathfindCell* cell);
+	void heapRemove(PathfindCell* cell);
+	void heapSiftUp(Int index);
+	void heapSiftDown(Int index);
+	void heapSet(Int index, PathfindCell* cell);
+
 	PathfindCell* m_head;
-	PathfindCell* m_tail;
+	std::vector<PathfindCell*> m_heap;
+	UnsignedInt m_nextOpenOrder;
 };
 
 /**
@@ -338,12 +357,6 @@ public:
 	void forwardInsertionSortRetailCompatible(PathfindCellList& list);
 #endif
 
-	// Forward insertion sort, in ascending cost order
-	void forwardInsertionSort(PathfindCellList& list);
-
-	// Reverse insertion sort, in ascending cost order
-	void reverseInsertionSort(PathfindCellList& list);
-
 	/// put self on "open" list in ascending cost order
 	void putOnSortedOpenList( PathfindCellList &list );
 
@@ -376,8 +389,6 @@ public:
 	inline UnsignedInt getCostSoFar() const {return m_info->m_costSoFar;}
 	inline UnsignedInt getTotalCost() const {return m_info->m_totalCost;}
 
-	inline UnsignedInt getTotalCostDifference(PathfindCell& other) const;
-
 	inline void setCostSoFar(UnsignedInt cost) { if( m_info ) m_info->m_costSoFar = cost;}
 	inline void setTotalCost(UnsignedInt cost) { if( m_info ) m_info->m_totalCost = cost;}
 
@@ -411,6 +422,8 @@ public:
 	PathfindLayerEnum getConnectLayer() const { return (PathfindLayerEnum)m_connectsToLayer; }				///< get the cell layer connect id
 
 private:
+	friend class PathfindCellList;
+
 	PathfindCellInfo *m_info;
 	ObjectID m_obstacleID;	                  ///< the object ID who overlaps this cell
 	UnsignedInt m_blockedByAlly : 1;          ///< True if this cell is blocked by an allied unit.
@@ -457,6 +470,7 @@ public:
 	void applyZone(); // Propagates m_zone to all cells.
 	void getStartCellIndex(ICoord2D *start) {*start = m_startCell;}
 	void getEndCellIndex(ICoord2D *end) {*end = m_endCell;}
+	void getCellBounds(IRegion2D *bounds) const {bounds->lo.x = m_xOrigin; bounds->lo.y = m_yOrigin; bounds->hi.x = m_xOrigin+m_width-1; bounds->hi.y = m_yOrigin+m_height-1;}
 
 	ObjectID getBridgeID();
 	Bool connectsZones(PathfindZoneManager *zm, const LocomotorSet& locomotorSet,Int zone1, Int zone2);
@@ -495,6 +509,29 @@ enum { PATHFIND_QUEUE_LEN=512};
 
 struct TCheckMovementInfo;
 
+/**
+ * TheSuperHackers @performance Two zones of adjacent cells that are equivalent in some of the zone
+ * equivalency arrays of the zone manager. A zone block keeps the links of its cells to their left and
+ * top neighbors and to the bridge layers, so that the arrays can be rebuilt without scanning the map.
+ */
+struct PathfindZoneLink
+{
+	enum
+	{
+		HIERARCHICAL	= 0x01,
+		GROUND_WATER	= 0x02,
+		GROUND_RUBBLE	= 0x04,
+		GROUND_CLIFF	= 0x08,
+		TERRAIN				= 0x10,
+		CRUSHER				= 0x20
+	};
+
+	zoneStorageType m_zone1;
+	zoneStorageType m_zone2;
+	UnsignedByte m_equivalencies;	///< The arrays in which the zones are equivalent.
+};
+typedef std::vector<PathfindZoneLink> PathfindZoneLinkVector;
+
 /**
  * This class is a helper class for zone manager.  It maintains information regarding the
  * LocomotorSurfaceTypeMask equivalencies within a ZONE_BLOCK_SIZE x ZONE_BLOCK_SIZE area of
@@ -508,8 +545,16 @@ public:
 	~ZoneBlock();  // not virtual, please don't override without making virtual.  jba.
 
 	void blockCalculateZones(	PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds);	///< Does zone calculations.
+	void blockCalculateLinks(	PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds, const IRegion2D &globalBounds);	///< Collects the zone links of the cells.
+	void renumberZones(const zoneStorageType *newZones);	///< Moves the zones and links of the block to newZones[zone], see PathfindZoneManager::renumberZones.
 	zoneStorageType getEffectiveZone(LocomotorSurfaceTypeMask acceptableSurfaces, Bool crusher, zoneStorageType zone) const;
 
+	const PathfindZoneLinkVector &getLinks() const {return m_links;}
+	zoneStorageType getFirstZone() const {return m_firstZone;}
+	UnsignedShort getNumZones() const {return m_numZones;}
+	UnsignedShort getReservedZones() const {return m_reservedZones;}
+	void setReservedZones(UnsignedShort count) {m_reservedZones = count;}
+
 	void clearMarkedPassable() {m_markedPassable = false;}
 	Bool isPassable() {return m_markedPassable;}
 	void setPassable(Bool pass) {m_markedPassable = pass;}
@@ -517,9 +562,13 @@ public:
 	Bool getInteractsWithBridge() const {return m_interactsWithBridge;}
 	void setInteractsWithBridge(Bool interacts) {m_interactsWithBridge = interacts;}
 
+	UnsignedInt getVersion() const {return m_version;}
+	void setVersion(UnsignedInt version) {m_version = version;}
+
 protected:
 	void allocateZones();
 	void freeZones();
+	void addLink(zoneStorageType zone1, zoneStorageType zone2, UnsignedByte equivalencies);
 
 protected:
 	ICoord2D		m_cellOrigin;
@@ -535,6 +584,9 @@ protected:
 	zoneStorageType *m_crusherZones;
 	Bool					m_interactsWithBridge;
 	Bool					m_markedPassable;
+	UnsignedInt		m_version;	///< Changes whenever the zones of the cells of this block are recalculated.
+	UnsignedShort m_reservedZones;	///< Zones from m_firstZone on that belong to this block, see PathfindZoneManager::repairZones.
+	PathfindZoneLinkVector m_links;
 };
 typedef ZoneBlock *ZoneBlockP;
 
@@ -560,13 +612,20 @@ public:
 
 	Bool needToCalculateZones() const {return m_nextFrameToCalculateZones <= TheGameLogic->getFrame() ;} ///< Returns true if the zones need to be recalculated.
 	void markZonesDirty() ; ///< Called when the zones need to be recalculated.
+	UnsignedInt getNextFrameToCalculateZones() const {return m_nextFrameToCalculateZones;}
+	void setNextFrameToCalculateZones(UnsignedInt frame) {m_nextFrameToCalculateZones = frame;} ///< Restores a pending recalculation on load.
 	void updateZonesForModify( PathfindCell **map,  PathfindLayer layers[], const IRegion2D &structureBounds, const IRegion2D &globalBounds ) ; ///< Called to recalculate an area when a structure has been removed.
+	Bool repairZones( PathfindCell **map, PathfindLayer layers[], const IRegion2D &cellBounds, const IRegion2D &globalBounds ); ///< Recalculates the zones of the blocks around changed cells. Returns true if existing zones got new numbers.
 	void calculateZones(	PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds);	///< Does zone calculations.
 	zoneStorageType getEffectiveZone(LocomotorSurfaceTypeMask acceptableSurfaces, Bool crusher, zoneStorageType zone) const;
 	zoneStorageType getEffectiveTerrainZone(zoneStorageType zone) const;
 
 	void getExtent(ICoord2D &extent) const {extent = m_zoneBlockExtent;}
 
+	UnsignedInt getZoneVersion() const {return m_zoneVersion;} ///< Returns the most recent version of any block.
+	UnsignedInt getBlockVersion(Int blockX, Int blockY) const {return m_zoneBlocks[blockX][blockY].getVersion();}
+	UnsignedInt getEquivalencyVersion() const {return m_equivalencyVersion;} ///< Returns the zone version at which the zone equivalency arrays were last built.
+
 	/// return zone relative the the block zone that this cell resides in.
 	zoneStorageType getBlockZone(LocomotorSurfaceTypeMask acceptableSurfaces, Bool crusher, Int cellX, Int cellY, PathfindCell **map) const;
 	void allocateBlocks(const IRegion2D &globalBounds);
@@ -586,13 +645,25 @@ private:
 	void freeZones();
 	void freeBlocks();
 
+	Bool getBlockBounds(Int xBlock, Int yBlock, const IRegion2D &globalBounds, IRegion2D &bounds) const;
+	void repairBlockZones(PathfindCell **map, PathfindLayer layers[], Int xBlock, Int yBlock, const IRegion2D &bounds);
+	Bool renumberZones(PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds);
+	void calculateZoneLinks(PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds);
+	void rebuildZoneEquivalencies();
+	void applyBridges(PathfindLayer layers[]);
+
 private:
+	enum {MAX_ZONES = 0x4000};	///< Zones must fit into the bits of PathfindCell::m_zone.
+
 	ZoneBlock			*m_blockOfZoneBlocks;			///< Zone blocks - Info for hierarchical pathfinding at a "blocky" level.
 	ZoneBlock			**m_zoneBlocks;						///< Zone blocks as a matrix - contains matrix indexing into the map.
 	ICoord2D			m_zoneBlockExtent;				///< Zone block extents. Not the same scale as the pathfind extents.
 
 	UnsignedShort m_maxZone;								///< Max zone used.
 	UnsignedInt		m_nextFrameToCalculateZones;		///< When should I recalculate, next?.
+	UnsignedInt		m_zoneVersion;									///< Last version given to a block, see ZoneBlock::getVersion.
+	UnsignedInt		m_equivalencyVersion;						///< Zone version when the zone equivalency arrays were last built.
+	Bool					m_zoneLinksValid;								///< The blocks hold the links of the current zones, see repairZones.
 	UnsignedShort m_zonesAllocated;
 	zoneStorageType *m_groundCliffZones;
 	zoneStorageType *m_groundWaterZones;
@@ -602,6 +673,248 @@ private:
 	zoneStorageType *m_hierarchicalZones;
 };
 
+/**
+ * TheSuperHackers @feature The portal graph of the zone blocks for one combination of locomotor surfaces
+ * and crusher flag, for hierarchical pathfinding in the style of HPA*. A portal is a pair of adjacent
+ * cells on the border of two blocks whose block zones can be crossed with these surfaces. Every run of
+ * such pairs along a block side is merged into one portal in the middle of the run. The portals of a
+ * block are built when a search first expands the block, and built again after the zones of the block
+ * or of one of its neighbors have changed, see ZoneBlock::getVersion, or after the zone equivalencies
+ * of the map have changed, because they decide which block zones can be crossed. Bridges are not part of the graph,
+ * because they are repaired and destroyed without a change of the zones.
+ */
+class PathfindPortalGraph
+{
+public:
+	struct Portal
+	{
+		ICoord2D m_from;							///< Border cell in the block.
+		ICoord2D m_to;								///< Adjacent cell in the neighboring block.
+		zoneStorageType m_fromZone;		///< Block zone of m_from.
+		zoneStorageType m_toZone;			///< Block zone of m_to.
+		Bool m_pinched;								///< True if all the cells of the run are pinched.
+		UnsignedInt m_searchID;				///< Last search that went through this portal.
+	};
+	typedef std::vector<Portal> PortalVector;
+
+	PathfindPortalGraph();
+
+	void reset();
+	void init(LocomotorSurfaceTypeMask surfaces, Bool crusher, const ICoord2D &blockExtent);
+	Bool isFor(LocomotorSurfaceTypeMask surfaces, Bool crusher, const ICoord2D &blockExtent) const;
+
+	UnsignedInt getLastUse() const {return m_lastUse;}
+	void setLastUse(UnsignedInt use) {m_lastUse = use;}
+
+	UnsignedInt beginSearch(); ///< Returns a new search id for Portal::m_searchID.
+
+	/// Returns the portals of the block, after building them if they are out of date.
+	PortalVector &getPortals(const PathfindZoneManager &zoneManager, PathfindCell **map,
+		const IRegion2D &extent, Int blockX, Int blockY);
+
+private:
+	struct Block
+	{
+		PortalVector m_portals;
+		UnsignedInt m_version;	///< Zone version when the portals were built.
+		Bool m_built;
+	};
+
+	Bool isOutOfDate(const PathfindZoneManager &zoneManager, Int blockX, Int blockY) const;
+	void buildPortals(const PathfindZoneManager &zoneManager, PathfindCell **map, const IRegion2D &extent,
+		Int blockX, Int blockY);
+	void addSidePortals(const PathfindZoneManager &zoneManager, PathfindCell **map, PortalVector &portals,
+		const ICoord2D &first, const ICoord2D &step, const ICoord2D &delta, Int count);
+
+	std::vector<Block> m_blocks;
+	ICoord2D m_blockExtent;
+	LocomotorSurfaceTypeMask m_surfaces;
+	Bool m_crusher;
+	Bool m_initialized;
+	UnsignedInt m_lastUse;
+	UnsignedInt m_searchID;
+};
+
+/// A search node of Pathfinder::internal_findPortalPath.
+struct PathfindPortalNode
+{
+	ICoord2D m_cell;
+	zoneStorageType m_zone;	///< Block zone of m_cell.
+	Int m_costSoFar;
+	Int m_totalCost;
+	Int m_parent;						///< Index of the previous node, or -1 for the start node.
+};
+
+/**
+ * TheSuperHackers @performance A small cache of recent ground paths, so that the members of a group that
+ * are ordered to the same place can patch into the path of the first member instead of searching their
+ * own. Paths are keyed by the locomotor surfaces, crusher flag and size of the unit, and by the zone
+ * blocks of the start and goal cells. A path is dropped when cells close to it change.
+ */
+class PathfindPathCache
+{
+public:
+	struct Key
+	{
+		LocomotorSurfaceTypeMask m_surfaces;
+		Bool m_crusher;
+		Bool m_isHuman;
+		Bool m_centerInCell;
+		Int m_radius;
+		ICoord2D m_fromBlock;
+		ICoord2D m_toBlock;
+		zoneStorageType m_fromZone;	///< Block zone of the start cell.
+		zoneStorageType m_toZone;		///< Block zone of the goal cell.
+
+		Bool operator==(const Key &other) const;
+	};
+
+	struct Node
+	{
+		Coord3D m_pos;
+		PathfindLayerEnum m_layer;
+	};
+	typedef std::vector<Node> NodeVector;
+
+	enum {MAX_ENTRIES = 16};
+
+	PathfindPathCache();
+
+	void clear();
+	const NodeVector *find(const Key &key);	///< Returns the nodes of the cached path, or null.
+	void add(const Key &key, Path *path);
+	void invalidate(const IRegion2D &cellBounds);	///< Drops the paths that pass close to the cells.
+	void xfer(Xfer *xfer);	///< Saves and loads the cached paths, see Pathfinder::xfer.
+
+	void countHit() {++m_hits;}
+	void countMiss() {++m_misses;}
+	Int getHits() const {return m_hits;}
+	Int getMisses() const {return m_misses;}
+	void resetCounters() {m_hits = 0; m_misses = 0;}
+
+private:
+	struct Entry
+	{
+		Key m_key;
+		NodeVector m_nodes;
+		IRegion2D m_bounds;			///< Cells covered by the path, grown by the radius of the unit.
+		UnsignedInt m_lastUse;
+		Bool m_used;
+	};
+
+	Entry m_entries[MAX_ENTRIES];
+	UnsignedInt m_useCount;
+	Int m_hits;
+	Int m_misses;
+};
+
+/**
+ * TheSuperHackers @performance The ground path costs from every cell around a group move to its destination,
+ * so that the members of a large group can follow the costs down to the destination instead of searching
+ * their own paths. A group move requests the field for its members, and the first member that searches a path
+ * computes it for its locomotor surfaces with a single Dijkstra search over the cells around the group and the
+ * goal. Only the members of that group move use the field.
+ */
+class PathfindFlowField
+{
+public:
+	enum {UNREACHED = 0x7fffffff};
+
+	PathfindFlowField();
+
+	void clear();
+	void request(const ICoord2D &goal, const IRegion2D &bounds, UnsignedInt frame, const ObjectIDVector &members);
+	void invalidate(const IRegion2D &cellBounds);	///< Clears the field if it covers any of the cells.
+	void reset(LocomotorSurfaceTypeMask surfaces, Bool crusher, Bool isHuman);	///< Sets all costs to UNREACHED.
+	void xfer(Xfer *xfer);	///< Saves and loads the request and the costs, see Pathfinder::xfer.
+
+	Bool isRequested() const {return m_requested;}
+	Bool isComputed() const {return m_computed;}
+	Bool matches(LocomotorSurfaceTypeMask surfaces, Bool crusher, Bool isHuman) const;
+	Bool isMember(ObjectID id) const;		///< Returns true if the object was in the group move of the request.
+
+	const ICoord2D &getGoal() const {return m_goal;}
+	const IRegion2D &getBounds() const {return m_bounds;}
+	UnsignedInt getFrame() const {return m_frame;}
+	LocomotorSurfaceTypeMask getSurfaces() const {return m_surfaces;}
+	Bool isCrusher() const {return m_crusher;}
+	Bool isHuman() const {return m_isHuman;}
+
+	Bool isInBounds(Int x, Int y) const;
+	UnsignedInt getCost(Int x, Int y) const;		///< Returns UNREACHED outside the bounds.
+	void setCost(Int x, Int y, UnsignedInt cost);
+
+	struct OpenCell
+	{
+		UnsignedInt m_cost;
+		Int m_x;
+		Int m_y;
+	};
+	void pushOpenCell(const OpenCell &cell);
+	Bool popOpenCell(OpenCell &cell);		///< Returns the open cell with the lowest cost, or false if there is none.
+
+private:
+	Bool m_requested;
+	Bool m_computed;
+	ICoord2D m_goal;
+	IRegion2D m_bounds;
+	UnsignedInt m_frame;				///< Frame of the request.
+	ObjectIDVector m_members;		///< Members of the group move, sorted.
+	LocomotorSurfaceTypeMask m_surfaces;
+	Bool m_crusher;
+	Bool m_isHuman;
+	std::vector<UnsignedInt> m_costs;		///< Cost to the goal per cell in m_bounds, column by column.
+	std::vector<OpenCell> m_openList;		///< Binary heap of the cells to expand, ordered by cost.
+};
+
+/**
+ * TheSuperHackers @performance Caches recent isAttackViewBlockedByObstacle cell walks, keyed on their inputs.
+ * Any change to the pathfind cells clears it: classifying objects, fences, bridges or the map, and reset or load.
+ */
+class PathfindLineOfSightCache
+{
+public:
+	struct Key
+	{
+		Coord2D m_from;
+		Coord2D m_to;
+		PathfindLayerEnum m_layer;				///< Layer of the walk.
+		PathfindLayerEnum m_victimLayer;	///< Layer of the cell of the victim.
+		Int m_skipCount;
+		ObjectID m_attacker;
+		ObjectID m_attackerContainer;
+		ObjectID m_attackerSlaver;
+		ObjectID m_victim;
+		ObjectID m_victimSlaver;
+
+		Bool operator==(const Key &other) const;
+		UnsignedInt hash() const;
+	};
+
+	enum {MAX_ENTRIES = 256};
+
+	PathfindLineOfSightCache();
+
+	void clear();
+	Bool find(const Key &key, Bool &blocked);	///< Returns true and the cached result if the key is in the cache.
+	void add(const Key &key, Bool blocked);
+
+	Int getHits() const {return m_hits;}
+	Int getMisses() const {return m_misses;}
+
+private:
+	struct Entry
+	{
+		Key m_key;
+		Bool m_blocked;
+		Bool m_used;
+	};
+
+	Entry m_entries[MAX_ENTRIES];
+	Int m_hits;
+	Int m_misses;
+};
+
 /**
  * The pathfinding services interface provides access to the 3 expensive path find calls:
  * findPath, findClosestPath, and findAttackPath.
@@ -639,6 +952,9 @@ public:
  */
 class Pathfinder : PathfindServicesInterface, public Snapshot
 {
+	// TheSuperHackers @feature The benchmark runs the private path queries directly, without the pathfind queue.
+	friend class PathfindBenchmark;
+
 // The following routines are private, but available through the doPathfind callback to aiInterface. jba.
 private:
 	virtual Path *findPath( Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to) override;	///< Find a short, valid path between given locations
@@ -707,6 +1023,9 @@ public:
 
 	void changeBridgeState( PathfindLayerEnum layer, Bool repaired );
 
+	/// Lets the members of a group move that search their paths within the next frames follow a flow field to the goal.
+	void requestFlowField( const Coord3D *goal, const Coord2D *groupMin, const Coord2D *groupMax, const ObjectIDVector &members );
+
 	Bool findBrokenBridge(const LocomotorSet &locomotorSet, const Coord3D *from, const Coord3D *to, ObjectID *bridgeID);
 
 	void newMap();
@@ -787,6 +1106,19 @@ protected:
 	Path *findHierarchicalPath( Bool isHuman, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to, Bool crusher);
 	Path *findClosestHierarchicalPath( Bool isHuman, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to, Bool crusher);
 	Path *internal_findHierarchicalPath( Bool isHuman, const LocomotorSurfaceTypeMask locomotorSurface, const Coord3D *from, const Coord3D *to, Bool crusher, Bool closestOK);
+	Path *internal_findPortalPath( Bool isHuman, const LocomotorSurfaceTypeMask locomotorSurface, const Coord3D *from,
+		PathfindCell *startCell, PathfindCell *goalCell, Bool crusher, Bool closestOK);
+	PathfindPortalGraph &getPortalGraph( LocomotorSurfaceTypeMask locomotorSurface, Bool crusher );
+	Int addPortalNode( const ICoord2D &cell, zoneStorageType zone, Int costSoFar, const ICoord2D &goal, Int parent );
+	void pushPortalNode( Int node );
+	Int popPortalNode();
+	Bool getPathCacheKey( const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to,
+		PathfindPathCache::Key &key );
+	Path *findCachedPath( Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to );
+	void addCachedPath( const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to, Path *path );
+	UnsignedInt getFlowFieldStepCost( Int fromX, Int fromY, Int toX, Int toY );
+	void computeFlowField( LocomotorSurfaceTypeMask surfaces, Bool crusher, Bool isHuman );
+	Path *findFlowFieldPath( Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to );
 	void processHierarchicalCell( const ICoord2D &scanCell, const ICoord2D &deltaPathfindCell,
 																PathfindCell *parentCell,
 																PathfindCell *goalCell, zoneStorageType parentZone,
@@ -805,6 +1137,7 @@ protected:
 	void adjustCoordToCell(Int cellX, Int cellY, Bool centerInCell, Coord3D &pos, PathfindLayerEnum layer);
 	Bool checkDestination(const Object *obj, Int cellX, Int cellY, PathfindLayerEnum layer, Int iRadius, Bool centerInCell);
 	Bool checkForMovement(const Object *obj, TCheckMovementInfo &info);
+	void updateGroundCellFlags(const PathfindCell *cell);	///< Copy the unit flags of a ground cell into m_groundCellFlags
 	Bool segmentIntersectsTallBuilding(const PathNode *curNode, PathNode *nextNode,
 		ObjectID ignoreBuilding, Coord3D *insertPos1, Coord3D *insertPos2, Coord3D *insertPos3);	///< Return true if the straight line between the given points intersects a tall building.
 	Bool circleClipsTallBuilding(const Coord3D *from, const Coord3D *to, Real radius, ObjectID ignoreBuilding, Coord3D *adjustTo);	///< Return true if the circle at the end of the line between the given points intersects a tall building.
@@ -885,6 +1218,9 @@ private:
 	/// This uses WAY too much memory.  Should at least be array of pointers to cells w/ many fewer cells
 	PathfindCell *m_blockOfMapCells;		///< Pathfinding map - contains iconic representation of the map
 	PathfindCell **m_map;		///< Pathfinding map indexes - contains matrix indexing into the map.
+	// TheSuperHackers @performance The unit flags of the ground cells, laid out like m_blockOfMapCells.
+	// checkForMovement scans these instead of the cells, so that the cells without units cost a byte each.
+	UnsignedByte *m_groundCellFlags;
 	IRegion2D m_extent;														///< Grid extent limits
 	IRegion2D m_logicalExtent;										///< Logical grid extent limits
 
@@ -903,6 +1239,18 @@ private:
 
 	PathfindZoneManager m_zoneManager;						///< Handles the pathfind zones.
 
+	// TheSuperHackers @feature Portal graphs for the most recent combinations of surfaces and crusher flag,
+	// and the nodes of the portal search, see PATHFIND_OPTION_PORTALS.
+	enum {MAX_PORTAL_GRAPHS = 4};
+	PathfindPortalGraph m_portalGraphs[MAX_PORTAL_GRAPHS];
+	UnsignedInt m_portalGraphUseCount;
+	std::vector<PathfindPortalNode> m_portalNodes;
+	std::vector<Int> m_portalOpenList;	///< Binary heap of indices into m_portalNodes.
+
+	PathfindPathCache m_pathCache;								///< Recent ground paths, see PATHFIND_OPTION_PATH_CACHE.
+	PathfindFlowField m_flowField;								///< Costs to the goal of a group move, see PATHFIND_OPTION_GROUP_FLOW_FIELD.
+	PathfindLineOfSightCache m_lineOfSightCache;				///< Recent results of isAttackViewBlockedByObstacle.
+
 	PathfindLayer m_layers[LAYER_LAST+1];
 
 	ObjectID			m_wallPieces[MAX_WALL_PIECES];
@@ -1003,6 +1351,15 @@ inline PathfindCell *Pathfinder::getCell( PathfindLayerEnum layer, const Coord3D
 	return getCell( layer, cell.x, cell.y );
 }
 
+inline void Pathfinder::updateGroundCellFlags( const PathfindCell *cell )
+{
+	const PathfindCell *end = m_blockOfMapCells + (m_extent.hi.x+1)*(m_extent.hi.y+1);
+	if (cell >= m_blockOfMapCells && cell < end)
+	{
+		m_groundCellFlags[cell - m_blockOfMapCells] = (UnsignedByte)cell->getFlags();
+	}
+}
+
 inline PathfindCell *Pathfinder::getClippedCell( PathfindLayerEnum layer, const Coord3D *pos)
 {
 	ICoord2D cell;
@@ -0,0 +1,73 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: PathfindBenchmark.h //////////////////////////////////////////////////////////////////////
+// Runs a seeded workload of path queries on a map and reports the cost of the pathfinder
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "GameLogic/AIPathfind.h"
+
+class Object;
+
+// TheSuperHackers @feature Starts a game on a map, classifies it again and runs a seeded workload of
+// ground, hierarchical, attack and safe path queries with one benchmark unit. Prints the classification
+// time and, per kind of query, the paths found, the cells examined, the paths per second and the average
+// path length. The same map, seed and query count always give the same queries, so the output of two
+// builds can be compared directly. With -incrementalZones it also checks that the zones after seeded
+// repairs are the same as the zones of a calculation of the whole map.
+class PathfindBenchmark
+{
+public:
+
+	enum QueryType CPP_11(: Int)
+	{
+		QUERY_PATH,
+		QUERY_HIERARCHICAL,
+		QUERY_ATTACK,
+		QUERY_SAFE,
+
+		QUERY_TYPE_COUNT
+	};
+
+	// Returns exit code 1 if the map cannot be loaded, no benchmark unit can be created or the repaired
+	// zones differ from the calculated ones, 0 otherwise.
+	static int run(const AsciiString &mapName, Int queryCount, UnsignedInt seed);
+
+private:
+
+	struct QueryResult
+	{
+		Int queries;
+		Int found;
+		Int64 cells;
+		Int64 ticks;
+		Real length;
+	};
+
+	static Bool startGame(const AsciiString &mapName);
+	static Object *createUnit();
+	static Bool pickPosition(Pathfinder *pathfinder, const Object *obj, UnsignedInt &random, Coord3D &pos);
+	static Real getPathLength(Path *path);
+	static void collectZones(Pathfinder *pathfinder, std::vector<zoneStorageType> &zones);
+	static Int checkZoneRepair(Pathfinder *pathfinder, UnsignedInt &random);
+	static Int compareWithCalculatedZones(Pathfinder *pathfinder);
+	static Int64 getTicks();
+	static Real ticksToMs(Int64 ticks);
+};
@@ -43,6 +43,19 @@ enum SlotState CPP_11(: Int)
 	SLOT_PLAYER
 };
 
+// TheSuperHackers @fix The optional pathfinding methods change the paths that units take and therefore the
+// simulation. So they are game options: the host sends them to all players, the replay records them, and the
+// game logic uses the ones of the game instead of the local command line.
+enum PathfindOption CPP_11(: UnsignedInt)
+{
+	PATHFIND_OPTION_PORTALS = 0x01,						///< -portalPathfinding
+	PATHFIND_OPTION_PATH_CACHE = 0x02,				///< -pathCache
+	PATHFIND_OPTION_INCREMENTAL_ZONES = 0x04,	///< -incrementalZones
+	PATHFIND_OPTION_GROUP_FLOW_FIELD = 0x08,	///< -groupFlowField
+
+	PATHFIND_OPTION_ALL = 0x0f
+};
+
 enum
 {
 	PLAYERTEMPLATE_RANDOM = -1,
@@ -200,6 +213,8 @@ public:
   void setSuperweaponRestriction( UnsignedShort restriction ); ///< Set the optional limits on superweapons
   inline const Money & getStartingCash() const;
   void setStartingCash( const Money & startingCash );
+	inline UnsignedInt getPathfindOptions() const;		///< Get the PathfindOption flags of the game
+	inline void setPathfindOptions( UnsignedInt options );
 
 	void setSlotPointer( Int index, GameSlot *slot );	///< Set the slot info pointer
 
@@ -253,6 +268,7 @@ protected:
   Money         m_startingCash;
   UnsignedShort m_superweaponRestriction;
   Bool m_oldFactionsOnly; // Only USA, China, GLA -- not USA Air Force General, GLA Toxic General, et al
+	UnsignedInt m_pathfindOptions;
 };
 
 extern GameInfo *TheGameInfo;
@@ -274,8 +290,11 @@ const Money&GameInfo::getStartingCash() const         { return m_startingCash; }
 UnsignedShort GameInfo::getSuperweaponRestriction() const { return m_superweaponRestriction; }
 Bool        GameInfo::oldFactionsOnly() const           { return m_oldFactionsOnly; }
 void        GameInfo::setOldFactionsOnly( Bool oldFactionsOnly ) { m_oldFactionsOnly = oldFactionsOnly; }
+UnsignedInt	GameInfo::getPathfindOptions() const			{ return m_pathfindOptions; }
+void				GameInfo::setPathfindOptions( UnsignedInt options )	{ m_pathfindOptions = options; }
 
 AsciiString GameInfoToAsciiString( const GameInfo *game );
+UnsignedInt GetCommandLinePathfindOptions();	///< The PathfindOption flags that the local command line asks for
 Bool ParseAsciiStringToGameInfo( GameInfo *game, AsciiString options );
 
 
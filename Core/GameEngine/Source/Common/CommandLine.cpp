@@ -463,6 +463,172 @@ Int parseJobs(char *args[], int num)
 	return 1;
 }
 
+Int parseReplayBenchmark(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_replayBenchmarkFile = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplaySnapshotInterval(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_replaySnapshotInterval = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplaySnapshotMemory(char *args[], int num)
+{
+	if (num > 1)
+	{
+		const Int megabytes = atoi(args[1]);
+		if (megabytes < 0)
+		{
+			printf("Invalid replay snapshot memory: %d MB\n", megabytes);
+			exit(1);
+		}
+		TheWritableGlobalData->m_replaySnapshotMemoryMB = (UnsignedInt)megabytes;
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplayBisect(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_replayBisectDirectory = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplaySeekCheck(char *args[], int num)
+{
+	TheWritableGlobalData->m_replaySeekCheck = TRUE;
+	return 1;
+}
+
+Int parseMemoryPoolProfile(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_memoryPoolProfileFile = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseWorkerThreads(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_workerThreadCount = atoi(args[1]);
+		if (TheGlobalData->m_workerThreadCount < 0)
+		{
+			printf("Invalid number of worker threads: %d\n", TheGlobalData->m_workerThreadCount);
+			exit(1);
+		}
+		return 2;
+	}
+	return 1;
+}
+
+Int parsePortalPathfinding(char *args[], int)
+{
+	TheWritableGlobalData->m_usePortalPathfinding = TRUE;
+	return 1;
+}
+
+Int parsePathCache(char *args[], int)
+{
+	TheWritableGlobalData->m_usePathCache = TRUE;
+	return 1;
+}
+
+Int parseIncrementalZones(char *args[], int)
+{
+	TheWritableGlobalData->m_useIncrementalZones = TRUE;
+	return 1;
+}
+
+Int parseGroupFlowField(char *args[], int)
+{
+	TheWritableGlobalData->m_useGroupFlowField = TRUE;
+	return 1;
+}
+
+Int parseINICache(char *args[], int)
+{
+	TheWritableGlobalData->m_useINICache = TRUE;
+	return 1;
+}
+
+Int parsePathfindBenchmark(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_pathfindBenchmarkMap = args[1];
+		ConvertShortMapPathToLongMapPath(TheWritableGlobalData->m_pathfindBenchmarkMap);
+
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+		return 2;
+	}
+	return 1;
+}
+
+Int parsePathfindBenchmarkQueries(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_pathfindBenchmarkQueries = atoi(args[1]);
+		if (TheGlobalData->m_pathfindBenchmarkQueries <= 0)
+		{
+			printf("Invalid number of pathfind benchmark queries: %d\n", TheGlobalData->m_pathfindBenchmarkQueries);
+			exit(1);
+		}
+		return 2;
+	}
+	return 1;
+}
+
+Int parsePathfindBenchmarkSeed(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_pathfindBenchmarkSeed = (UnsignedInt)atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseINIBenchmark(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_iniBenchmarkRepeats = atoi(args[1]);
+		if (TheGlobalData->m_iniBenchmarkRepeats <= 0)
+		{
+			printf("Invalid number of INI benchmark repeats: %d\n", TheGlobalData->m_iniBenchmarkRepeats);
+			exit(1);
+		}
+
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+		return 2;
+	}
+	return 1;
+}
+
 Int parseXRes(char *args[], int num)
 {
 	if (num > 1)
@@ -1141,6 +1307,81 @@ static CommandLineParam paramsForStartup[] =
 	// (If you have 4 cores, call it with -jobs 4)
 	// If you do not call this, all replays will be simulated in sequence in the same process.
 	{ "-jobs", parseJobs },
+
+	// TheSuperHackers @feature Measure the wall time of every logic frame while simulating replays with -headless.
+	// Pass the filename of the CSV summary afterwards. It contains the frame time percentiles and the time
+	// spent in each section of the logic update per replay. Replays are always simulated in this process.
+	{ "-replayBenchmark", parseReplayBenchmark },
+
+	// TheSuperHackers @feature Keep compressed in-memory snapshots of the game state every N logic frames
+	// while playing back replays, so that seeking within the replay only needs to simulate at most N frames.
+	// When watching a replay, the Jump Back command returns to these snapshots.
+	// The memory is limited with -replaySnapshotMemory in megabytes (default 256).
+	{ "-replaySnapshotInterval", parseReplaySnapshotInterval },
+	{ "-replaySnapshotMemory", parseReplaySnapshotMemory },
+
+	// TheSuperHackers @feature When a simulated replay mismatches, simulate it again from the last matching CRC
+	// and write deep CRC dumps of the last matching and the first mismatching CRC frame into the given directory.
+	// The dumps can be compared per object with 'crcdiff -deep'.
+	{ "-replayBisect", parseReplayBisect },
+
+	// TheSuperHackers @feature Check that the snapshots hold all of the game state while simulating replays with
+	// -headless. Every snapshot interval is simulated again from the previous snapshot, and the CRC at its end
+	// must match the one of the first simulation, as must the CRCs recorded in the replay.
+	// Pathfinding switches like -pathCache are added to the options of the replays. The recorded CRCs are
+	// not compared then, because they only apply to the recorded options.
+	{ "-replaySeekCheck", parseReplaySeekCheck },
+
+	// TheSuperHackers @feature Write the peak block count of every memory pool plus some headroom to the given
+	// file at the end of every match or replay. Sizes already in the file only ever grow, so several matches can
+	// be profiled into one file. Pass a name ending with .inl to write entries for GameMemoryInit*.inl instead
+	// of the Data\INI\MemoryPools.ini format. Replays are always simulated in this process.
+	{ "-memoryPoolProfile", parseMemoryPoolProfile },
+
+	// TheSuperHackers @performance Set the number of worker threads for the parallel parts of the logic update.
+	// The results do not depend on the number of threads. Pass 0 to run everything on the logic thread.
+	// By default one thread less than the number of processors is used.
+	{ "-workerThreads", parseWorkerThreads },
+
+	// TheSuperHackers @feature Find the coarse paths of long moves on a graph of the portals between the pathfind
+	// zone blocks, instead of scanning the borders of every block that the search reaches. The paths differ from
+	// the default ones, so the host's setting is used by all players and is recorded in the replay.
+	{ "-portalPathfinding", parsePortalPathfinding },
+
+	// TheSuperHackers @feature Let units that move between the same pathfind zone blocks as a recent path follow
+	// that path instead of searching a new one. The paths differ from the default ones, so the host's setting is
+	// used by all players and is recorded in the replay.
+	{ "-pathCache", parsePathCache },
+
+	// TheSuperHackers @feature Repair the pathfind zones around structures that are built or removed right away,
+	// instead of recalculating the zones of the whole map some frames later. The paths differ from the default
+	// ones, so the host's setting is used by all players and is recorded in the replay.
+	{ "-incrementalZones", parseIncrementalZones },
+
+	// TheSuperHackers @feature Let the members of large group moves follow a single flow field to the goal
+	// instead of searching a path each. The paths differ from the default ones, so the host's setting is used
+	// by all players and is recorded in the replay.
+	{ "-groupFlowField", parseGroupFlowField },
+
+	// TheSuperHackers @feature Start a game on the given map, run a seeded workload of ground, hierarchical,
+	// attack and safe path queries on it and print the cells examined, the paths per second and the path lengths.
+	// Combine this with -headless. Set the number of queries with -pathfindBenchmarkQueries (default 1000) and
+	// the seed of their positions with -pathfindBenchmarkSeed (default 0). The same map, count and seed always
+	// run the same queries, so the output of two builds can be compared directly.
+	{ "-pathfindBenchmark", parsePathfindBenchmark },
+	{ "-pathfindBenchmarkQueries", parsePathfindBenchmarkQueries },
+	{ "-pathfindBenchmarkSeed", parsePathfindBenchmarkSeed },
+
+	// TheSuperHackers @performance Keep the lines of the INI files in INICache.dat in the user data directory, and
+	// read the lines of unchanged INI files from there instead of scanning the files again. The parsed data and the
+	// INI CRC are the same either way.
+	{ "-iniCache", parseINICache },
+
+	// TheSuperHackers @feature Time the INI files that are loaded at startup and record the field of each line
+	// with the parse tables of its block. Then replay the field lookups the given number of times with the linear
+	// scan of the tables and with their token indexes, print the load time and the time per lookup and exit.
+	// Combine this with -headless.
+	{ "-iniBenchmark", parseINIBenchmark },
 };
 
 // These Params are parsed during Engine Init before INI data is loaded
@@ -1450,3 +1691,40 @@ void CommandLine::parseCommandLineForEngineInit()
 
 	parseCommandLine(paramsForEngineInit, ARRAY_SIZE(paramsForEngineInit));
 }
+
+AsciiString CommandLine::getArgumentsForReplayWorker()
+{
+	AsciiString arguments;
+
+	std::string cmdLine = GetCommandLineA();
+	char *token = nextParam(&cmdLine[0], "\" ");
+	// Skip the executable
+	if (token != nullptr)
+		token = nextParam(nullptr, "\" ");
+	while (token != nullptr)
+	{
+		const char *arg = strtrim(token);
+		token = nextParam(nullptr, "\" ");
+
+		// The parent hands out the replays, one per worker.
+		if (stricmp(arg, "-replay") == 0 || stricmp(arg, "-jobs") == 0)
+		{
+			if (token != nullptr)
+				token = nextParam(nullptr, "\" ");
+			continue;
+		}
+
+		arguments.concat(' ');
+		if (*arg == 0 || strchr(arg, ' ') != nullptr)
+		{
+			arguments.concat('"');
+			arguments.concat(arg);
+			arguments.concat('"');
+		}
+		else
+		{
+			arguments.concat(arg);
+		}
+	}
+	return arguments;
+}
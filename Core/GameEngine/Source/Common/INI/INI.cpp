@@ -32,7 +32,10 @@
 #define DEFINE_DEATH_NAMES
 
 #include "Common/INI.h"
+#include "Common/INIBenchmark.h"
+#include "Common/INICache.h"
 #include "Common/INIException.h"
+#include "Common/INIFieldParseIndex.h"
 
 #include "Common/DamageFX.h"
 #include "Common/file.h"
@@ -182,6 +185,10 @@ INI::INI()
 	m_lineNum						= 0;
 	m_buffer[0]					= 0;
 	m_endOfFile					= FALSE;
+	m_cachedLines				= nullptr;
+	m_cachedLinesLeft		= 0;
+	m_recordLines				= FALSE;
+	m_recordedLineCount	= 0;
 #ifdef DEBUG_CRASHING
 	m_curBlockStart[0]	= 0;
 #endif
@@ -276,7 +283,7 @@ UnsignedInt INI::loadDirectory( AsciiString dirName, INILoadType loadType, Xfer
 void INI::prepFile( AsciiString filename, INILoadType loadType )
 {
 	// if we have a file open already -- we can't do another one
-	if( m_readBuffer != nullptr )
+	if( m_readBuffer != nullptr || m_cachedLines != nullptr )
 	{
 
 		DEBUG_CRASH(( "INI::load, cannot open file '%s', file already open", filename.str() ));
@@ -284,19 +291,38 @@ void INI::prepFile( AsciiString filename, INILoadType loadType )
 
 	}
 
-	// open the file
-	File* file = TheFileSystem->openFile(filename.str(), File::READ);
-	if( file == nullptr )
+	// TheSuperHackers @performance Hand out the lines from the INI cache if it has them for this version of
+	// the file, which is known from the file systems without reading the file, or else record the lines for it.
+	const Bool useCache = TheINICache != nullptr && INICache::getSourceStamp(filename, &m_source);
+	const INICache::Entry *entry = useCache ? TheINICache->find(filename, m_source) : nullptr;
+	if (entry != nullptr)
 	{
+		m_cachedLines = &entry->m_lines[0];
+		m_cachedLinesLeft = entry->m_lineCount;
+	}
+	else
+	{
+		// open the file
+		File* file = TheFileSystem->openFile(filename.str(), File::READ);
+		if( file == nullptr )
+		{
 
-		DEBUG_CRASH(( "INI::load, cannot open file '%s'", filename.str() ));
-		throw INI_CANT_OPEN_FILE;
+			DEBUG_CRASH(( "INI::load, cannot open file '%s'", filename.str() ));
+			throw INI_CANT_OPEN_FILE;
 
-	}
+		}
 
-	m_readBufferNext = 0;
-	m_readBufferUsed = file->size();
-	m_readBuffer = file->readEntireAndClose();
+		m_readBufferNext = 0;
+		m_readBufferUsed = file->size();
+		m_readBuffer = file->readEntireAndClose();
+
+		if (useCache)
+		{
+			m_recordLines = TRUE;
+			m_recordedLines.clear();
+			m_recordedLineCount = 0;
+		}
+	}
 
 	// save our filename
 	m_filename = filename;
@@ -319,47 +345,29 @@ void INI::unPrepFile()
 	m_loadType = INI_LOAD_INVALID;
 	m_lineNum = 0;
 	m_endOfFile = FALSE;
+	m_cachedLines = nullptr;
+	m_cachedLinesLeft = 0;
+	m_recordLines = FALSE;
+	m_recordedLines.clear();
+	m_recordedLineCount = 0;
 	s_xfer = nullptr;
 }
 
 //-------------------------------------------------------------------------------------------------
+// TheSuperHackers @performance Looks the block token up in a token index of theTypeTable, which is built on
+// first use, instead of comparing it with every token of the table.
 static INIBlockParse findBlockParse(const char* token)
 {
-	for (size_t i = 0; i < ARRAY_SIZE(theTypeTable); ++i)
+	static INITokenIndex<BlockParse> blockParseIndex;
+	static Bool blockParseIndexBuilt = FALSE;
+	if (!blockParseIndexBuilt)
 	{
-		if (strcmp(theTypeTable[i].token, token) == 0)
-		{
-			return theTypeTable[i].parse;
-		}
-	}
-
-	return nullptr;
-}
-
-//-------------------------------------------------------------------------------------------------
-static INIFieldParseProc findFieldParse(const FieldParse* parseTable, const char* token, int& offset, const void*& userData)
-{
-	const FieldParse* parse = parseTable;
-	for (; parse->token; ++parse)
-	{
-		if (strcmp( parse->token, token ) == 0)
-		{
-			offset = parse->offset;
-			userData = parse->userData;
-			return parse->parse;
-		}
+		blockParseIndex.build(theTypeTable, (Int)ARRAY_SIZE(theTypeTable));
+		blockParseIndexBuilt = TRUE;
 	}
 
-	if (!parse->token && parse->parse)
-	{
-		offset = parse->offset;
-		userData = token;
-		return parse->parse;
-	}
-	else
-	{
-		return nullptr;
-	}
+	const BlockParse* parse = blockParseIndex.find(token, INITokenIndex<BlockParse>::hashToken(token));
+	return parse != nullptr ? parse->parse : nullptr;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -369,6 +377,8 @@ UnsignedInt INI::load( AsciiString filename, INILoadType loadType, Xfer *pXfer )
 {
 	setFPMode(); // so we have consistent Real values for GameLogic -MDC
 
+	const Int64 benchmarkStart = INIBenchmark::isRecording() ? INIBenchmark::getTicks() : 0;
+
 	s_xfer = pXfer;
 	prepFile(filename, loadType);
 
@@ -429,6 +439,16 @@ UnsignedInt INI::load( AsciiString filename, INILoadType loadType, Xfer *pXfer )
 		throw;
 	}
 
+	if (m_recordLines && TheINICache != nullptr)
+	{
+		TheINICache->store(m_filename, m_source, m_recordedLineCount, m_recordedLines);
+	}
+
+	if (benchmarkStart != 0)
+	{
+		INIBenchmark::recordLoad(INIBenchmark::getTicks() - benchmarkStart, m_lineNum);
+	}
+
 	unPrepFile();
 
 	return 1;
@@ -445,12 +465,28 @@ UnsignedInt INI::load( AsciiString filename, INILoadType loadType, Xfer *pXfer )
 void INI::readLine()
 {
 	// sanity
-	DEBUG_ASSERTCRASH( m_readBuffer, ("readLine(), read buffer is null") );
+	DEBUG_ASSERTCRASH( m_readBuffer || m_cachedLines, ("readLine(), read buffer is null") );
 
 	if (m_endOfFile)
 	{
 		*m_buffer = 0;
 	}
+	else if (m_cachedLines != nullptr)
+	{
+		// TheSuperHackers @performance This is the line that the code below made of the unchanged file before.
+		UnsignedShort length;
+		memcpy(&length, m_cachedLines, sizeof(length));
+		memcpy(m_buffer, m_cachedLines + sizeof(length), length);
+		m_buffer[length] = 0;
+		m_cachedLines += sizeof(length) + length;
+
+		m_lineNum++;
+
+		if (--m_cachedLinesLeft == 0)
+		{
+			m_endOfFile = true;
+		}
+	}
 	else
 	{
 		// read up till the newline or semicolon character, or until out of space
@@ -502,6 +538,17 @@ void INI::readLine()
 		{
 			DEBUG_CRASH( ("Buffer too small (%d) and was truncated, increase INI_MAX_CHARS_PER_LINE", INI_MAX_CHARS_PER_LINE) );
 		}
+
+		if (m_recordLines)
+		{
+			// Only the text up to the first comment is ever parsed, so that is all the INI cache needs.
+			const UnsignedShort length = (UnsignedShort)strlen(m_buffer);
+			const size_t pos = m_recordedLines.size();
+			m_recordedLines.resize(pos + sizeof(length) + length);
+			memcpy(&m_recordedLines[pos], &length, sizeof(length));
+			memcpy(&m_recordedLines[pos + sizeof(length)], m_buffer, length);
+			++m_recordedLineCount;
+		}
 	}
 
 	if (s_xfer)
@@ -1467,6 +1514,7 @@ void MultiIniFieldParse::add(const FieldParse* f, UnsignedInt e)
 	if (m_count < MAX_MULTI_FIELDS)
 	{
 		m_fieldParse[m_count] = f;
+		m_fieldParseIndex[m_count] = INIFieldParseIndex::get(f);
 		m_extraOffset[m_count] = e;
 		++m_count;
 	}
@@ -1504,6 +1552,8 @@ void INI::initFromINIMulti( void *what, const MultiIniFieldParse& parseTableList
 		throw INI_INVALID_PARAMS;
 	}
 
+	const Bool recordLookups = INIBenchmark::isRecording();
+
 	// read each of the data fields
 	while( !done )
 	{
@@ -1522,18 +1572,27 @@ void INI::initFromINIMulti( void *what, const MultiIniFieldParse& parseTableList
 			}
 			else
 			{
+				if (recordLookups)
+				{
+					INIBenchmark::recordFieldLookup(parseTableList, field);
+				}
+
+				// TheSuperHackers @performance Hash the field once and look it up in the token index of each
+				// table, instead of comparing it with every token of every table.
+				const UnsignedInt fieldHash = INIFieldParseIndex::hashToken(field);
 				Bool found = false;
 				for (int ptIdx = 0; ptIdx < parseTableList.getCount(); ++ptIdx)
 				{
-					int offset = 0;
-					const void* userData = nullptr;
-					INIFieldParseProc parse = findFieldParse(parseTableList.getNthFieldParse(ptIdx), field, offset, userData);
-					if (parse)
+					const FieldParse* fieldParse = parseTableList.getNthFieldParseIndex(ptIdx)->find(field, fieldHash);
+					if (fieldParse && fieldParse->parse)
 					{
+						// the terminator of a table parses all other tokens and gets the token as user data
+						const void* userData = fieldParse->token ? fieldParse->userData : field;
+
 						// parse this block and check for parse errors
 						try {
 
-						(*parse)( this, what, (char *)what + offset + parseTableList.getNthExtraOffset(ptIdx), userData );
+						(*fieldParse->parse)( this, what, (char *)what + fieldParse->offset + parseTableList.getNthExtraOffset(ptIdx), userData );
 
 						} catch (...) {
 							DEBUG_CRASH( ("[LINE: %d - FILE: '%s'] Error reading field '%s' of block '%s'",
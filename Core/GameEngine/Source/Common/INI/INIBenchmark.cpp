@@ -0,0 +1,183 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: INIBenchmark.cpp /////////////////////////////////////////////////////////////////////////
+// Measures the parse time and the field lookups of the INI files loaded at startup
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/INIBenchmark.h"
+
+#include "Common/GlobalData.h"
+#include "Common/INI.h"
+#include "Common/INIFieldParseIndex.h"
+
+namespace
+{
+struct FieldLookup
+{
+	Int firstTable;
+	Int tableCount;
+	Int token;
+};
+
+std::vector<FieldLookup> s_fieldLookups;
+std::vector<const FieldParse *> s_tables;	///< the parse tables of the lookups, shared by the lookups of a block
+std::vector<const INIFieldParseIndex *> s_tableIndexes;
+std::vector<char> s_tokens;
+Int s_fileCount = 0;
+Int s_lineCount = 0;
+Int64 s_loadTicks = 0;
+
+const FieldParse *findLinear(const FieldLookup &lookup)
+{
+	const char *token = &s_tokens[lookup.token];
+	for (Int i = 0; i < lookup.tableCount; ++i)
+	{
+		const FieldParse *parse = INIFieldParseIndex::findLinear(s_tables[lookup.firstTable + i], token);
+		if (parse != nullptr && parse->parse != nullptr)
+			return parse;
+	}
+	return nullptr;
+}
+
+const FieldParse *findIndexed(const FieldLookup &lookup)
+{
+	const char *token = &s_tokens[lookup.token];
+	const UnsignedInt hash = INIFieldParseIndex::hashToken(token);
+	for (Int i = 0; i < lookup.tableCount; ++i)
+	{
+		const FieldParse *parse = s_tableIndexes[lookup.firstTable + i]->find(token, hash);
+		if (parse != nullptr && parse->parse != nullptr)
+			return parse;
+	}
+	return nullptr;
+}
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+Int64 INIBenchmark::getTicks()
+{
+	LARGE_INTEGER tick;
+	QueryPerformanceCounter(&tick);
+	return tick.QuadPart;
+}
+
+//-------------------------------------------------------------------------------------------------
+Real INIBenchmark::ticksToMs(Int64 ticks)
+{
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+	return (Real)((double)ticks * 1000.0 / (double)freq.QuadPart);
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool INIBenchmark::isRecording()
+{
+	return TheGlobalData != nullptr && TheGlobalData->m_iniBenchmarkRepeats > 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+void INIBenchmark::recordLoad(Int64 ticks, Int lineCount)
+{
+	++s_fileCount;
+	s_lineCount += lineCount;
+	s_loadTicks += ticks;
+}
+
+//-------------------------------------------------------------------------------------------------
+void INIBenchmark::recordFieldLookup(const MultiIniFieldParse &parseTableList, const char *field)
+{
+	// The lines of a block share the parse tables of the previous lookup.
+	const Int tableCount = parseTableList.getCount();
+	Bool sameTables = !s_fieldLookups.empty() && s_fieldLookups.back().tableCount == tableCount;
+	for (Int i = 0; sameTables && i < tableCount; ++i)
+		sameTables = s_tables[s_fieldLookups.back().firstTable + i] == parseTableList.getNthFieldParse(i);
+
+	FieldLookup lookup;
+	lookup.firstTable = sameTables ? s_fieldLookups.back().firstTable : (Int)s_tables.size();
+	lookup.tableCount = tableCount;
+	lookup.token = (Int)s_tokens.size();
+
+	if (!sameTables)
+	{
+		for (Int i = 0; i < tableCount; ++i)
+		{
+			s_tables.push_back(parseTableList.getNthFieldParse(i));
+			s_tableIndexes.push_back(parseTableList.getNthFieldParseIndex(i));
+		}
+	}
+
+	s_tokens.insert(s_tokens.end(), field, field + strlen(field) + 1);
+	s_fieldLookups.push_back(lookup);
+}
+
+//-------------------------------------------------------------------------------------------------
+int INIBenchmark::run(Int repeats)
+{
+	const Int lookupCount = (Int)s_fieldLookups.size();
+
+	// Note that we use printf here because this is run from cmd.
+	printf("INI benchmark, %d repeats\n", repeats);
+	printf("Loaded %d INI files with %d lines in %.2f ms\n", s_fileCount, s_lineCount, ticksToMs(s_loadTicks));
+
+	Int64 tableCount = 0;
+	Int mismatches = 0;
+	for (Int i = 0; i < lookupCount; ++i)
+	{
+		tableCount += s_fieldLookups[i].tableCount;
+		if (findLinear(s_fieldLookups[i]) != findIndexed(s_fieldLookups[i]))
+			++mismatches;
+	}
+	printf("Field lookups: %d, %.1f parse tables per lookup\n", lookupCount,
+		lookupCount > 0 ? (double)tableCount / (double)lookupCount : 0.0);
+
+	UnsignedInt linearFound = 0;
+	const Int64 linearStart = getTicks();
+	for (Int r = 0; r < repeats; ++r)
+	{
+		for (Int i = 0; i < lookupCount; ++i)
+			linearFound += findLinear(s_fieldLookups[i]) != nullptr ? 1 : 0;
+	}
+	const Int64 linearTicks = getTicks() - linearStart;
+
+	UnsignedInt indexedFound = 0;
+	const Int64 indexedStart = getTicks();
+	for (Int r = 0; r < repeats; ++r)
+	{
+		for (Int i = 0; i < lookupCount; ++i)
+			indexedFound += findIndexed(s_fieldLookups[i]) != nullptr ? 1 : 0;
+	}
+	const Int64 indexedTicks = getTicks() - indexedStart;
+
+	const double lookups = (double)lookupCount * (double)repeats;
+	const Real linearMs = ticksToMs(linearTicks);
+	const Real indexedMs = ticksToMs(indexedTicks);
+	printf("%-12s %10.2f ms per pass %10.1f ns per lookup\n", "linear scan", linearMs / repeats,
+		lookups > 0.0 ? linearMs * 1000000.0 / lookups : 0.0);
+	printf("%-12s %10.2f ms per pass %10.1f ns per lookup\n", "token index", indexedMs / repeats,
+		lookups > 0.0 ? indexedMs * 1000000.0 / lookups : 0.0);
+
+	if (mismatches > 0 || linearFound != indexedFound)
+	{
+		printf("The linear scan and the token indexes found different entries for %d lookups\n", mismatches);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,268 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: INICache.cpp /////////////////////////////////////////////////////////////////////////////
+// Binary cache of the lines that INI::readLine makes of each INI file
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/INICache.h"
+
+#include "Common/ArchiveFile.h"
+#include "Common/ArchiveFileSystem.h"
+#include "Common/file.h"
+#include "Common/FileSystem.h"
+#include "Common/INI.h"
+#include "Common/LocalFileSystem.h"
+
+INICache *TheINICache = nullptr;
+
+namespace
+{
+const char CacheFileIdentifier[4] = { 'I', 'N', 'I', 'C' };
+
+// Increase this when the format of the cache file or the way readLine makes the lines changes.
+const UnsignedInt CacheFileVersion = 2;
+
+// Reads the cache file from memory and fails at the first value that runs past its end.
+class CacheReader
+{
+public:
+	CacheReader(const char *data, Int size) : m_data(data), m_size(size), m_pos(0) {}
+
+	Bool read(void *value, Int size)
+	{
+		if (size < 0 || size > m_size - m_pos)
+			return FALSE;
+		memcpy(value, m_data + m_pos, size);
+		m_pos += size;
+		return TRUE;
+	}
+
+	Bool atEnd() const { return m_pos == m_size; }
+
+private:
+	const char *m_data;
+	Int m_size;
+	Int m_pos;
+};
+
+// Makes sure that INI::readLine can hand out the lines without checking them again.
+Bool areValidLines(const INICache::Entry &entry)
+{
+	const size_t size = entry.m_lines.size();
+	size_t pos = 0;
+	for (Int i = 0; i < entry.m_lineCount; ++i)
+	{
+		UnsignedShort length;
+		if (size - pos < sizeof(length))
+			return FALSE;
+		memcpy(&length, &entry.m_lines[pos], sizeof(length));
+		pos += sizeof(length);
+		if (length > INI_MAX_CHARS_PER_LINE || size - pos < length)
+			return FALSE;
+		pos += length;
+	}
+	return pos == size;
+}
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+INICache::INICache()
+	: m_dirty(FALSE)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+AsciiString INICache::makeKey(const AsciiString &sourceName)
+{
+	AsciiString key = sourceName;
+	key.toLower();
+	return key;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool INICache::SourceStamp::operator==(const SourceStamp &other) const
+{
+	return m_size == other.m_size && m_timestamp == other.m_timestamp && m_offset == other.m_offset
+		&& m_archiveName.compareNoCase(other.m_archiveName) == 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool INICache::getSourceStamp(const AsciiString &sourceName, SourceStamp *source)
+{
+	// Look in the same places in the same order as FileSystem::openFile.
+	FileInfo info;
+	memset(&info, 0, sizeof(info));
+	if (TheLocalFileSystem->getFileInfo(sourceName, &info))
+	{
+		source->m_archiveName.clear();
+		source->m_offset = 0;
+	}
+	else
+	{
+		ArchiveFile *archive = TheArchiveFileSystem != nullptr ? TheArchiveFileSystem->getArchiveFile(sourceName) : nullptr;
+		if (archive == nullptr || !archive->getFileInfo(sourceName, &info) || !archive->getFileOffset(sourceName, &source->m_offset))
+			return FALSE;
+		source->m_archiveName = archive->getName();
+	}
+
+	if (info.sizeHigh != 0)
+		return FALSE;
+
+	source->m_size = (UnsignedInt)info.sizeLow;
+	source->m_timestamp = info.timestamp();
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+void INICache::load(const AsciiString &filename)
+{
+	m_filename = filename;
+	m_entries.clear();
+	m_dirty = FALSE;
+
+	File *file = TheLocalFileSystem->openFile(filename.str(), File::READ | File::BINARY);
+	if (file == nullptr)
+		return;
+
+	const Int size = file->size();
+	char *data = file->readEntireAndClose();
+
+	CacheReader reader(data, size);
+	char identifier[4];
+	UnsignedInt version = 0;
+	Int maxCharsPerLine = 0;
+	Int entryCount = 0;
+	Bool valid = reader.read(identifier, sizeof(identifier)) && memcmp(identifier, CacheFileIdentifier, sizeof(identifier)) == 0
+		&& reader.read(&version, sizeof(version)) && version == CacheFileVersion
+		&& reader.read(&maxCharsPerLine, sizeof(maxCharsPerLine)) && maxCharsPerLine == INI_MAX_CHARS_PER_LINE
+		&& reader.read(&entryCount, sizeof(entryCount));
+
+	for (Int i = 0; valid && i < entryCount; ++i)
+	{
+		Int nameLength = 0;
+		char name[_MAX_PATH];
+		valid = reader.read(&nameLength, sizeof(nameLength)) && nameLength >= 0 && nameLength < _MAX_PATH
+			&& reader.read(name, nameLength);
+		if (!valid)
+			break;
+
+		name[nameLength] = 0;
+		Entry &entry = m_entries[AsciiString(name)];
+		Int archiveNameLength = 0;
+		valid = reader.read(&archiveNameLength, sizeof(archiveNameLength)) && archiveNameLength >= 0 && archiveNameLength < _MAX_PATH
+			&& reader.read(name, archiveNameLength);
+		if (!valid)
+			break;
+
+		name[archiveNameLength] = 0;
+		entry.m_source.m_archiveName = name;
+		Int linesSize = 0;
+		valid = reader.read(&entry.m_source.m_offset, sizeof(entry.m_source.m_offset))
+			&& reader.read(&entry.m_source.m_size, sizeof(entry.m_source.m_size))
+			&& reader.read(&entry.m_source.m_timestamp, sizeof(entry.m_source.m_timestamp))
+			&& reader.read(&entry.m_lineCount, sizeof(entry.m_lineCount)) && entry.m_lineCount > 0
+			&& reader.read(&linesSize, sizeof(linesSize)) && linesSize >= 0;
+		if (!valid)
+			break;
+
+		entry.m_lines.resize(linesSize);
+		valid = (linesSize == 0 || reader.read(&entry.m_lines[0], linesSize)) && areValidLines(entry);
+	}
+
+	delete[] data;
+
+	if (!valid || !reader.atEnd())
+	{
+		DEBUG_LOG(("INICache::load - ignoring the invalid cache file %s", filename.str()));
+		m_entries.clear();
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void INICache::save()
+{
+	if (!m_dirty || m_filename.isEmpty())
+		return;
+
+	File *file = TheLocalFileSystem->openFile(m_filename.str(), File::WRITE | File::CREATE | File::BINARY);
+	if (file == nullptr)
+	{
+		DEBUG_LOG(("INICache::save - cannot write the cache file %s", m_filename.str()));
+		return;
+	}
+
+	const Int maxCharsPerLine = INI_MAX_CHARS_PER_LINE;
+	const Int entryCount = (Int)m_entries.size();
+	file->write(CacheFileIdentifier, sizeof(CacheFileIdentifier));
+	file->write(&CacheFileVersion, sizeof(CacheFileVersion));
+	file->write(&maxCharsPerLine, sizeof(maxCharsPerLine));
+	file->write(&entryCount, sizeof(entryCount));
+
+	for (EntryMap::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+	{
+		const Entry &entry = it->second;
+		const Int nameLength = it->first.getLength();
+		const Int archiveNameLength = entry.m_source.m_archiveName.getLength();
+		const Int linesSize = (Int)entry.m_lines.size();
+		file->write(&nameLength, sizeof(nameLength));
+		file->write(it->first.str(), nameLength);
+		file->write(&archiveNameLength, sizeof(archiveNameLength));
+		file->write(entry.m_source.m_archiveName.str(), archiveNameLength);
+		file->write(&entry.m_source.m_offset, sizeof(entry.m_source.m_offset));
+		file->write(&entry.m_source.m_size, sizeof(entry.m_source.m_size));
+		file->write(&entry.m_source.m_timestamp, sizeof(entry.m_source.m_timestamp));
+		file->write(&entry.m_lineCount, sizeof(entry.m_lineCount));
+		file->write(&linesSize, sizeof(linesSize));
+		if (linesSize > 0)
+			file->write(&entry.m_lines[0], linesSize);
+	}
+
+	file->close();
+	m_dirty = FALSE;
+}
+
+//-------------------------------------------------------------------------------------------------
+const INICache::Entry *INICache::find(const AsciiString &sourceName, const SourceStamp &source) const
+{
+	EntryMap::const_iterator it = m_entries.find(makeKey(sourceName));
+	if (it == m_entries.end())
+		return nullptr;
+
+	const Entry &entry = it->second;
+	if (entry.m_source != source)
+		return nullptr;
+
+	return &entry;
+}
+
+//-------------------------------------------------------------------------------------------------
+void INICache::store(const AsciiString &sourceName, const SourceStamp &source, Int lineCount, const std::vector<char> &lines)
+{
+	const AsciiString key = makeKey(sourceName);
+	if (key.getLength() >= _MAX_PATH || source.m_archiveName.getLength() >= _MAX_PATH || lineCount <= 0)
+		return;
+
+	Entry &entry = m_entries[key];
+	entry.m_source = source;
+	entry.m_lineCount = lineCount;
+	entry.m_lines = lines;
+	m_dirty = TRUE;
+}
@@ -0,0 +1,65 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: INIFieldParseIndex.cpp ///////////////////////////////////////////////////////////////////
+// Hashed token lookup in the FieldParse tables of the INI parser
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/INIFieldParseIndex.h"
+
+#include "Common/INI.h"
+
+INIFieldParseIndex::IndexMap INIFieldParseIndex::s_indexes;
+
+//-------------------------------------------------------------------------------------------------
+const INIFieldParseIndex *INIFieldParseIndex::get(const FieldParse *parseTable)
+{
+	IndexMap::iterator it = s_indexes.find(parseTable);
+	if (it != s_indexes.end())
+		return &it->second;
+
+	Int count = 0;
+	while (parseTable[count].token != nullptr)
+		++count;
+
+	INIFieldParseIndex &index = s_indexes[parseTable];
+	index.m_tokens.build(parseTable, count);
+	index.m_anyToken = parseTable[count].parse != nullptr ? &parseTable[count] : nullptr;
+	return &index;
+}
+
+//-------------------------------------------------------------------------------------------------
+const FieldParse *INIFieldParseIndex::find(const char *token, UnsignedInt hash) const
+{
+	const FieldParse *parse = m_tokens.find(token, hash);
+	return parse != nullptr ? parse : m_anyToken;
+}
+
+//-------------------------------------------------------------------------------------------------
+const FieldParse *INIFieldParseIndex::findLinear(const FieldParse *parseTable, const char *token)
+{
+	const FieldParse *parse = parseTable;
+	for (; parse->token; ++parse)
+	{
+		if (strcmp(parse->token, token) == 0)
+			return parse;
+	}
+	return parse->parse != nullptr ? parse : nullptr;
+}
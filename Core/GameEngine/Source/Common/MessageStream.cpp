@@ -357,6 +357,7 @@ const char *GameMessage::getCommandTypeAsString(GameMessage::Type t)
 	CASE_LABEL(MSG_META_TOGGLE_PAUSE_ALT)
 	CASE_LABEL(MSG_META_STEP_FRAME)
 	CASE_LABEL(MSG_META_STEP_FRAME_ALT)
+	CASE_LABEL(MSG_META_REPLAY_JUMP_BACK)
 	CASE_LABEL(MSG_META_DEMO_INSTANT_QUIT)
 
 #if defined(_ALLOW_DEBUG_CHEATS_IN_RELEASE)
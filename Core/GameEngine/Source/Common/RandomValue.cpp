@@ -32,6 +32,8 @@
 #include "Common/RandomValue.h"
 #include "Common/crc.h"
 #include "Common/Debug.h"
+#include "Common/Snapshot.h"
+#include "Common/Xfer.h"
 #include "GameLogic/GameLogic.h"
 
 #undef DEBUG_RANDOM_AUDIO
@@ -76,6 +78,61 @@ UnsignedInt GetGameLogicRandomSeedCRC()
 	return c.get();
 }
 
+// ------------------------------------------------------------------------------------------------
+/** The seeds of the logic random values in the save data. Creating the loaded objects draws random
+	* values, so the loaded seeds are only applied in the post process, after everything else is loaded. */
+// ------------------------------------------------------------------------------------------------
+class GameLogicRandomState : public Snapshot
+{
+protected:
+
+	virtual void crc( Xfer *xfer ) override { }
+	virtual void xfer( Xfer *xfer ) override;
+	virtual void loadPostProcess() override;
+
+private:
+
+	UnsignedInt m_seed[6];
+	UnsignedInt m_baseSeed;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Xfer method
+	* Version Info:
+	* 1: Initial version */
+// ------------------------------------------------------------------------------------------------
+void GameLogicRandomState::xfer( Xfer *xfer )
+{
+
+	// version
+	XferVersion currentVersion = 1;
+	XferVersion version = currentVersion;
+	xfer->xferVersion( &version, currentVersion );
+
+	if( xfer->getXferMode() == XFER_SAVE )
+	{
+		memcpy( m_seed, theGameLogicSeed, sizeof( m_seed ) );
+		m_baseSeed = theGameLogicBaseSeed;
+	}
+
+	for( Int i = 0; i < 6; ++i )
+		xfer->xferUnsignedInt( &m_seed[ i ] );
+	xfer->xferUnsignedInt( &m_baseSeed );
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Load post process */
+// ------------------------------------------------------------------------------------------------
+void GameLogicRandomState::loadPostProcess()
+{
+	memcpy( theGameLogicSeed, m_seed, sizeof( theGameLogicSeed ) );
+	theGameLogicBaseSeed = m_baseSeed;
+}
+
+static GameLogicRandomState theGameLogicRandomState;
+Snapshot *TheGameLogicRandomState = &theGameLogicRandomState;
+
 static void seedRandom(UnsignedInt SEED, UnsignedInt (&seed)[6])
 {
 	UnsignedInt ax;
@@ -0,0 +1,198 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/ReplayBenchmark.h"
+
+#include <algorithm>
+
+
+Bool ReplayBenchmark::s_enabled = false;
+Int64 ReplayBenchmark::s_frequency = 0;
+Int64 ReplayBenchmark::s_frameStartTicks = 0;
+std::vector<ReplayBenchmark::ReplayResult> ReplayBenchmark::s_results;
+
+namespace
+{
+const char *const SectionNames[REPLAY_BENCHMARK_SECTION_COUNT] =
+{
+	"ScriptEngine",
+	"TerrainLogic",
+	"CRC",
+	"SleepyUpdates",
+	"AI",
+	"BuildAssistant",
+	"PartitionManager",
+	"DestroyList",
+};
+
+Int64 getPercentile(const std::vector<Int64> &sortedTicks, Int percent)
+{
+	if (sortedTicks.empty())
+		return 0;
+
+	// Nearest rank method
+	size_t rank = (sortedTicks.size() * percent + 99) / 100;
+	if (rank == 0)
+		rank = 1;
+	return sortedTicks[rank - 1];
+}
+} // namespace
+
+Int64 ReplayBenchmark::getTicks()
+{
+	LARGE_INTEGER tick;
+	QueryPerformanceCounter(&tick);
+	return tick.QuadPart;
+}
+
+Real ReplayBenchmark::ticksToMs(Int64 ticks)
+{
+	if (s_frequency == 0)
+	{
+		LARGE_INTEGER freq;
+		QueryPerformanceFrequency(&freq);
+		s_frequency = freq.QuadPart;
+	}
+	return (Real)((double)ticks * 1000.0 / (double)s_frequency);
+}
+
+void ReplayBenchmark::beginReplay(const AsciiString &filename)
+{
+	s_results.push_back(ReplayResult());
+	ReplayResult &result = s_results.back();
+	result.filename = filename;
+	result.success = false;
+	for (Int i = 0; i < REPLAY_BENCHMARK_SECTION_COUNT; ++i)
+	{
+		result.sectionTicks[i] = 0;
+		result.sectionMaxTicks[i] = 0;
+	}
+}
+
+void ReplayBenchmark::endReplay(Bool success)
+{
+	DEBUG_ASSERTCRASH(!s_results.empty(), ("ReplayBenchmark::endReplay called without beginReplay"));
+	if (!s_results.empty())
+		s_results.back().success = success;
+}
+
+void ReplayBenchmark::beginFrame()
+{
+	s_frameStartTicks = getTicks();
+}
+
+void ReplayBenchmark::endFrame()
+{
+	if (s_results.empty())
+		return;
+
+	s_results.back().frameTicks.push_back(getTicks() - s_frameStartTicks);
+}
+
+void ReplayBenchmark::addSectionTime(ReplayBenchmarkSection section, Int64 ticks)
+{
+	if (s_results.empty())
+		return;
+
+	ReplayResult &result = s_results.back();
+	result.sectionTicks[section] += ticks;
+	if (ticks > result.sectionMaxTicks[section])
+		result.sectionMaxTicks[section] = ticks;
+}
+
+void ReplayBenchmark::reset()
+{
+	s_results.clear();
+}
+
+void ReplayBenchmark::writeRow(FILE *fp, const char *name, const char *result, const std::vector<Int64> &frameTicks,
+	const Int64 *sectionTicks, const Int64 *sectionMaxTicks)
+{
+	std::vector<Int64> sortedTicks = frameTicks;
+	std::sort(sortedTicks.begin(), sortedTicks.end());
+
+	Int64 totalTicks = 0;
+	for (size_t i = 0; i < sortedTicks.size(); ++i)
+		totalTicks += sortedTicks[i];
+
+	const size_t numFrames = sortedTicks.size();
+	const Real totalMs = ticksToMs(totalTicks);
+	const Real fps = totalMs > 0.0f ? numFrames * 1000.0f / totalMs : 0.0f;
+	const Real maxMs = numFrames > 0 ? ticksToMs(sortedTicks.back()) : 0.0f;
+
+	fprintf(fp, "\"%s\",%s,%u,%.3f,%.2f,%.4f,%.4f,%.4f,%.4f",
+		name, result, (UnsignedInt)numFrames, totalMs, fps,
+		ticksToMs(getPercentile(sortedTicks, 50)),
+		ticksToMs(getPercentile(sortedTicks, 95)),
+		ticksToMs(getPercentile(sortedTicks, 99)),
+		maxMs);
+
+	for (Int i = 0; i < REPLAY_BENCHMARK_SECTION_COUNT; ++i)
+	{
+		const Real sectionMs = ticksToMs(sectionTicks[i]);
+		const Real meanMs = numFrames > 0 ? sectionMs / numFrames : 0.0f;
+		fprintf(fp, ",%.3f,%.4f,%.4f", sectionMs, meanMs, ticksToMs(sectionMaxTicks[i]));
+	}
+	fprintf(fp, "\n");
+}
+
+Bool ReplayBenchmark::writeReport(const AsciiString &filename)
+{
+	FILE *fp = fopen(filename.str(), "w");
+	if (fp == nullptr)
+		return false;
+
+	fprintf(fp, "replay,result,frames,total_ms,fps,frame_p50_ms,frame_p95_ms,frame_p99_ms,frame_max_ms");
+	for (Int i = 0; i < REPLAY_BENCHMARK_SECTION_COUNT; ++i)
+		fprintf(fp, ",%s_total_ms,%s_mean_ms,%s_max_ms", SectionNames[i], SectionNames[i], SectionNames[i]);
+	fprintf(fp, "\n");
+
+	std::vector<Int64> allFrameTicks;
+	Int64 allSectionTicks[REPLAY_BENCHMARK_SECTION_COUNT];
+	Int64 allSectionMaxTicks[REPLAY_BENCHMARK_SECTION_COUNT];
+	for (Int i = 0; i < REPLAY_BENCHMARK_SECTION_COUNT; ++i)
+	{
+		allSectionTicks[i] = 0;
+		allSectionMaxTicks[i] = 0;
+	}
+	Bool allSuccess = true;
+
+	for (size_t r = 0; r < s_results.size(); ++r)
+	{
+		const ReplayResult &result = s_results[r];
+		writeRow(fp, result.filename.str(), result.success ? "ok" : "error", result.frameTicks,
+			result.sectionTicks, result.sectionMaxTicks);
+
+		allFrameTicks.insert(allFrameTicks.end(), result.frameTicks.begin(), result.frameTicks.end());
+		for (Int i = 0; i < REPLAY_BENCHMARK_SECTION_COUNT; ++i)
+		{
+			allSectionTicks[i] += result.sectionTicks[i];
+			if (result.sectionMaxTicks[i] > allSectionMaxTicks[i])
+				allSectionMaxTicks[i] = result.sectionMaxTicks[i];
+		}
+		allSuccess = allSuccess && result.success;
+	}
+
+	if (s_results.size() > 1)
+		writeRow(fp, "ALL", allSuccess ? "ok" : "error", allFrameTicks, allSectionTicks, allSectionMaxTicks);
+
+	fclose(fp);
+	return true;
+}
@@ -20,12 +20,17 @@
 
 #include "Common/ReplaySimulation.h"
 
+#include "Common/CommandLine.h"
 #include "Common/GameEngine.h"
 #include "Common/LocalFileSystem.h"
 #include "Common/Recorder.h"
+#include "Common/ReplayBenchmark.h"
 #include "Common/WorkerProcess.h"
 #include "GameLogic/GameLogic.h"
 #include "GameClient/GameClient.h"
+#include "WWLib/thread.h"
+
+#include <algorithm>
 
 
 Bool ReplaySimulation::s_isRunning = false;
@@ -34,17 +39,188 @@ UnsignedInt ReplaySimulation::s_replayCount = 0;
 
 namespace
 {
-int countProcessesRunning(const std::vector<WorkerProcess>& processes)
+struct ReplayWorker
+{
+	WorkerProcess process;
+	size_t filenameIndex;
+};
+
+struct ReplayJob
+{
+	size_t filenameIndex;
+	UnsignedInt frameCount;
+};
+
+// Longest replays first, in original order if equally long.
+bool isLongerReplayJob(const ReplayJob &a, const ReplayJob &b)
+{
+	return a.frameCount > b.frameCount;
+}
+
+int countProcessesRunning(const std::vector<ReplayWorker>& workers)
 {
 	int numProcessesRunning = 0;
 	size_t i = 0;
-	for (; i < processes.size(); ++i)
+	for (; i < workers.size(); ++i)
 	{
-		if (processes[i].isRunning())
+		if (workers[i].process.isRunning())
 			++numProcessesRunning;
 	}
 	return numProcessesRunning;
 }
+
+UnicodeString getExecutablePath()
+{
+	UnicodeString path;
+#ifdef _WIN32
+	WideChar exePath[1024];
+	GetModuleFileNameW(nullptr, exePath, ARRAY_SIZE(exePath));
+	path = exePath;
+#else
+	char exePath[1024];
+	const ssize_t length = readlink("/proc/self/exe", exePath, ARRAY_SIZE(exePath) - 1);
+	exePath[length > 0 ? length : 0] = 0;
+	path.translate(AsciiString(exePath));
+#endif
+	return path;
+}
+
+UnsignedInt getReplayFrameCount(const AsciiString &filename)
+{
+	RecorderClass::ReplayHeader header;
+	header.forPlayback = FALSE;
+	header.filename = filename;
+	if (!TheRecorder->readReplayHeader(header))
+		return 0;
+	return header.frameCount;
+}
+
+AsciiString getReplayBaseName(const AsciiString &filename)
+{
+	const char *name = filename.str();
+	const char *slash = filename.reverseFind('/');
+	const char *backslash = filename.reverseFind('\\');
+	if (backslash > slash)
+		slash = backslash;
+
+	AsciiString baseName = slash != nullptr ? slash + 1 : name;
+	if (baseName.endsWithNoCase(".rep"))
+		baseName.truncateBy(4);
+	return baseName;
+}
+
+// Simulates the replay from the current frame until it mismatches again, and writes the deep CRC dumps
+// of the last matching and the first mismatching CRC frame on the way. Returns true only if the CRC of
+// goodFrame matched the CRC recorded in the replay and the CRC of badFrame mismatched again. Only then
+// did the simulation start from the same state as the original one.
+Bool simulateCRCMismatchAgain(UnsignedInt goodFrame, UnsignedInt badFrame, const AsciiString &goodFileName, const AsciiString &badFileName)
+{
+	TheGameLogic->addDeepCRCDump(goodFrame, goodFileName);
+	TheGameLogic->addDeepCRCDump(badFrame, badFileName);
+	while (TheRecorder->isPlaybackInProgress() && !TheRecorder->sawCRCMismatch() && TheRecorder->getLastMatchingCRCFrame() <= goodFrame)
+	{
+		TheGameLogic->UPDATE();
+	}
+	TheGameLogic->clearDeepCRCDumps();
+
+	return TheGameLogic->getFrame() > badFrame
+		&& TheRecorder->getLastMatchingCRCFrame() == goodFrame
+		&& TheRecorder->getCRCMismatchFrame() == badFrame;
+}
+
+// TheSuperHackers @feature Simulates the mismatching replay again from the last matching CRC and writes
+// deep CRC dumps of the last matching and the first mismatching CRC frame. This uses the closest
+// playback snapshot if there is one. Should the simulation from the snapshot not match the recorded CRC
+// of the last matching frame, or not mismatch at the same frame again, the replay is simulated again
+// from the start. -replaySeekCheck finds the state that a snapshot misses in such a case.
+Bool writeCRCMismatchDumps(const AsciiString &filename)
+{
+	const UnsignedInt goodFrame = TheRecorder->getLastMatchingCRCFrame();
+	const UnsignedInt badFrame = TheRecorder->getCRCMismatchFrame();
+	const AsciiString &directory = TheGlobalData->m_replayBisectDirectory;
+	const AsciiString baseName = getReplayBaseName(filename);
+
+	TheLocalFileSystem->createDirectory(directory);
+
+	AsciiString goodFileName;
+	AsciiString badFileName;
+	goodFileName.format("%s/%s.%u.crc", directory.str(), baseName.str(), goodFrame);
+	badFileName.format("%s/%s.%u.crc", directory.str(), baseName.str(), badFrame);
+
+	Bool reproduced = false;
+	if (TheRecorder->seekPlayback(goodFrame))
+	{
+		reproduced = simulateCRCMismatchAgain(goodFrame, badFrame, goodFileName, badFileName);
+		if (!reproduced)
+		{
+			printf("The snapshot does not reproduce the CRCs of frame %u and %u, simulating the replay again from the start\n", goodFrame, badFrame);
+			fflush(stdout);
+		}
+	}
+
+	if (!reproduced)
+	{
+		if (!TheRecorder->simulateReplay(filename) || !TheRecorder->seekPlayback(goodFrame))
+			return false;
+		if (!simulateCRCMismatchAgain(goodFrame, badFrame, goodFileName, badFileName))
+		{
+			printf("The replay does not mismatch at frame %u again\n", badFrame);
+			fflush(stdout);
+			return false;
+		}
+	}
+
+	printf("Wrote deep CRC dumps of frame %u (last match) and frame %u (first mismatch)\n", goodFrame, badFrame);
+	printf("Compare them with: crcdiff -deep \"%s\" \"%s\"\n", goodFileName.str(), badFileName.str());
+	fflush(stdout);
+	return true;
+}
+
+// TheSuperHackers @feature When the next snapshot is due, simulates the snapshot interval before it again from
+// the previous snapshot and compares the CRC at its end with the one of the first simulation. The CRCs recorded
+// in the replay are compared on the way as well. Returns false if the simulation differs.
+Bool checkPlaybackSeek()
+{
+	const UnsignedInt interval = TheGlobalData->m_replaySnapshotInterval;
+	const UnsignedInt frame = TheGameLogic->getFrame();
+	if (interval == 0 || frame < 2 * interval || frame % interval != 0)
+		return true;
+
+	const UnsignedInt crc = TheGameLogic->getCRC(CRC_RECALC);
+	const UnsignedInt startFrame = frame - interval;
+	if (!TheRecorder->seekPlayback(startFrame))
+	{
+		printf("Seek check: cannot seek back to frame %u\n", startFrame);
+		fflush(stdout);
+		return false;
+	}
+	while (TheRecorder->isPlaybackInProgress() && !TheRecorder->sawCRCMismatch() && TheGameLogic->getFrame() < frame)
+	{
+		TheGameLogic->UPDATE();
+	}
+
+	if (TheGameLogic->getFrame() != frame || TheGameLogic->getCRC(CRC_RECALC) != crc)
+	{
+		printf("Seek check: frame %u does not match after simulating again from frame %u\n", frame, startFrame);
+		fflush(stdout);
+		return false;
+	}
+	return true;
+}
+
+// Returns the command line flag that needs all replays to be simulated in this process, or null if there is none.
+const char *requiresSingleProcess()
+{
+	// Concurrent workers would distort each other's frame times.
+	if (TheGlobalData->m_replayBenchmarkFile.isNotEmpty())
+		return "-replayBenchmark";
+	if (TheGlobalData->m_replayBisectDirectory.isNotEmpty())
+		return "-replayBisect";
+	// Worker processes would overwrite each other's profile.
+	if (TheGlobalData->m_memoryPoolProfileFile.isNotEmpty())
+		return "-memoryPoolProfile";
+	return nullptr;
+}
 } // namespace
 
 int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString> &filenames)
@@ -74,15 +250,31 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 		return numErrors != 0 ? 1 : 0;
 	}
 	// Note that we use printf here because this is run from cmd.
-	DWORD totalStartTimeMillis = GetTickCount();
+	const Bool isBenchmark = TheGlobalData->m_replayBenchmarkFile.isNotEmpty();
+	const Bool isBisect = TheGlobalData->m_replayBisectDirectory.isNotEmpty();
+	const Bool isSeekCheck = TheGlobalData->m_replaySeekCheck;
+	ReplayBenchmark::reset();
+
+	// The bisection rewinds to the last matching CRC, which is much faster with snapshots.
+	// The seek check needs snapshots to seek back to.
+	if ((isBisect || isSeekCheck) && TheGlobalData->m_replaySnapshotInterval == 0)
+		TheWritableGlobalData->m_replaySnapshotInterval = 60 * LOGICFRAMES_PER_SECOND;
+
+	UnsignedInt totalStartTimeMillis = timeGetTime();
 	for (size_t i = 0; i < filenames.size(); i++)
 	{
 		AsciiString filename = filenames[i];
 		printf("Simulating Replay \"%s\"\n", filename.str());
 		fflush(stdout);
-		DWORD startTimeMillis = GetTickCount();
+		UnsignedInt startTimeMillis = timeGetTime();
 		if (TheRecorder->simulateReplay(filename))
 		{
+			Bool sawMismatch = false;
+			if (isBenchmark)
+			{
+				ReplayBenchmark::beginReplay(filename);
+				ReplayBenchmark::setEnabled(true);
+			}
 			UnsignedInt totalTimeSec = TheRecorder->getPlaybackFrameCount() / LOGICFRAMES_PER_SECOND;
 			while (TheRecorder->isPlaybackInProgress())
 			{
@@ -91,20 +283,50 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 				{
 					// Print progress report
 					UnsignedInt gameTimeSec = TheGameLogic->getFrame() / LOGICFRAMES_PER_SECOND;
-					UnsignedInt realTimeSec = (GetTickCount()-startTimeMillis) / 1000;
+					UnsignedInt realTimeSec = (timeGetTime()-startTimeMillis) / 1000;
 					printf("Elapsed Time: %02d:%02d Game Time: %02d:%02d/%02d:%02d\n",
 							realTimeSec/60, realTimeSec%60, gameTimeSec/60, gameTimeSec%60, totalTimeSec/60, totalTimeSec%60);
 					fflush(stdout);
 				}
-				TheGameLogic->UPDATE();
+				if (isSeekCheck && !checkPlaybackSeek())
+				{
+					numErrors++;
+					break;
+				}
+				// TheSuperHackers @feature Keep periodic in-memory snapshots to allow seeking within the replay.
+				TheRecorder->updatePlaybackSnapshots();
+				if (isBenchmark)
+				{
+					ReplayBenchmark::beginFrame();
+					TheGameLogic->UPDATE();
+					ReplayBenchmark::endFrame();
+				}
+				else
+				{
+					TheGameLogic->UPDATE();
+				}
 				if (TheRecorder->sawCRCMismatch())
 				{
+					sawMismatch = true;
 					numErrors++;
 					break;
 				}
 			}
+			if (isBenchmark)
+			{
+				ReplayBenchmark::setEnabled(false);
+				ReplayBenchmark::endReplay(!sawMismatch);
+			}
+			if (isBisect && sawMismatch)
+			{
+				if (!writeCRCMismatchDumps(filename))
+				{
+					printf("Cannot write deep CRC dumps to \"%s\"\n", TheGlobalData->m_replayBisectDirectory.str());
+					fflush(stdout);
+				}
+			}
 			UnsignedInt gameTimeSec = TheGameLogic->getFrame() / LOGICFRAMES_PER_SECOND;
-			UnsignedInt realTimeSec = (GetTickCount()-startTimeMillis) / 1000;
+			UnsignedInt realTimeSec = (timeGetTime()-startTimeMillis) / 1000;
 			printf("Elapsed Time: %02d:%02d Game Time: %02d:%02d/%02d:%02d\n",
 					realTimeSec/60, realTimeSec%60, gameTimeSec/60, gameTimeSec%60, totalTimeSec/60, totalTimeSec%60);
 			fflush(stdout);
@@ -119,82 +341,146 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 	{
 		printf("Simulation of all replays completed. Errors occurred: %d\n", numErrors);
 
-		UnsignedInt realTime = (GetTickCount()-totalStartTimeMillis) / 1000;
+		UnsignedInt realTime = (timeGetTime()-totalStartTimeMillis) / 1000;
 		printf("Total Time: %d:%02d:%02d\n", realTime/60/60, realTime/60%60, realTime%60);
 		fflush(stdout);
 	}
 
+	if (isBenchmark)
+	{
+		if (ReplayBenchmark::writeReport(TheGlobalData->m_replayBenchmarkFile))
+		{
+			printf("Benchmark written to \"%s\"\n", TheGlobalData->m_replayBenchmarkFile.str());
+		}
+		else
+		{
+			printf("Cannot write benchmark to \"%s\"\n", TheGlobalData->m_replayBenchmarkFile.str());
+			numErrors++;
+		}
+		fflush(stdout);
+		ReplayBenchmark::reset();
+	}
+
+	// The peak block counts of the pools are kept over all replays, so one profile covers all of them.
+	if (TheGlobalData->m_memoryPoolProfileFile.isNotEmpty())
+	{
+		if (TheMemoryPoolFactory->writePoolSizeProfile(TheGlobalData->m_memoryPoolProfileFile.str()))
+		{
+			printf("Memory pool profile written to \"%s\"\n", TheGlobalData->m_memoryPoolProfileFile.str());
+		}
+		else
+		{
+			printf("Cannot write memory pool profile to \"%s\"\n", TheGlobalData->m_memoryPoolProfileFile.str());
+			numErrors++;
+		}
+		fflush(stdout);
+	}
+
 	return numErrors != 0 ? 1 : 0;
 }
 
 int ReplaySimulation::simulateReplaysInWorkerProcesses(const std::vector<AsciiString> &filenames, int maxProcesses)
 {
-	DWORD totalStartTimeMillis = GetTickCount();
+	UnsignedInt totalStartTimeMillis = timeGetTime();
 
-	WideChar exePath[1024];
-	GetModuleFileNameW(nullptr, exePath, ARRAY_SIZE(exePath));
+	const UnicodeString exePath = getExecutablePath();
+
+	// TheSuperHackers @fix The workers get all arguments of this process, so that they simulate with the same settings.
+	UnicodeString workerArguments;
+	workerArguments.translate(CommandLine::getArgumentsForReplayWorker());
 
-	std::vector<WorkerProcess> processes;
-	int filenamePositionStarted = 0;
-	int filenamePositionDone = 0;
+	// TheSuperHackers @performance Start the longest replays first, so that no long replay is left running
+	// alone at the end while the other workers are idle. This keeps the total wall time close to optimal.
+	std::vector<ReplayJob> jobs(filenames.size());
+	size_t i;
+	for (i = 0; i < filenames.size(); ++i)
+	{
+		jobs[i].filenameIndex = i;
+		jobs[i].frameCount = getReplayFrameCount(filenames[i]);
+	}
+	std::stable_sort(jobs.begin(), jobs.end(), isLongerReplayJob);
+
+	std::vector<ReplayWorker> workers;
+	size_t jobPositionStarted = 0;
+	size_t numDone = 0;
 	int numErrors = 0;
 
 	while (true)
 	{
-		int i;
-		for (i = 0; i < processes.size(); i++)
-			processes[i].update();
+		for (i = 0; i < workers.size(); i++)
+			workers[i].process.update();
 
-		// Get result of finished processes and print output in order
-		while (!processes.empty())
+		// Stream the output of all workers line by line, prefixed with the replay number
+		for (i = 0; i < workers.size(); i++)
 		{
-			if (!processes[0].isDone())
-				break;
-			AsciiString stdOutput = processes[0].getStdOutput();
-			printf("%d/%d %s", filenamePositionDone+1, (int)filenames.size(), stdOutput.str());
-			DWORD exitcode = processes[0].getExitCode();
+			AsciiString line;
+			while (workers[i].process.getNextStdOutputLine(line))
+			{
+				printf("%d/%d %s\n", (int)workers[i].filenameIndex+1, (int)filenames.size(), line.str());
+			}
+		}
+
+		// Get result of finished processes
+		for (i = 0; i < workers.size(); )
+		{
+			if (!workers[i].process.isDone())
+			{
+				++i;
+				continue;
+			}
+			Int exitcode = workers[i].process.getExitCode();
 			if (exitcode != 0)
-				printf("Error!\n");
-			fflush(stdout);
+				printf("%d/%d Error!\n", (int)workers[i].filenameIndex+1, (int)filenames.size());
 			numErrors += exitcode == 0 ? 0 : 1;
-			processes.erase(processes.begin());
-			filenamePositionDone++;
+			workers.erase(workers.begin() + i);
+			numDone++;
 		}
+		fflush(stdout);
 
-		int numProcessesRunning = countProcessesRunning(processes);
+		int numProcessesRunning = countProcessesRunning(workers);
 
 		// Add new processes when we are below the limit and there are replays left
-		while (numProcessesRunning < maxProcesses && filenamePositionStarted < filenames.size())
+		while (numProcessesRunning < maxProcesses && jobPositionStarted < jobs.size())
 		{
+			const size_t filenameIndex = jobs[jobPositionStarted].filenameIndex;
 			UnicodeString filenameWide;
-			filenameWide.translate(filenames[filenamePositionStarted]);
+			filenameWide.translate(filenames[filenameIndex]);
 			UnicodeString command;
-			command.format(L"\"%s\"%s%s -replay \"%s\"",
-				exePath,
-				TheGlobalData->m_windowed ? L" -win" : L"",
-				TheGlobalData->m_headless ? L" -headless" : L"",
+			command.format(L"\"%s\"%s -replay \"%s\"",
+				exePath.str(),
+				workerArguments.str(),
 				filenameWide.str());
 
-			processes.push_back(WorkerProcess());
-			processes.back().startProcess(command);
+			workers.push_back(ReplayWorker());
+			workers.back().filenameIndex = filenameIndex;
+			if (!workers.back().process.startProcess(command))
+			{
+				printf("%d/%d Cannot start worker process\n", (int)filenameIndex+1, (int)filenames.size());
+				workers.pop_back();
+				numErrors++;
+				numDone++;
+			}
+			else
+			{
+				numProcessesRunning++;
+			}
 
-			filenamePositionStarted++;
-			numProcessesRunning++;
+			jobPositionStarted++;
 		}
 
-		if (processes.empty())
+		if (workers.empty())
 			break;
 
 		// Don't waste CPU here, our workers need every bit of CPU time they can get
-		Sleep(100);
+		ThreadClass::Sleep_Ms(100);
 	}
 
-	DEBUG_ASSERTCRASH(filenamePositionStarted == filenames.size(), ("inconsistent file position 1"));
-	DEBUG_ASSERTCRASH(filenamePositionDone == filenames.size(), ("inconsistent file position 2"));
+	DEBUG_ASSERTCRASH(jobPositionStarted == filenames.size(), ("inconsistent file position 1"));
+	DEBUG_ASSERTCRASH(numDone == filenames.size(), ("inconsistent file position 2"));
 
 	printf("Simulation of all replays completed. Errors occurred: %d\n", numErrors);
 
-	UnsignedInt realTime = (GetTickCount()-totalStartTimeMillis) / 1000;
+	UnsignedInt realTime = (timeGetTime()-totalStartTimeMillis) / 1000;
 	printf("Total Wall Time: %d:%02d:%02d\n", realTime/60/60, realTime/60%60, realTime%60);
 	fflush(stdout);
 
@@ -246,6 +532,15 @@ std::vector<AsciiString> ReplaySimulation::resolveFilenameWildcards(const std::v
 int ReplaySimulation::simulateReplays(const std::vector<AsciiString> &filenames, int maxProcesses)
 {
 	std::vector<AsciiString> filenamesResolved = resolveFilenameWildcards(filenames);
+
+	const char *singleProcessFlag = requiresSingleProcess();
+	if (singleProcessFlag != nullptr && maxProcesses != SIMULATE_REPLAYS_SEQUENTIAL)
+	{
+		printf("Ignoring -jobs because %s simulates all replays in this process\n", singleProcessFlag);
+		fflush(stdout);
+		maxProcesses = SIMULATE_REPLAYS_SEQUENTIAL;
+	}
+
 	if (maxProcesses == SIMULATE_REPLAYS_SEQUENTIAL)
 		return simulateReplaysInThisProcess(filenamesResolved);
 	else
@@ -49,7 +49,11 @@
 #include "Common/ArchiveFile.h"
 #include "Common/ArchiveFileSystem.h"
 #include "Common/AsciiString.h"
+#include "Common/CriticalSection.h"
+#include "Common/GlobalData.h"
+#include "Common/LocalFileSystem.h"
 #include "Common/PerfTimer.h"
+#include "Common/WorkerThreadPool.h"
 
 
 //----------------------------------------------------------------------------
@@ -68,11 +72,41 @@
 //         Private Types
 //----------------------------------------------------------------------------
 
+// Opens archive files on the worker threads. Opening an archive only reads its own file and fills its own
+// directory tree, so the archives can be opened at the same time. The errors are kept per archive and
+// reported by the calling thread, because the error dialogs must not be raised from a worker thread.
+class OpenArchiveFilesJob : public ParallelJob
+{
+public:
+	OpenArchiveFilesJob(ArchiveFileSystem *fileSystem, const std::vector<AsciiString> &filenames, std::vector<ArchiveFile *> &archiveFiles, std::vector<AsciiString> &errors)
+		: m_fileSystem(fileSystem)
+		, m_filenames(filenames)
+		, m_archiveFiles(archiveFiles)
+		, m_errors(errors)
+	{
+	}
+
+	virtual void run(Int begin, Int end) override
+	{
+		for (Int i = begin; i < end; ++i)
+		{
+			m_archiveFiles[i] = m_fileSystem->tryOpenArchiveFile(m_filenames[i].str(), m_errors[i]);
+		}
+	}
+
+private:
+	ArchiveFileSystem *m_fileSystem;
+	const std::vector<AsciiString> &m_filenames;
+	std::vector<ArchiveFile *> &m_archiveFiles;
+	std::vector<AsciiString> &m_errors;
+};
+
 
 //----------------------------------------------------------------------------
 //         Private Data
 //----------------------------------------------------------------------------
 
+static CriticalSection s_localFileSystemCriticalSection;
 
 
 //----------------------------------------------------------------------------
@@ -168,6 +202,21 @@ void ArchiveFileSystem::loadIntoDirectoryTree(ArchiveFile *archiveFile, Bool ove
 
 		dirInfo->m_files.insert(fileIt, std::make_pair(token, archiveFile));
 
+		// TheSuperHackers @performance Keep the index of full paths in the same order as the directory tree.
+		Char key[ArchivedPathIndex<ArchiveFileList>::MAX_KEY_LENGTH];
+		if (m_fileIndex.makeKey(it->str(), key))
+		{
+			ArchiveFileList &archives = m_fileIndex.insert(key);
+			if (overwrite)
+			{
+				archives.insert(archives.begin(), archiveFile);
+			}
+			else
+			{
+				archives.push_back(archiveFile);
+			}
+		}
+
 #if defined(DEBUG_LOGGING) && ENABLE_FILESYSTEM_LOGGING
 		{
 			const stl::const_range<ArchivedFileLocationMap> range = stl::get_range(dirInfo->m_files, token, 0);
@@ -210,6 +259,79 @@ void ArchiveFileSystem::loadIntoDirectoryTree(ArchiveFile *archiveFile, Bool ove
 	}
 }
 
+/**
+ * TheSuperHackers @performance Opens the archive files on the worker threads, because reading their directory
+ * listings is most of the startup time of the file system. Then loads them into the directory tree one after
+ * the other in the order of the list, so that the same archives override each other as before.
+ */
+Bool ArchiveFileSystem::loadArchiveFiles(const std::vector<AsciiString> &filenames, Bool overwrite)
+{
+	LARGE_INTEGER startTime;
+	QueryPerformanceCounter(&startTime);
+
+	std::vector<ArchiveFile *> archiveFiles(filenames.size(), nullptr);
+	std::vector<AsciiString> errors(filenames.size());
+	OpenArchiveFilesJob job(this, filenames, archiveFiles, errors);
+	if (TheWorkerThreadPool != nullptr)
+	{
+		TheWorkerThreadPool->runParallel(job, (Int)filenames.size(), 1);
+	}
+	else
+	{
+		job.run(0, (Int)filenames.size());
+	}
+
+	Int archiveCount = 0;
+	for (size_t i = 0; i < filenames.size(); ++i)
+	{
+		if (errors[i].isNotEmpty())
+		{
+			DEBUG_CRASH(("%s", errors[i].str()));
+		}
+
+		ArchiveFile *archiveFile = archiveFiles[i];
+		if (archiveFile == nullptr)
+			continue;
+
+		DEBUG_LOG(("ArchiveFileSystem::loadArchiveFiles - loading %s into the directory tree.", filenames[i].str()));
+		loadIntoDirectoryTree(archiveFile, overwrite);
+		m_archiveFileMap[filenames[i]] = archiveFile;
+		DEBUG_LOG(("ArchiveFileSystem::loadArchiveFiles - %s inserted into the archive file map.", filenames[i].str()));
+		++archiveCount;
+	}
+
+	// TheSuperHackers @info The mount time is also printed in release builds when running headless, where the
+	// console output is the log, so that the startup time can be compared between builds.
+	LARGE_INTEGER endTime;
+	LARGE_INTEGER freq;
+	QueryPerformanceCounter(&endTime);
+	QueryPerformanceFrequency(&freq);
+	const double milliseconds = (double)(endTime.QuadPart - startTime.QuadPart) * 1000.0 / (double)freq.QuadPart;
+	DEBUG_LOG(("ArchiveFileSystem::loadArchiveFiles - mounted %d of %d archives in %.2f ms",
+		archiveCount, (Int)filenames.size(), milliseconds));
+	if (TheGlobalData != nullptr && TheGlobalData->m_headless)
+		printf("Mounted %d of %d archives in %.2f ms\n", archiveCount, (Int)filenames.size(), milliseconds);
+
+	return archiveCount > 0;
+}
+
+ArchiveFile *ArchiveFileSystem::openArchiveFile(const Char *filename)
+{
+	AsciiString error;
+	ArchiveFile *archiveFile = tryOpenArchiveFile(filename, error);
+	if (error.isNotEmpty())
+	{
+		DEBUG_CRASH(("%s", error.str()));
+	}
+	return archiveFile;
+}
+
+File *ArchiveFileSystem::openLocalFile(const Char *filename)
+{
+	ScopedCriticalSection scopedCriticalSection(&s_localFileSystemCriticalSection);
+	return TheLocalFileSystem->openFile(filename, File::READ | File::BINARY);
+}
+
 void ArchiveFileSystem::loadMods()
 {
 	if (TheGlobalData->m_modBIG.isNotEmpty())
@@ -238,14 +360,7 @@ void ArchiveFileSystem::loadMods()
 
 Bool ArchiveFileSystem::doesFileExist(const Char *filename, FileInstance instance) const
 {
-	ArchivedDirectoryInfoResult result = const_cast<ArchiveFileSystem*>(this)->getArchivedDirectoryInfo(filename);
-
-	if (!result.valid())
-		return false;
-
-	stl::const_range<ArchivedFileLocationMap> range = stl::get_range(result.dirInfo->m_files, result.lastToken, instance);
-
-	return range.valid();
+	return findArchiveFile(filename, instance) != nullptr;
 }
 
 ArchivedDirectoryInfo* ArchiveFileSystem::friend_getArchivedDirectoryInfo(const Char* directory)
@@ -289,7 +404,7 @@ ArchiveFileSystem::ArchivedDirectoryInfoResult ArchiveFileSystem::getArchivedDir
 
 File * ArchiveFileSystem::openFile(const Char *filename, Int access, FileInstance instance)
 {
-	ArchiveFile* archive = getArchiveFile(filename, instance);
+	ArchiveFile* archive = findArchiveFile(filename, instance);
 
 	if (archive == nullptr)
 		return nullptr;
@@ -317,17 +432,22 @@ Bool ArchiveFileSystem::getFileInfo(const AsciiString& filename, FileInfo *fileI
 
 ArchiveFile* ArchiveFileSystem::getArchiveFile(const AsciiString& filename, FileInstance instance) const
 {
-	ArchivedDirectoryInfoResult result = const_cast<ArchiveFileSystem*>(this)->getArchivedDirectoryInfo(filename.str());
+	return findArchiveFile(filename.str(), instance);
+}
 
-	if (!result.valid())
+// TheSuperHackers @performance Looks the file up by its full path, instead of walking the directory tree.
+ArchiveFile* ArchiveFileSystem::findArchiveFile(const Char *filename, FileInstance instance) const
+{
+	Char key[ArchivedPathIndex<ArchiveFileList>::MAX_KEY_LENGTH];
+	if (!m_fileIndex.makeKey(filename, key))
 		return nullptr;
 
-	stl::const_range<ArchivedFileLocationMap> range = stl::get_range(result.dirInfo->m_files, result.lastToken, instance);
+	const ArchiveFileList *archives = m_fileIndex.find(key);
 
-	if (!range.valid())
+	if (archives == nullptr || instance >= archives->size())
 		return nullptr;
-	
-	return range.get()->second;
+
+	return (*archives)[instance];
 }
 
 void ArchiveFileSystem::getFileListInDirectory(const AsciiString& currentDirectory, const AsciiString& originalDirectory, const AsciiString& searchName, FilenameList &filenameList, Bool searchSubdirectories) const
@@ -55,6 +55,7 @@
 #ifdef MEMORYPOOL_DEBUG
 #include "GameClient/ClientRandomValue.h"
 #endif
+#include <Utility/interlocked_adapter.h>
 #ifdef MEMORYPOOL_STACKTRACE
 	#include "Common/StackDump.h"
 #endif
@@ -195,6 +196,30 @@ DECLARE_PERF_TIMER(MemoryPoolInitFilling)
 static Bool thePreMainInitFlag = false;
 static Bool theMainInitFlag = false;
 
+#ifdef MEMORYPOOL_THREAD_CACHE
+enum
+{
+	MAX_THREAD_CACHED_POOLS = 1024,					///< pools created after this many pools are not cached
+	MAX_THREAD_CACHE_BLOCKS = 32,						///< max number of blocks a thread caches per pool
+	MAX_THREAD_CACHE_BYTES = 16 * 1024			///< max number of bytes a thread caches per pool
+};
+
+/**
+	the free blocks that one thread holds for one pool. the blocks are linked thru their free-block link,
+	and are counted as used by their blobs, but not by the pool.
+*/
+struct MemoryPoolThreadCache
+{
+	long										serial;				///< serial of the pool when the blocks were cached
+	Int											count;				///< number of cached blocks
+	MemoryPoolSingleBlock		*firstBlock;	///< head of the cached blocks
+};
+
+static THREAD_LOCAL MemoryPoolThreadCache *theThreadCaches = nullptr;	///< the caches of the calling thread, indexed by MemoryPool::m_threadCacheIndex
+static long theThreadCachedPoolCount = 0;
+static long theThreadCacheSerial = 0;
+#endif
+
 // ----------------------------------------------------------------------------
 // PRIVATE PROTOTYPES
 // ----------------------------------------------------------------------------
@@ -1508,6 +1533,11 @@ MemoryPool::MemoryPool() :
 	m_firstBlob(nullptr),
 	m_lastBlob(nullptr),
 	m_firstBlobWithFreeBlocks(nullptr)
+#ifdef MEMORYPOOL_THREAD_CACHE
+	, m_threadCacheIndex(-1)
+	, m_threadCacheSize(0)
+	, m_threadCacheSerial(0)
+#endif
 {
 }
 
@@ -1530,6 +1560,24 @@ void MemoryPool::init(MemoryPoolFactory *factory, const char *poolName, Int allo
 	m_lastBlob = nullptr;
 	m_firstBlobWithFreeBlocks = nullptr;
 
+#ifdef MEMORYPOOL_THREAD_CACHE
+	// reset() calls us again; the pool keeps its slot, but all blocks cached so far become invalid.
+	if (m_threadCacheIndex < 0)
+	{
+		m_threadCacheSize = MAX_THREAD_CACHE_BYTES / m_allocationSize;
+		if (m_threadCacheSize > MAX_THREAD_CACHE_BLOCKS)
+			m_threadCacheSize = MAX_THREAD_CACHE_BLOCKS;
+
+		if (m_threadCacheSize >= 2)
+		{
+			const long index = InterlockedIncrement(&theThreadCachedPoolCount) - 1;
+			if (index < MAX_THREAD_CACHED_POOLS)
+				m_threadCacheIndex = index;
+		}
+	}
+	m_threadCacheSerial = InterlockedIncrement(&theThreadCacheSerial);
+#endif
+
 	// go ahead and init the initial block here (will throw on failure)
 	createBlob(m_initialAllocationCount);
 }
@@ -1610,7 +1658,7 @@ Int MemoryPool::freeBlob(MemoryPoolBlob* blob)
 	::sysFree((void *)blob);
 
 	// finally... bookkeeping
-	m_usedBlocksInPool -= usedBlocksInBlob;
+	InterlockedExchangeAdd(&m_usedBlocksInPool, -usedBlocksInBlob);
 	m_totalBlocksInPool -= totalBlocksInBlob;
 
 #ifdef MEMORYPOOL_DEBUG
@@ -1622,14 +1670,12 @@ Int MemoryPool::freeBlob(MemoryPoolBlob* blob)
 
 //-----------------------------------------------------------------------------
 /**
-	allocate a block from this pool and return it, but don't bother zeroing
-	out the block. if unable to allocate, throw ERROR_OUT_OF_MEMORY. this
-	function will never return null.
+	take a free block from the blobs of this pool. if there is none, create an
+	overflow blob. if unable to, throw ERROR_OUT_OF_MEMORY. this function will never
+	return null. the caller must hold TheMemoryPoolCriticalSection.
 */
-void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG1)
+MemoryPoolSingleBlock *MemoryPool::allocateSingleBlockFromBlobs(DECLARE_LITERALSTRING_ARG1)
 {
-	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
-
 	if (m_firstBlobWithFreeBlocks != nullptr && !m_firstBlobWithFreeBlocks->hasAnyFreeBlocks())
 	{
 		// hmm... the current 'free' blob has nothing available. look and see if there
@@ -1667,6 +1713,167 @@ void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG
 	MemoryPoolSingleBlock *block = blob->allocateSingleBlock(PASS_LITERALSTRING_ARG1);
 	DEBUG_ASSERTCRASH(block, ("should not fail here"));
 
+	return block;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	make the block available in its blob again. the caller must hold
+	TheMemoryPoolCriticalSection.
+*/
+void MemoryPool::freeSingleBlockToBlob(MemoryPoolSingleBlock *block)
+{
+	MemoryPoolBlob *blob = block->getOwningBlob();
+
+	blob->freeSingleBlock(block);
+
+	// if we want to free the blobs as they become empty, do that here.
+	// normally we don't bother, but just in case this is ever desired, here's how you'd do it...
+	//
+	// if (blob->m_usedBlocksInBlob == 0)
+	// {
+	//	freeBlob(blob);
+	//	return;
+	//}
+
+	if (!m_firstBlobWithFreeBlocks)
+		m_firstBlobWithFreeBlocks = blob;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	count one more block as used. the counters are shared by all threads, and
+	the thread caches change them without holding the critical section.
+*/
+void MemoryPool::addUsedBlock()
+{
+	const long used = InterlockedIncrement(&m_usedBlocksInPool);
+	long peak = m_peakUsedBlocksInPool;
+	while (peak < used)
+	{
+		const long prevPeak = InterlockedCompareExchange(&m_peakUsedBlocksInPool, used, peak);
+		if (prevPeak == peak)
+			break;
+		peak = prevPeak;
+	}
+}
+
+#ifdef MEMORYPOOL_THREAD_CACHE
+//-----------------------------------------------------------------------------
+/**
+	return the block cache of the calling thread for this pool. the caches of a
+	thread are created on its first allocation. if the pool was reset since the
+	blocks were cached, the blocks are gone with their blobs and the cache starts empty.
+*/
+MemoryPoolThreadCache *MemoryPool::getThreadCache()
+{
+	if (m_threadCacheIndex < 0)
+		return nullptr;
+
+	MemoryPoolThreadCache *caches = theThreadCaches;
+	if (caches == nullptr)
+	{
+		const Int cachesSize = MAX_THREAD_CACHED_POOLS * sizeof(MemoryPoolThreadCache);
+		caches = (MemoryPoolThreadCache *)::sysAllocateDoNotZero(cachesSize);	// will throw on failure
+		memset(caches, 0, cachesSize);
+		theThreadCaches = caches;
+	}
+
+	MemoryPoolThreadCache *cache = &caches[m_threadCacheIndex];
+	if (cache->serial != m_threadCacheSerial)
+	{
+		cache->serial = m_threadCacheSerial;
+		cache->count = 0;
+		cache->firstBlock = nullptr;
+	}
+	return cache;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	move half a cache of blocks from the blobs into the thread cache. only the first
+	block may create an overflow blob, so the cache does not grow the pool beyond
+	what the allocation itself needs.
+*/
+void MemoryPool::refillThreadCache(MemoryPoolThreadCache *cache)
+{
+	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+
+	const Int count = m_threadCacheSize / 2;
+	for (Int i = 0; i < count; ++i)
+	{
+		if (i > 0 && (m_firstBlobWithFreeBlocks == nullptr || !m_firstBlobWithFreeBlocks->hasAnyFreeBlocks()))
+			break;
+
+		MemoryPoolSingleBlock *block = allocateSingleBlockFromBlobs();	// throws on failure
+		block->setNextFreeBlock(cache->firstBlock);
+		cache->firstBlock = block;
+		++cache->count;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+	move up to count blocks from the thread cache back into their blobs.
+*/
+void MemoryPool::drainThreadCache(MemoryPoolThreadCache *cache, Int count)
+{
+	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+
+	for (Int i = 0; i < count && cache->firstBlock != nullptr; ++i)
+	{
+		MemoryPoolSingleBlock *block = cache->firstBlock;
+		cache->firstBlock = block->getNextFreeBlock();
+		--cache->count;
+		freeSingleBlockToBlob(block);
+	}
+}
+#endif
+
+//-----------------------------------------------------------------------------
+/**
+	return the blocks that the calling thread has cached for this pool.
+*/
+void MemoryPool::releaseThreadCache()
+{
+#ifdef MEMORYPOOL_THREAD_CACHE
+	if (m_threadCacheIndex < 0 || theThreadCaches == nullptr)
+		return;
+
+	MemoryPoolThreadCache *cache = getThreadCache();
+	drainThreadCache(cache, cache->count);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+/**
+	allocate a block from this pool and return it, but don't bother zeroing
+	out the block. if unable to allocate, throw ERROR_OUT_OF_MEMORY. this
+	function will never return null.
+*/
+void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG1)
+{
+#ifdef MEMORYPOOL_THREAD_CACHE
+	MemoryPoolThreadCache *cache = getThreadCache();
+	if (cache != nullptr)
+	{
+		if (cache->count == 0)
+			refillThreadCache(cache);	// throws on failure
+
+		MemoryPoolSingleBlock *block = cache->firstBlock;
+		cache->firstBlock = block->getNextFreeBlock();
+		--cache->count;
+
+		addUsedBlock();
+
+		return block->getUserData();
+	}
+#endif
+
+	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+
+	MemoryPoolSingleBlock *block = allocateSingleBlockFromBlobs(PASS_LITERALSTRING_ARG1);	// throws on failure
+
 #ifdef MEMORYPOOL_CHECKPOINTING
 	BlockCheckpointInfo *bi = debugAddCheckpointInfo(block->debugGetLiteralTagString(), m_factory->getCurCheckpoint(), getAllocationSize());
 	if (bi)
@@ -1674,9 +1881,7 @@ void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG
 #endif
 
 	// bookkeeping
-	++m_usedBlocksInPool;
-	if (m_peakUsedBlocksInPool < m_usedBlocksInPool)
-		m_peakUsedBlocksInPool = m_usedBlocksInPool;
+	addUsedBlock();
 
 #ifdef MEMORYPOOL_DEBUG
 	m_factory->adjustTotals(debugLiteralTagString, 1*getAllocationSize(), 0);
@@ -1713,16 +1918,31 @@ void MemoryPool::freeBlock(void* pBlockPtr)
 	if (!pBlockPtr)
 		return;	// my, that was easy
 
+	MemoryPoolSingleBlock *block = MemoryPoolSingleBlock::recoverBlockFromUserData(pBlockPtr);
+	DEBUG_ASSERTCRASH(block->getOwningBlob() && block->getOwningBlob()->getOwningPool() == this, ("block does not belong to this pool"));
+
+#ifdef MEMORYPOOL_THREAD_CACHE
+	MemoryPoolThreadCache *cache = getThreadCache();
+	if (cache != nullptr)
+	{
+		if (cache->count >= m_threadCacheSize)
+			drainThreadCache(cache, m_threadCacheSize / 2);
+
+		block->setNextFreeBlock(cache->firstBlock);
+		cache->firstBlock = block;
+		++cache->count;
+
+		InterlockedDecrement(&m_usedBlocksInPool);
+		return;
+	}
+#endif
+
 	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
 
-	MemoryPoolSingleBlock *block = MemoryPoolSingleBlock::recoverBlockFromUserData(pBlockPtr);
-	MemoryPoolBlob *blob = block->getOwningBlob();
 #ifdef MEMORYPOOL_DEBUG
 	const char* tagString = block->debugGetLiteralTagString();
 #endif
 
-	DEBUG_ASSERTCRASH(blob && blob->getOwningPool() == this, ("block does not belong to this pool"));
-
 #ifdef MEMORYPOOL_CHECKPOINTING
 	BlockCheckpointInfo *bi = block->debugGetCheckpointInfo();
 	DEBUG_ASSERTCRASH(bi, ("hmm, no checkpoint info"));
@@ -1730,22 +1950,10 @@ void MemoryPool::freeBlock(void* pBlockPtr)
 		bi->debugSetFreepoint(m_factory->getCurCheckpoint());
 #endif
 
-	blob->freeSingleBlock(block);
-
-	// if we want to free the blobs as they become empty, do that here.
-	// normally we don't bother, but just in case this is ever desired, here's how you'd do it...
-	//
-	// if (blob->m_usedBlocksInBlob == 0)
-	// {
-	//	freeBlob(blob);
-	//	return;
-	//}
-
-	if (!m_firstBlobWithFreeBlocks)
-		m_firstBlobWithFreeBlocks = blob;
+	freeSingleBlockToBlob(block);
 
 	// bookkeeping
-	--m_usedBlocksInPool;
+	InterlockedDecrement(&m_usedBlocksInPool);
 
 #ifdef MEMORYPOOL_DEBUG
 	m_factory->adjustTotals(tagString, -1*getAllocationSize(), 0);
@@ -1868,12 +2076,12 @@ void MemoryPool::removeFromList(MemoryPool **pHead)
 	{
 		DEBUG_LOG(("%s,%32s,%6d,%6d,%6d,%6d,%6d,%6d",PREPEND,
 			pool->m_poolName,pool->m_allocationSize,pool->m_initialAllocationCount,pool->m_overflowAllocationCount,
-			pool->m_usedBlocksInPool,pool->m_totalBlocksInPool,pool->m_peakUsedBlocksInPool));
+			(Int)pool->m_usedBlocksInPool,pool->m_totalBlocksInPool,(Int)pool->m_peakUsedBlocksInPool));
 		if( fp )
 		{
 			fprintf( fp, "%s,%32s,%6d,%6d,%6d,%6d,%6d,%6d\n",PREPEND,
 				pool->m_poolName,pool->m_allocationSize,pool->m_initialAllocationCount,pool->m_overflowAllocationCount,
-				pool->m_usedBlocksInPool,pool->m_totalBlocksInPool,pool->m_peakUsedBlocksInPool );
+				(Int)pool->m_usedBlocksInPool,pool->m_totalBlocksInPool,(Int)pool->m_peakUsedBlocksInPool );
 		}
 	}
 }
@@ -1911,7 +2119,7 @@ void MemoryPool::debugMemoryVerifyPool()
 		used += blob->getUsedBlockCount();
 		total += blob->getTotalBlockCount();
 	}
-	DEBUG_ASSERTCRASH(m_usedBlocksInPool == used, ("used mismatch %d %d",m_usedBlocksInPool,used));
+	DEBUG_ASSERTCRASH(m_usedBlocksInPool == used, ("used mismatch %d %d",(Int)m_usedBlocksInPool,used));
 	DEBUG_ASSERTCRASH(m_totalBlocksInPool == total, ("total mismatch %d %d",m_totalBlocksInPool,total));
 }
 #endif
@@ -2161,6 +2369,19 @@ void DynamicMemoryAllocator::debugIgnoreLeaksForThisBlock(void* pBlockPtr)
 */
 void *DynamicMemoryAllocator::allocateBytesDoNotZeroImplementation(Int numBytes DECLARE_LITERALSTRING_ARG2)
 {
+#ifdef MEMORYPOOL_THREAD_CACHE
+	// the subpools are thread safe by themselves; only the raw blocks need the dma lock.
+	{
+		MemoryPool *pool = findPoolForSize(numBytes);
+		if (pool != nullptr)
+		{
+			void *result = pool->allocateBlockDoNotZeroImplementation();
+			InterlockedIncrement(&m_usedBlocksInDma);
+			return result;
+		}
+	}
+#endif
+
 	ScopedCriticalSection scopedCriticalSection(TheDmaCriticalSection);
 
 	void *result = nullptr;
@@ -2235,7 +2456,7 @@ void *DynamicMemoryAllocator::allocateBytesDoNotZeroImplementation(Int numBytes
 }
 #endif // MEMORYPOOL_DEBUG
 
-	++m_usedBlocksInDma;
+	InterlockedIncrement(&m_usedBlocksInDma);
 	DEBUG_ASSERTCRASH(m_usedBlocksInDma >= 0, ("negative count for m_usedBlocksInDma"));
 #ifdef MEMORYPOOL_DEBUG
 	#ifdef USE_FILLER_VALUE
@@ -2277,6 +2498,19 @@ void DynamicMemoryAllocator::freeBytes(void* pBlockPtr)
 	if (!pBlockPtr)
 		return;
 
+#ifdef MEMORYPOOL_THREAD_CACHE
+	// the subpools are thread safe by themselves; only the raw blocks need the dma lock.
+	{
+		MemoryPoolSingleBlock *block = MemoryPoolSingleBlock::recoverBlockFromUserData(pBlockPtr);
+		if (block->getOwningBlob())
+		{
+			block->getOwningBlob()->getOwningPool()->freeBlock(pBlockPtr);
+			InterlockedDecrement(&m_usedBlocksInDma);
+			return;
+		}
+	}
+#endif
+
 	ScopedCriticalSection scopedCriticalSection(TheDmaCriticalSection);
 
 #ifdef MEMORYPOOL_CHECK_BLOCK_OWNERSHIP
@@ -2344,7 +2578,7 @@ void DynamicMemoryAllocator::freeBytes(void* pBlockPtr)
 		::sysFree((void *)block);
 
 	}
-	--m_usedBlocksInDma;
+	InterlockedDecrement(&m_usedBlocksInDma);
 	DEBUG_ASSERTCRASH(m_usedBlocksInDma >= 0, ("negative count for m_usedBlocksInDma"));
 
 #ifdef INTENSE_DMA_BOOKKEEPING
@@ -2782,6 +3016,31 @@ void MemoryPoolFactory::reset()
 #endif
 }
 
+//-----------------------------------------------------------------------------
+/**
+	return the blocks cached by the calling thread to their pools, and free the
+	caches of the thread.
+*/
+void MemoryPoolFactory::releaseThreadCaches()
+{
+#ifdef MEMORYPOOL_THREAD_CACHE
+	if (theThreadCaches == nullptr)
+		return;
+
+	{
+		ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+
+		for (MemoryPool *pool = m_firstPoolInFactory; pool; pool = pool->getNextPoolInList())
+		{
+			pool->releaseThreadCache();
+		}
+	}
+
+	::sysFree((void *)theThreadCaches);
+	theThreadCaches = nullptr;
+#endif
+}
+
 //-----------------------------------------------------------------------------
 #ifdef MEMORYPOOL_DEBUG
 static const char* s_specialPrefixes[MAX_SPECIAL_USED] =
@@ -3058,6 +3317,166 @@ void MemoryPoolFactory::memoryPoolUsageReport( const char* filename, FILE *appen
 #endif
 }
 
+//-----------------------------------------------------------------------------
+// TheSuperHackers @feature Pool size profiles. The profile lines carry the peak block count in a trailing
+// comment, which is read back on the next write so that the recorded sizes only ever grow.
+
+static const Int POOL_SIZE_PROFILE_HEADROOM_DIVISOR = 8;	///< add 1/8 of the peak block count as headroom
+
+//-----------------------------------------------------------------------------
+static Int roundUpPoolSize(Int count)
+{
+	// pool sizes must be multiples of 4, see userMemoryManagerInitPools.
+	if (count < 4)
+		return 4;
+	return (count + 3) & ~3;
+}
+
+//-----------------------------------------------------------------------------
+static Bool isDmaSubPool(DynamicMemoryAllocator *firstDma, MemoryPool *pool)
+{
+	for (DynamicMemoryAllocator *dma = firstDma; dma; dma = dma->getNextDmaInList())
+	{
+		for (Int i = 0; i < dma->getDmaMemoryPoolCount(); ++i)
+		{
+			if (dma->getNthDmaMemoryPool(i) == pool)
+				return true;
+		}
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	read the peak block counts of an existing profile into peaks[], which is indexed like the pool list.
+	unknown pools and lines without a peak are ignored.
+*/
+static void readPoolSizeProfilePeaks(const char *filename, Bool isInl, MemoryPool *firstPool, Int *peaks)
+{
+	FILE *fp = fopen(filename, "r");
+	if (fp == nullptr)
+		return;
+
+	const char *commentMarker = isInl ? "//" : ";";
+	char line[512];
+	while (fgets(line, sizeof(line), fp))
+	{
+		// skip the indentation and the opening of an .inl entry
+		const char *p = line;
+		while (*p == ' ' || *p == '\t' || *p == '{' || *p == '"')
+			++p;
+
+		if (*p == '\0' || strncmp(p, commentMarker, strlen(commentMarker)) == 0)
+			continue;
+
+		char poolName[256];
+		Int len = 0;
+		while (p[len] != '\0' && p[len] != '"' && p[len] != ',' && p[len] != ' ' && p[len] != '\t' && len < (Int)sizeof(poolName) - 1)
+		{
+			poolName[len] = p[len];
+			++len;
+		}
+		poolName[len] = '\0';
+
+		const char *comment = strstr(p + len, commentMarker);
+		Int peak;
+		if (comment == nullptr || sscanf(comment + strlen(commentMarker), " peak %d", &peak) != 1)
+			continue;
+
+		Int index = 0;
+		for (MemoryPool *pool = firstPool; pool; pool = pool->getNextPoolInList(), ++index)
+		{
+			if (stricmp(pool->getPoolName(), poolName) == 0)
+			{
+				if (peaks[index] < peak)
+					peaks[index] = peak;
+				break;
+			}
+		}
+	}
+
+	fclose(fp);
+}
+
+//-----------------------------------------------------------------------------
+static void writePoolSizeProfileLine(FILE *fp, Bool isInl, Bool isDma, MemoryPool *pool, Int peak)
+{
+	Int initial = roundUpPoolSize(peak + peak / POOL_SIZE_PROFILE_HEADROOM_DIVISOR);
+	Int overflow = roundUpPoolSize(pool->getOverflowBlockCount());
+
+	// pools that are not allowed to grow must never shrink.
+	if (pool->getOverflowBlockCount() == 0 && initial < pool->getInitialBlockCount())
+		initial = roundUpPoolSize(pool->getInitialBlockCount());
+
+	if (!isInl)
+		fprintf(fp, "%s %d %d ; peak %d, used %d, total %d\n",
+			pool->getPoolName(), initial, overflow, peak, pool->getUsedBlockCount(), pool->getTotalBlockCount());
+	else if (isDma)
+		fprintf(fp, "\t{ \"%s\", %d, %d, %d },\t// peak %d, used %d, total %d\n",
+			pool->getPoolName(), pool->getAllocationSize(), initial, overflow, peak, pool->getUsedBlockCount(), pool->getTotalBlockCount());
+	else
+		fprintf(fp, "\t{ \"%s\", %d, %d },\t// peak %d, used %d, total %d\n",
+			pool->getPoolName(), initial, overflow, peak, pool->getUsedBlockCount(), pool->getTotalBlockCount());
+}
+
+//-----------------------------------------------------------------------------
+Bool MemoryPoolFactory::writePoolSizeProfile( const char* filename )
+{
+	// note that we use straight stdio stuff here, like userMemoryManagerInitPools does.
+	size_t nameLen = strlen(filename);
+	Bool isInl = nameLen >= 4 && stricmp(filename + nameLen - 4, ".inl") == 0;
+
+	Int numPools = 0;
+	for (MemoryPool *pool = m_firstPoolInFactory; pool; pool = pool->getNextPoolInList())
+		++numPools;
+
+	if (numPools == 0)
+		return false;
+
+	Int *peaks = (Int *)::sysAllocateDoNotZero(numPools * sizeof(Int));
+	Int index = 0;
+	for (MemoryPool *pool = m_firstPoolInFactory; pool; pool = pool->getNextPoolInList(), ++index)
+		peaks[index] = pool->getPeakBlockCount();
+
+	readPoolSizeProfilePeaks(filename, isInl, m_firstPoolInFactory, peaks);
+
+	FILE *fp = fopen(filename, "w");
+	if (fp == nullptr)
+	{
+		DEBUG_LOG(("could not create pool size profile %s", filename));
+		::sysFree(peaks);
+		return false;
+	}
+
+	const char *comment = isInl ? "//" : ";";
+	fprintf(fp, "%s Pool sizes recorded with -memoryPoolProfile from the peak block counts of the profiled matches.\n", comment);
+	if (isInl)
+		fprintf(fp, "%s Paste the DefaultDMA entries into GameMemoryInitDMA_*.inl and the PoolSizes entries into GameMemoryInitPools_*.inl.\n", comment);
+	else
+		fprintf(fp, "%s Copy this file to Data\\INI\\MemoryPools.ini to override the built-in pool sizes.\n", comment);
+
+	// write the dma subpools first, so that the .inl entries are grouped by the array they belong to.
+	for (Int pass = 0; pass < 2; ++pass)
+	{
+		Bool isDmaPass = (pass == 0);
+		if (isInl)
+			fprintf(fp, "\n// %s\n", isDmaPass ? "DefaultDMA: name, allocSize, initialCount, overflowCount" : "PoolSizes: name, initial, overflow");
+		else
+			fprintf(fp, "\n; %s: name initial overflow\n", isDmaPass ? "DMA subpools" : "Pools");
+
+		index = 0;
+		for (MemoryPool *pool = m_firstPoolInFactory; pool; pool = pool->getNextPoolInList(), ++index)
+		{
+			if (isDmaSubPool(m_firstDmaInFactory, pool) == isDmaPass)
+				writePoolSizeProfileLine(fp, isInl, isDmaPass, pool, peaks[index]);
+		}
+	}
+
+	fclose(fp);
+	::sysFree(peaks);
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 #ifdef MEMORYPOOL_DEBUG
 /**
@@ -3410,13 +3829,14 @@ void initMemoryManager()
 {
 	if (TheMemoryPoolFactory == nullptr)
 	{
+		// TheSuperHackers @feature Read the pool sizes before the DMA is created, because they can size its subpools too.
+		userMemoryManagerInitPools();
 		Int numSubPools;
 		const PoolInitRec *pParms;
 		userMemoryManagerGetDmaParms(&numSubPools, &pParms);
 		TheMemoryPoolFactory = new (::sysAllocateDoNotZero(sizeof(MemoryPoolFactory))) MemoryPoolFactory;	// will throw on failure
 		TheMemoryPoolFactory->init();	// will throw on failure
 		TheDynamicMemoryAllocator = TheMemoryPoolFactory->createDynamicMemoryAllocator(numSubPools, pParms);	// will throw on failure
-		userMemoryManagerInitPools();
 		thePreMainInitFlag = false;
 
 		DEBUG_INIT(DEBUG_FLAGS_DEFAULT);
@@ -3485,6 +3905,8 @@ static void preMainInitMemoryManager()
 	if (TheMemoryPoolFactory == nullptr)
 	{
 
+		// TheSuperHackers @feature Read the pool sizes before the DMA is created, because they can size its subpools too.
+		userMemoryManagerInitPools();
 		Int numSubPools;
 		const PoolInitRec *pParms;
 		userMemoryManagerGetDmaParms(&numSubPools, &pParms);
@@ -3492,7 +3914,6 @@ static void preMainInitMemoryManager()
 		TheMemoryPoolFactory->init();	// will throw on failure
 
 		TheDynamicMemoryAllocator = TheMemoryPoolFactory->createDynamicMemoryAllocator(numSubPools, pParms);	// will throw on failure
-		userMemoryManagerInitPools();
 		thePreMainInitFlag = true;
 
 		DEBUG_INIT(DEBUG_FLAGS_DEFAULT);
@@ -3515,6 +3936,10 @@ void shutdownMemoryManager()
 	}
 	else
 	{
+		// the blocks that the main thread still caches must go back to their pools before the pools go away.
+		if (TheMemoryPoolFactory)
+			TheMemoryPoolFactory->releaseThreadCaches();
+
 		if (TheDynamicMemoryAllocator)
 		{
 			DEBUG_ASSERTCRASH(TheMemoryPoolFactory, ("hmm, no factory"));
@@ -140,6 +140,16 @@ void userMemoryManagerInitPools()
 						break;	// from for-p
 					}
 				}
+				// TheSuperHackers @feature The subpools of the DMA can be sized from INI as well.
+				for (size_t i = 0; i < ARRAY_SIZE(DefaultDMA); ++i)
+				{
+					if (stricmp(DefaultDMA[i].poolName, poolName) == 0)
+					{
+						DefaultDMA[i].initialAllocationCount = roundUpMemBound(initial);
+						DefaultDMA[i].overflowAllocationCount = roundUpMemBound(overflow);
+						break;	// from for-i
+					}
+				}
 			}
 		}
 		fclose(fp);
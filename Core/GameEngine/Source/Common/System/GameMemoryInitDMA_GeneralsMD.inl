@@ -16,7 +16,8 @@
 **	along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-static const PoolInitRec DefaultDMA[] =
+// not const -- we might override from INI
+static PoolInitRec DefaultDMA[] =
 {
 	//          name, allocSize, initialCount, overflowCount
 	{   "dmaPool_16",        16,       130000,         10000 },
@@ -292,6 +292,7 @@ static PoolSizeRec PoolSizes[] =
 	{ "DeployStyleAIUpdate", 32, 32 },
 	{ "AssaultTransportAIUpdate", 64, 32 },
 	{ "StreamingArchiveFile", 8, 8 },
+	{ "MappedArchiveFile", 32, 32 },
 
 	{ "DozerActionStateMachine", 256, 32 },
 	{ "DozerPrimaryStateMachine", 256, 32 },
@@ -0,0 +1,222 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: MappedArchiveFile.cpp ////////////////////////////////////////////////////////////////////
+// Read only files that point straight into the memory mapping of their archive
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/MappedArchiveFile.h"
+
+#include "Common/CriticalSection.h"
+
+#include <limits.h>
+
+Int64 ArchiveFileMapping::s_mappedBytes = 0;
+
+// The archives of the game take more address space than a 32 bit process can spare, so only map some of
+// them there. The other archives copy their files to the heap as before.
+static const Int64 MAX_MAPPED_BYTES_32BIT = (Int64)512 * 1024 * 1024;
+
+//-------------------------------------------------------------------------------------------------
+ArchiveFileMapping::ArchiveFileMapping(const char *data, Int size)
+	: m_data(data)
+	, m_size(size)
+	, m_refCount(1)
+{
+}
+
+#ifdef _WIN32
+
+// The archives are mounted and their files closed on worker threads, so s_mappedBytes is guarded by this.
+static CriticalSection s_mappedBytesCriticalSection;
+
+//-------------------------------------------------------------------------------------------------
+ArchiveFileMapping::~ArchiveFileMapping()
+{
+	::UnmapViewOfFile(m_data);
+
+	ScopedCriticalSection scopedCriticalSection(&s_mappedBytesCriticalSection);
+	s_mappedBytes -= m_size;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ArchiveFileMapping::reserveMappedBytes(Int64 size)
+{
+	ScopedCriticalSection scopedCriticalSection(&s_mappedBytesCriticalSection);
+	if (sizeof(void *) < 8 && s_mappedBytes + size > MAX_MAPPED_BYTES_32BIT)
+		return FALSE;
+
+	s_mappedBytes += size;
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ArchiveFileMapping::unreserveMappedBytes(Int64 size)
+{
+	ScopedCriticalSection scopedCriticalSection(&s_mappedBytesCriticalSection);
+	s_mappedBytes -= size;
+}
+
+//-------------------------------------------------------------------------------------------------
+ArchiveFileMapping *ArchiveFileMapping::create(const char *path)
+{
+	HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER size;
+	if (!::GetFileSizeEx(file, &size) || size.QuadPart <= 0 || size.QuadPart > INT_MAX ||
+		!reserveMappedBytes(size.QuadPart))
+	{
+		::CloseHandle(file);
+		return nullptr;
+	}
+
+	// The view keeps the mapping and the file open, so the handles are not needed anymore.
+	HANDLE mapping = ::CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	::CloseHandle(file);
+	if (mapping == nullptr)
+	{
+		unreserveMappedBytes(size.QuadPart);
+		return nullptr;
+	}
+
+	const void *data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	::CloseHandle(mapping);
+	if (data == nullptr)
+	{
+		unreserveMappedBytes(size.QuadPart);
+		DEBUG_LOG(("ArchiveFileMapping: Failed to map %s", path));
+		return nullptr;
+	}
+
+	return NEW ArchiveFileMapping(static_cast<const char *>(data), (Int)size.QuadPart);
+}
+
+//-------------------------------------------------------------------------------------------------
+void ArchiveFileMapping::addRef()
+{
+	::InterlockedIncrement(&m_refCount);
+}
+
+//-------------------------------------------------------------------------------------------------
+void ArchiveFileMapping::release()
+{
+	if (::InterlockedDecrement(&m_refCount) == 0)
+		delete this;
+}
+
+#else // _WIN32
+
+// Memory mapping is not implemented for this platform yet, so the archives copy their files to the heap.
+
+//-------------------------------------------------------------------------------------------------
+ArchiveFileMapping::~ArchiveFileMapping()
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+ArchiveFileMapping *ArchiveFileMapping::create(const char *path)
+{
+	return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ArchiveFileMapping::addRef()
+{
+	++m_refCount;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ArchiveFileMapping::release()
+{
+	if (--m_refCount == 0)
+		delete this;
+}
+
+#endif // _WIN32
+
+//-------------------------------------------------------------------------------------------------
+MappedArchiveFile::MappedArchiveFile()
+	: m_mapping(nullptr)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+MappedArchiveFile::~MappedArchiveFile()
+{
+	releaseMapping();
+}
+
+//-------------------------------------------------------------------------------------------------
+void MappedArchiveFile::releaseMapping()
+{
+	if (m_mapping != nullptr)
+	{
+		// m_data belongs to the mapping, so RAMFile must not delete it.
+		m_data = nullptr;
+		m_mapping->release();
+		m_mapping = nullptr;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool MappedArchiveFile::openFromMapping(ArchiveFileMapping *mapping, const AsciiString& filename, Int offset, Int size)
+{
+	// Open first, so that close() deletes the file if the range is not in the mapping.
+	if (File::open(filename.str(), File::READ | File::BINARY) == FALSE)
+		return FALSE;
+
+	if (mapping == nullptr || offset < 0 || size < 0 || offset > mapping->getSize() - size)
+		return FALSE;
+
+	releaseMapping();
+	delete[] m_data;
+
+	mapping->addRef();
+	m_mapping = mapping;
+	m_data = const_cast<Char *>(mapping->getData()) + offset;
+	m_size = size;
+	m_pos = 0;
+	m_nameStr = filename;
+
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+void MappedArchiveFile::close()
+{
+	releaseMapping();
+	RAMFile::close();
+}
+
+//-------------------------------------------------------------------------------------------------
+char* MappedArchiveFile::readEntireAndClose()
+{
+	if (m_mapping == nullptr)
+		return RAMFile::readEntireAndClose();
+
+	char *buffer = MSGNEW("RAMFILE") char[m_size > 0 ? m_size : 1];
+	memcpy(buffer, m_data, m_size);
+
+	close();
+
+	return buffer;
+}
@@ -0,0 +1,229 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: WorkerThreadPool.cpp /////////////////////////////////////////////////////////////////////
+// A small pool of threads that splits loops over independent items
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/WorkerThreadPool.h"
+
+#include <float.h>
+
+WorkerThreadPool *TheWorkerThreadPool = nullptr;
+
+enum { MAX_WORKER_THREADS = 8 };
+
+#ifdef _WIN32
+
+//-------------------------------------------------------------------------------------------------
+static UnsignedInt getFPControl()
+{
+	return _controlfp(0, 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+static void setFPControl(UnsignedInt control)
+{
+#if defined(_M_IX86)
+	_controlfp(control, _MCW_PC | _MCW_RC);
+#else
+	// The precision control is not supported on x64, where SSE always computes with the precision of the type.
+	_controlfp(control, _MCW_RC);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+WorkerThreadPool::WorkerThreadPool(Int threadCount)
+	: m_threads(nullptr)
+	, m_startSemaphore(nullptr)
+	, m_doneEvent(nullptr)
+	, m_threadCount(0)
+	, m_job(nullptr)
+	, m_count(0)
+	, m_batchSize(1)
+	, m_fpControl(0)
+	, m_quit(false)
+	, m_nextItem(0)
+	, m_pendingWorkers(0)
+	, m_busy(0)
+{
+	if (threadCount > MAX_WORKER_THREADS)
+		threadCount = MAX_WORKER_THREADS;
+	if (threadCount <= 0)
+		return;
+
+	m_startSemaphore = ::CreateSemaphore(nullptr, 0, threadCount, nullptr);
+	m_doneEvent = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
+	if (m_startSemaphore == nullptr || m_doneEvent == nullptr)
+		return;
+
+	m_threads = new HANDLE[threadCount];
+	for (Int i = 0; i < threadCount; ++i)
+	{
+		DWORD threadId;
+		HANDLE thread = ::CreateThread(nullptr, 0, threadProc, this, 0, &threadId);
+		if (thread == nullptr)
+		{
+			DEBUG_LOG(("WorkerThreadPool: Failed to create thread %d of %d", i + 1, threadCount));
+			break;
+		}
+		m_threads[m_threadCount++] = thread;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+WorkerThreadPool::~WorkerThreadPool()
+{
+	if (m_threadCount > 0)
+	{
+		m_quit = true;
+		::ReleaseSemaphore(m_startSemaphore, m_threadCount, nullptr);
+		::WaitForMultipleObjects(m_threadCount, m_threads, TRUE, INFINITE);
+		for (Int i = 0; i < m_threadCount; ++i)
+			::CloseHandle(m_threads[i]);
+	}
+	delete [] m_threads;
+
+	if (m_startSemaphore != nullptr)
+		::CloseHandle(m_startSemaphore);
+	if (m_doneEvent != nullptr)
+		::CloseHandle(m_doneEvent);
+}
+
+//-------------------------------------------------------------------------------------------------
+DWORD WINAPI WorkerThreadPool::threadProc(LPVOID param)
+{
+	WorkerThreadPool *pool = static_cast<WorkerThreadPool *>(param);
+	for (;;)
+	{
+		::WaitForSingleObject(pool->m_startSemaphore, INFINITE);
+		if (pool->m_quit)
+			break;
+
+		setFPControl(pool->m_fpControl);
+		pool->runBatches();
+
+		if (::InterlockedDecrement(&pool->m_pendingWorkers) == 0)
+			::SetEvent(pool->m_doneEvent);
+	}
+
+	// Return the blocks that the jobs left in the memory pool caches of this thread, which would be lost with it.
+	if (TheMemoryPoolFactory != nullptr)
+		TheMemoryPoolFactory->releaseThreadCaches();
+
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+Int WorkerThreadPool::getDefaultThreadCount()
+{
+	SYSTEM_INFO info;
+	::GetSystemInfo(&info);
+	Int count = (Int)info.dwNumberOfProcessors - 1;
+	if (count > MAX_WORKER_THREADS)
+		count = MAX_WORKER_THREADS;
+	return count > 0 ? count : 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+void WorkerThreadPool::runParallel(ParallelJob &job, Int count, Int batchSize)
+{
+	if (count <= 0)
+		return;
+	if (batchSize < 1)
+		batchSize = 1;
+
+	const Int batchCount = (count + batchSize - 1) / batchSize;
+	if (m_threadCount == 0 || batchCount < 2 || ::InterlockedCompareExchange(&m_busy, 1, 0) != 0)
+	{
+		job.run(0, count);
+		return;
+	}
+
+	m_job = &job;
+	m_count = count;
+	m_batchSize = batchSize;
+	m_fpControl = getFPControl();
+	m_nextItem = 0;
+
+	// The calling thread takes the first batch, so wake no more workers than there are other batches.
+	const Int workerCount = min(m_threadCount, batchCount - 1);
+	m_pendingWorkers = workerCount;
+	::ReleaseSemaphore(m_startSemaphore, workerCount, nullptr);
+
+	runBatches();
+
+	::WaitForSingleObject(m_doneEvent, INFINITE);
+	m_job = nullptr;
+	::InterlockedExchange(&m_busy, 0);
+}
+
+#else // _WIN32
+
+// Threads are not implemented for this platform yet, so every job runs on the calling thread.
+
+//-------------------------------------------------------------------------------------------------
+WorkerThreadPool::WorkerThreadPool(Int threadCount)
+	: m_threadCount(0)
+	, m_job(nullptr)
+	, m_count(0)
+	, m_batchSize(1)
+	, m_fpControl(0)
+	, m_quit(false)
+	, m_nextItem(0)
+	, m_pendingWorkers(0)
+	, m_busy(0)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+WorkerThreadPool::~WorkerThreadPool()
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+Int WorkerThreadPool::getDefaultThreadCount()
+{
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+void WorkerThreadPool::runParallel(ParallelJob &job, Int count, Int batchSize)
+{
+	if (count > 0)
+		job.run(0, count);
+}
+
+#endif // _WIN32
+
+//-------------------------------------------------------------------------------------------------
+void WorkerThreadPool::runBatches()
+{
+#ifdef _WIN32
+	for (;;)
+	{
+		const Int begin = (Int)::InterlockedExchangeAdd(&m_nextItem, m_batchSize);
+		if (begin >= m_count)
+			break;
+		const Int end = min(begin + m_batchSize, m_count);
+		m_job->run(begin, end);
+	}
+#endif
+}
@@ -169,6 +169,89 @@ UnsignedInt XferCRC::getCRC()
 
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Add the recorded data to the CRC, with the same result as xfering the recorded snapshot */
+//-------------------------------------------------------------------------------------------------
+void XferCRC::xferRecording( const CRCRecording *recording )
+{
+
+	DEBUG_ASSERTCRASH( recording->isValid(), ("XferCRC::xferRecording - recording is not valid") );
+
+	UnsignedShort begin = 0;
+	for( size_t i = 0; i < recording->m_segmentEnds.size(); ++i )
+	{
+
+		const UnsignedShort end = recording->m_segmentEnds[ i ];
+		xferImplementation( (void *)&recording->m_data[ begin ], end - begin );
+		begin = end;
+
+	}
+
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferCRCRecorder::XferCRCRecorder( CRCRecording *recording )
+{
+
+	m_recording = recording;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferCRCRecorder::~XferCRCRecorder()
+{
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Start a new recording, 'identifier' is only used for debugging */
+//-------------------------------------------------------------------------------------------------
+void XferCRCRecorder::open( AsciiString identifier )
+{
+
+	// call base class
+	XferCRC::open( identifier );
+
+	m_recording->m_data.clear();
+	m_recording->m_segmentEnds.clear();
+	m_recording->m_isValid = FALSE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Close the last segment, the recording can be used from now on */
+//-------------------------------------------------------------------------------------------------
+void XferCRCRecorder::close()
+{
+
+	const size_t size = m_recording->m_data.size();
+	if( m_recording->m_segmentEnds.empty() || m_recording->m_segmentEnds.back() != size )
+		m_recording->m_segmentEnds.push_back( (UnsignedShort)size );
+
+	m_recording->m_isValid = TRUE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Record the data, a size that is not a multiple of 4 ends the current segment */
+//-------------------------------------------------------------------------------------------------
+void XferCRCRecorder::xferImplementation( void *data, Int dataSize )
+{
+
+	if( data == nullptr || dataSize < 1 )
+		return;
+
+	const UnsignedByte *bytes = static_cast<const UnsignedByte *>( data );
+	m_recording->m_data.insert( m_recording->m_data.end(), bytes, bytes + dataSize );
+	DEBUG_ASSERTCRASH( m_recording->m_data.size() <= 0xFFFF, ("XferCRCRecorder - recording is too large") );
+
+	if( (dataSize & 3) != 0 )
+		m_recording->m_segmentEnds.push_back( (UnsignedShort)m_recording->m_data.size() );
+
+}
+
 
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
@@ -177,6 +260,8 @@ XferDeepCRC::XferDeepCRC()
 
 	m_xferMode = XFER_SAVE;
 	m_fileFP = nullptr;
+	m_indexFP = nullptr;
+	m_dataSize = 0;
 
 }
 
@@ -229,6 +314,27 @@ void XferDeepCRC::open( AsciiString identifier )
 
 	// initialize CRC to brand new one at zero
 	m_crc = 0;
+	m_dataSize = 0;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Open the index file 'indexFileName' for writing */
+//-------------------------------------------------------------------------------------------------
+void XferDeepCRC::openIndex( AsciiString indexFileName )
+{
+
+	DEBUG_ASSERTCRASH( m_fileFP != nullptr, ("XferDeepCRC::openIndex - data file is not open") );
+	DEBUG_ASSERTCRASH( m_indexFP == nullptr, ("XferDeepCRC::openIndex - index file is already open") );
+
+	m_indexFP = fopen( indexFileName.str(), "wt" );
+	if( m_indexFP == nullptr )
+	{
+
+		DEBUG_CRASH(( "File '%s' cannot be created", indexFileName.str() ));
+		throw XFER_FILE_NOT_FOUND;
+
+	}
 
 }
 
@@ -238,6 +344,15 @@ void XferDeepCRC::open( AsciiString identifier )
 void XferDeepCRC::close()
 {
 
+	// close the index file
+	if( m_indexFP != nullptr )
+	{
+
+		fclose( m_indexFP );
+		m_indexFP = nullptr;
+
+	}
+
 	// sanity, if we don't have an open file we can do nothing
 	if( m_fileFP == nullptr )
 	{
@@ -280,6 +395,8 @@ void XferDeepCRC::xferImplementation( void *data, Int dataSize )
 
 	}
 
+	m_dataSize += dataSize;
+
 	XferCRC::xferImplementation( data, dataSize );
 
 }
@@ -290,6 +407,30 @@ void XferDeepCRC::xferImplementation( void *data, Int dataSize )
 void XferDeepCRC::xferMarkerLabel( AsciiString asciiStringData )
 {
 
+	// labels are not part of the data, but are recorded in the index
+	if( m_indexFP != nullptr )
+		fprintf( m_indexFP, "L %u %s\n", m_dataSize, asciiStringData.str() );
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Entry point for xfering a snapshot, records the snapshot boundaries in the index */
+// ------------------------------------------------------------------------------------------------
+void XferDeepCRC::xferSnapshot( Snapshot *snapshot )
+{
+
+	if( m_indexFP == nullptr || snapshot == nullptr )
+	{
+
+		XferCRC::xferSnapshot( snapshot );
+		return;
+
+	}
+
+	fprintf( m_indexFP, "B %u\n", m_dataSize );
+	XferCRC::xferSnapshot( snapshot );
+	fprintf( m_indexFP, "E %u\n", m_dataSize );
+
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -307,6 +448,9 @@ void XferDeepCRC::xferAsciiString( AsciiString *asciiStringData )
 
 	}
 
+	// strings are mostly markers, block names and module tags, which make good labels
+	xferMarkerLabel( *asciiStringData );
+
 	// save length of string to follow
 	UnsignedShort len = asciiStringData->getLength();
 	xferUnsignedShort( &len );
@@ -0,0 +1,165 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: XferLoadRAM.cpp //////////////////////////////////////////////////////////////////////////
+// Desc:   Xfer memory read implementation
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// USER INCLUDES //////////////////////////////////////////////////////////////////////////////////
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+#include "Common/XferLoadRAM.h"
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferLoadRAM::XferLoadRAM( const UnsignedByte *data, Int dataSize )
+{
+
+	m_data = data;
+	m_dataSize = dataSize;
+	m_position = 0;
+	m_isOpen = FALSE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferLoadRAM::~XferLoadRAM()
+{
+
+	// warn the user if the buffer was left open
+	DEBUG_ASSERTCRASH( m_isOpen == FALSE, ("Warning: Xfer buffer '%s' was left open", m_identifier.str()) );
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Start reading at the beginning of the buffer, 'identifier' is only used for debugging */
+//-------------------------------------------------------------------------------------------------
+void XferLoadRAM::open( AsciiString identifier )
+{
+
+	// sanity, check to see if we're already open
+	if( m_isOpen )
+	{
+
+		DEBUG_CRASH(( "Cannot open '%s' cause we've already got '%s' open",
+									identifier.str(), m_identifier.str() ));
+		throw XFER_FILE_ALREADY_OPEN;
+
+	}
+
+	// call base class
+	Xfer::open( identifier );
+
+	m_position = 0;
+	m_isOpen = TRUE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Stop reading */
+//-------------------------------------------------------------------------------------------------
+void XferLoadRAM::close()
+{
+
+	// sanity, if we are not open we can do nothing
+	if( m_isOpen == FALSE )
+	{
+
+		DEBUG_CRASH(( "Xfer close called, but no buffer was open" ));
+		throw XFER_FILE_NOT_OPEN;
+
+	}
+
+	m_isOpen = FALSE;
+
+	// erase the identifier
+	m_identifier.clear();
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Read a block size descriptor from the buffer at the current position */
+//-------------------------------------------------------------------------------------------------
+Int XferLoadRAM::beginBlock()
+{
+
+	// sanity
+	DEBUG_ASSERTCRASH( m_isOpen, ("Xfer begin block - buffer for '%s' is not open", m_identifier.str()) );
+
+	if( m_position + (Int)sizeof( XferBlockSize ) > m_dataSize )
+	{
+
+		DEBUG_CRASH(( "Xfer - Error reading block size for '%s'", m_identifier.str() ));
+		return 0;
+
+	}
+
+	XferBlockSize blockSize;
+	memcpy( &blockSize, m_data + m_position, sizeof( XferBlockSize ) );
+	m_position += sizeof( XferBlockSize );
+
+	return blockSize;
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** End block ... this does nothing when reading */
+// ------------------------------------------------------------------------------------------------
+void XferLoadRAM::endBlock()
+{
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Skip forward 'dataSize' bytes in the buffer */
+//-------------------------------------------------------------------------------------------------
+void XferLoadRAM::skip( Int dataSize )
+{
+
+	// sanity
+	DEBUG_ASSERTCRASH( dataSize >=0, ("XferLoadRAM::skip - dataSize '%d' must be greater than 0",
+										 dataSize) );
+
+	if( m_position + dataSize > m_dataSize )
+		throw XFER_SKIP_ERROR;
+
+	m_position += dataSize;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Perform the read operation */
+//-------------------------------------------------------------------------------------------------
+void XferLoadRAM::xferImplementation( void *data, Int dataSize )
+{
+
+	// sanity
+	DEBUG_ASSERTCRASH( m_isOpen, ("XferLoadRAM - buffer for '%s' is not open", m_identifier.str()) );
+
+	if( m_position + dataSize > m_dataSize )
+	{
+
+		DEBUG_CRASH(( "XferLoadRAM - Error reading from '%s'", m_identifier.str() ));
+		throw XFER_READ_ERROR;
+
+	}
+
+	memcpy( data, m_data + m_position, dataSize );
+	m_position += dataSize;
+
+}
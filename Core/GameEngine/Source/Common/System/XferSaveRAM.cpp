@@ -0,0 +1,161 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: XferSaveRAM.cpp //////////////////////////////////////////////////////////////////////////
+// Desc:   Xfer memory write implementation
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// USER INCLUDES //////////////////////////////////////////////////////////////////////////////////
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+#include "Common/XferSaveRAM.h"
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferSaveRAM::XferSaveRAM()
+{
+
+	m_isOpen = FALSE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferSaveRAM::~XferSaveRAM()
+{
+
+	// the block stack should be empty, if it's not that means we started blocks but never
+	// called enough matching end blocks
+	DEBUG_ASSERTCRASH( m_blockPositions.empty(), ("Warning: XferSaveRAM::~XferSaveRAM - m_blockPositions was not empty!") );
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Start writing to an empty buffer, 'identifier' is only used for debugging */
+//-------------------------------------------------------------------------------------------------
+void XferSaveRAM::open( AsciiString identifier )
+{
+
+	// sanity, check to see if we're already open
+	if( m_isOpen )
+	{
+
+		DEBUG_CRASH(( "Cannot open '%s' cause we've already got '%s' open",
+									identifier.str(), m_identifier.str() ));
+		throw XFER_FILE_ALREADY_OPEN;
+
+	}
+
+	// call base class
+	Xfer::open( identifier );
+
+	m_data.clear();
+	m_blockPositions.clear();
+	m_isOpen = TRUE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Stop writing, the written data remains accessible */
+//-------------------------------------------------------------------------------------------------
+void XferSaveRAM::close()
+{
+
+	// sanity, if we are not open we can do nothing
+	if( m_isOpen == FALSE )
+	{
+
+		DEBUG_CRASH(( "Xfer close called, but no buffer was open" ));
+		throw XFER_FILE_NOT_OPEN;
+
+	}
+
+	m_isOpen = FALSE;
+
+	// erase the identifier
+	m_identifier.clear();
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Write a placeholder block size and remember its position for the next endBlock */
+//-------------------------------------------------------------------------------------------------
+Int XferSaveRAM::beginBlock()
+{
+
+	// sanity
+	DEBUG_ASSERTCRASH( m_isOpen, ("Xfer begin block - buffer for '%s' is not open", m_identifier.str()) );
+
+	m_blockPositions.push_back( (Int)m_data.size() );
+
+	// write a placeholder
+	XferBlockSize blockSize = 0;
+	xferImplementation( &blockSize, sizeof( XferBlockSize ) );
+
+	return XFER_OK;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Write the size of the data since the last begin block into its placeholder */
+//-------------------------------------------------------------------------------------------------
+void XferSaveRAM::endBlock()
+{
+
+	// sanity, make sure we have a block started
+	if( m_blockPositions.empty() )
+	{
+
+		DEBUG_CRASH(( "Xfer end block called, but no matching begin block was found" ));
+		throw XFER_BEGIN_END_MISMATCH;
+
+	}
+
+	Int blockPos = m_blockPositions.back();
+	m_blockPositions.pop_back();
+
+	XferBlockSize blockSize = (Int)m_data.size() - blockPos - sizeof( XferBlockSize );
+	memcpy( &m_data[blockPos], &blockSize, sizeof( XferBlockSize ) );
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Skip forward 'dataSize' bytes, the skipped bytes are zero */
+//-------------------------------------------------------------------------------------------------
+void XferSaveRAM::skip( Int dataSize )
+{
+
+	// sanity
+	DEBUG_ASSERTCRASH( m_isOpen, ("XferSaveRAM - buffer for '%s' is not open", m_identifier.str()) );
+
+	m_data.resize( m_data.size() + dataSize, 0 );
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Perform the write operation */
+//-------------------------------------------------------------------------------------------------
+void XferSaveRAM::xferImplementation( void *data, Int dataSize )
+{
+
+	// sanity
+	DEBUG_ASSERTCRASH( m_isOpen, ("XferSaveRAM - buffer for '%s' is not open", m_identifier.str()) );
+
+	const UnsignedByte *bytes = static_cast<const UnsignedByte *>( data );
+	m_data.insert( m_data.end(), bytes, bytes + dataSize );
+
+}
@@ -19,6 +19,19 @@
 #include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
 #include "Common/WorkerProcess.h"
 
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/prctl.h>
+#endif
+#endif
+
+#ifdef _WIN32
+
 // We need Job-related functions, but these aren't defined in the Windows-headers that VC6 uses.
 // So we define them here and load them dynamically.
 #if defined(_MSC_VER) && _MSC_VER < 1300
@@ -65,18 +78,29 @@ static PFN_SetInformationJobObject SetInformationJobObject = (PFN_SetInformation
 static PFN_AssignProcessToJobObject AssignProcessToJobObject = (PFN_AssignProcessToJobObject)GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "AssignProcessToJobObject");
 #endif
 
+#endif // _WIN32
+
 WorkerProcess::WorkerProcess()
 {
+#ifdef _WIN32
 	m_processHandle = nullptr;
 	m_readHandle = nullptr;
 	m_jobHandle = nullptr;
+#else
+	m_pid = 0;
+	m_readFd = -1;
+#endif
+	m_stdOutputLinePos = 0;
 	m_exitcode = 0;
 	m_isDone = false;
 }
 
+#ifdef _WIN32
+
 bool WorkerProcess::startProcess(UnicodeString command)
 {
 	m_stdOutput.clear();
+	m_stdOutputLinePos = 0;
 	m_isDone = false;
 
 	// Create pipe for reading console output
@@ -128,21 +152,6 @@ bool WorkerProcess::isRunning() const
 	return m_processHandle != nullptr;
 }
 
-bool WorkerProcess::isDone() const
-{
-	return m_isDone;
-}
-
-DWORD WorkerProcess::getExitCode() const
-{
-	return m_exitcode;
-}
-
-AsciiString WorkerProcess::getStdOutput() const
-{
-	return m_stdOutput;
-}
-
 bool WorkerProcess::fetchStdOutput()
 {
 	while (true)
@@ -187,16 +196,12 @@ void WorkerProcess::update()
 	}
 
 	// Pipe broke, that means the process already exited. But we call this just to make sure
+	DWORD exitcode = 0;
 	WaitForSingleObject(m_processHandle, INFINITE);
-	GetExitCodeProcess(m_processHandle, &m_exitcode);
-	CloseHandle(m_processHandle);
-	m_processHandle = nullptr;
+	GetExitCodeProcess(m_processHandle, &exitcode);
+	m_exitcode = static_cast<Int>(exitcode);
 
-	CloseHandle(m_readHandle);
-	m_readHandle = nullptr;
-
-	CloseHandle(m_jobHandle);
-	m_jobHandle = nullptr;
+	closeHandles();
 
 	m_isDone = true;
 }
@@ -207,8 +212,19 @@ void WorkerProcess::kill()
 		return;
 
 	if (m_processHandle != nullptr)
-	{
 		TerminateProcess(m_processHandle, 1);
+
+	closeHandles();
+
+	m_stdOutput.clear();
+	m_stdOutputLinePos = 0;
+	m_isDone = false;
+}
+
+void WorkerProcess::closeHandles()
+{
+	if (m_processHandle != nullptr)
+	{
 		CloseHandle(m_processHandle);
 		m_processHandle = nullptr;
 	}
@@ -224,8 +240,181 @@ void WorkerProcess::kill()
 		CloseHandle(m_jobHandle);
 		m_jobHandle = nullptr;
 	}
+}
+
+#else // _WIN32
+
+bool WorkerProcess::startProcess(UnicodeString command)
+{
+	m_stdOutput.clear();
+	m_stdOutputLinePos = 0;
+	m_isDone = false;
+
+	// The command line is passed to the shell, so quoted arguments work the same as on Windows.
+	// Prepare it before the fork, the child may only call async-signal-safe functions.
+	AsciiString commandAscii;
+	commandAscii.translate(command);
+
+	// Create pipe for reading console output
+	int fds[2];
+	if (pipe(fds) != 0)
+		return false;
+
+	const pid_t parentPid = getpid();
+	const pid_t pid = fork();
+	if (pid < 0)
+	{
+		close(fds[0]);
+		close(fds[1]);
+		return false;
+	}
+
+	if (pid == 0)
+	{
+		// We want to make sure that when our process is killed, our workers automatically terminate as well.
+#if defined(__linux__)
+		prctl(PR_SET_PDEATHSIG, SIGKILL);
+		if (getppid() != parentPid)
+			_exit(1);
+#endif
+		dup2(fds[1], STDOUT_FILENO);
+		dup2(fds[1], STDERR_FILENO);
+		close(fds[0]);
+		close(fds[1]);
+		execl("/bin/sh", "sh", "-c", commandAscii.str(), (char *)nullptr);
+		_exit(127);
+	}
+
+	close(fds[1]);
+	m_readFd = fds[0];
+	m_pid = pid;
+
+	// Never block in update, the caller polls all workers in turn
+	fcntl(m_readFd, F_SETFL, fcntl(m_readFd, F_GETFL) | O_NONBLOCK);
+	fcntl(m_readFd, F_SETFD, FD_CLOEXEC);
+
+	return true;
+}
+
+bool WorkerProcess::isRunning() const
+{
+	return m_pid != 0;
+}
+
+bool WorkerProcess::fetchStdOutput()
+{
+	while (true)
+	{
+		DEBUG_ASSERTCRASH(m_readFd >= 0, ("Is not expected invalid"));
+		char buffer[1024];
+		const ssize_t readBytes = read(m_readFd, buffer, ARRAY_SIZE(buffer)-1);
+		if (readBytes < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+			{
+				// Child process is still running and we have all output so far
+				return false;
+			}
+			return true;
+		}
+		if (readBytes == 0)
+		{
+			// All write ends are closed, the process exited
+			return true;
+		}
+
+		buffer[readBytes] = 0;
+		m_stdOutput.concat(buffer);
+	}
+}
+
+void WorkerProcess::update()
+{
+	if (!isRunning())
+		return;
+
+	if (!fetchStdOutput())
+	{
+		// There is still potential output pending
+		return;
+	}
+
+	int status = 0;
+	while (waitpid(m_pid, &status, 0) < 0 && errno == EINTR)
+	{
+	}
+	m_exitcode = WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+	m_pid = 0;
+
+	closeHandles();
+
+	m_isDone = true;
+}
+
+void WorkerProcess::kill()
+{
+	if (!isRunning())
+		return;
+
+	::kill(m_pid, SIGKILL);
+	waitpid(m_pid, nullptr, 0);
+	m_pid = 0;
+
+	closeHandles();
 
 	m_stdOutput.clear();
+	m_stdOutputLinePos = 0;
 	m_isDone = false;
 }
 
+void WorkerProcess::closeHandles()
+{
+	if (m_readFd >= 0)
+	{
+		close(m_readFd);
+		m_readFd = -1;
+	}
+}
+
+#endif // _WIN32
+
+bool WorkerProcess::isDone() const
+{
+	return m_isDone;
+}
+
+Int WorkerProcess::getExitCode() const
+{
+	return m_exitcode;
+}
+
+AsciiString WorkerProcess::getStdOutput() const
+{
+	return m_stdOutput;
+}
+
+bool WorkerProcess::getNextStdOutputLine(AsciiString &line)
+{
+	const Int length = m_stdOutput.getLength();
+	if (m_stdOutputLinePos >= length)
+		return false;
+
+	const char *start = m_stdOutput.str() + m_stdOutputLinePos;
+	const char *end = strchr(start, '\n');
+	if (end == nullptr)
+	{
+		// Keep incomplete lines until the rest arrives
+		if (!m_isDone)
+			return false;
+		end = m_stdOutput.str() + length;
+	}
+
+	line.set(start, static_cast<int>(end - start));
+	line.trimEnd();
+	m_stdOutputLinePos = static_cast<Int>(end - m_stdOutput.str());
+	if (m_stdOutputLinePos < length)
+		++m_stdOutputLinePos;
+	return true;
+}
@@ -3547,6 +3547,21 @@ GameMessageDisposition CommandTranslator::translateGameMessage(const GameMessage
 			}
 			break;
 		}
+		case GameMessage::MSG_META_REPLAY_JUMP_BACK:
+		{
+			if (TheRecorder->isPlaybackMode())
+			{
+				// The snapshots are only taken with -replaySnapshotInterval.
+				if (!TheRecorder->requestPlaybackJumpBack())
+				{
+					TheInGameUI->messageNoFormat(
+						TheGameText->FETCH_OR_SUBSTITUTE("GUI:ReplayNoJumpBack", L"There is no earlier replay snapshot to jump back to")
+					);
+				}
+				disp = DESTROY_MESSAGE;
+			}
+			break;
+		}
 		case GameMessage::MSG_META_STEP_FRAME:
 		case GameMessage::MSG_META_STEP_FRAME_ALT:
 		{
@@ -49,6 +49,9 @@
 #include "GameLogic/PartitionManager.h"
 #include "GameLogic/TerrainLogic.h"
 #include "GameLogic/Weapon.h"
+
+#include "GameNetwork/GameInfo.h"
+
 #if RETAIL_COMPATIBLE_PATHFINDING
 #include "GameClient/InGameUI.h"
 #include "GameClient/GameText.h"
@@ -1118,6 +1121,7 @@ void PathfindCellInfo::forceCleanPathFindCellInfos()
 	for (Int i = 0; i < CELL_INFOS_TO_ALLOCATE - 1; i++) {
 		s_infoArray[i].m_nextOpen = nullptr;
 		s_infoArray[i].m_prevOpen = nullptr;
+		s_infoArray[i].m_openIndex = -1;
 		s_infoArray[i].m_open = FALSE;
 		s_infoArray[i].m_closed = FALSE;
 	}
@@ -1207,6 +1211,8 @@ PathfindCellInfo *PathfindCellInfo::getACellInfo(PathfindCell *cell,const ICoord
 		info->m_pathParent = nullptr;
 		info->m_costSoFar = 0;
 		info->m_totalCost = 0;
+		info->m_openIndex = -1;
+		info->m_openOrder = 0;
 		info->m_open = 0;
 		info->m_closed = 0;
 		info->m_obstacleID = INVALID_ID;
@@ -1235,12 +1241,106 @@ void PathfindCellInfo::releaseACellInfo(PathfindCellInfo *theInfo)
 
 //-----------------------------------------------------------------------------------
 
-Bool PathfindCellList::canReverseSort(PathfindCell& currentCell) const
+Bool PathfindCellList::useHeap()
 {
-	if (m_head && m_tail)
-		return m_head->getTotalCostDifference(currentCell) > m_tail->getTotalCostDifference(currentCell);
+#if RETAIL_COMPATIBLE_PATHFINDING
+	return s_useFixedPathfinding;
+#else
+	return true;
+#endif
+}
 
-	return false;
+/**
+ * Return true if cell info a comes before b on the open list.
+ * Cells of equal cost are ordered first in, first out, like the insertion sorts did.
+ */
+Bool PathfindCellList::isHeapBefore(const PathfindCellInfo* a, const PathfindCellInfo* b)
+{
+	if (a->m_totalCost != b->m_totalCost)
+		return a->m_totalCost < b->m_totalCost;
+
+	return a->m_openOrder < b->m_openOrder;
+}
+
+void PathfindCellList::heapSet(Int index, PathfindCell* cell)
+{
+	m_heap[index] = cell;
+	cell->m_info->m_openIndex = index;
+}
+
+void PathfindCellList::heapSiftUp(Int index)
+{
+	PathfindCell* cell = m_heap[index];
+	while (index > 0) {
+		const Int parent = (index - 1) >> 1;
+		if (!isHeapBefore(cell->m_info, m_heap[parent]->m_info))
+			break;
+
+		heapSet(index, m_heap[parent]);
+		index = parent;
+	}
+	heapSet(index, cell);
+}
+
+void PathfindCellList::heapSiftDown(Int index)
+{
+	const Int count = (Int)m_heap.size();
+	PathfindCell* cell = m_heap[index];
+	for (;;) {
+		Int child = (index << 1) + 1;
+		if (child >= count)
+			break;
+
+		if (child + 1 < count && isHeapBefore(m_heap[child + 1]->m_info, m_heap[child]->m_info))
+			++child;
+
+		if (!isHeapBefore(m_heap[child]->m_info, cell->m_info))
+			break;
+
+		heapSet(index, m_heap[child]);
+		index = child;
+	}
+	heapSet(index, cell);
+}
+
+void PathfindCellList::heapPush(PathfindCell* cell)
+{
+	cell->m_info->m_openOrder = m_nextOpenOrder++;
+	m_heap.push_back(cell);
+	heapSiftUp((Int)m_heap.size() - 1);
+	m_head = m_heap[0];
+}
+
+/**
+ * Remove a cell from anywhere in the heap. The total cost of the cell may have changed already,
+ * so only the cell that takes its place is compared.
+ */
+void PathfindCellList::heapRemove(PathfindCell* cell)
+{
+	const Int index = cell->m_info->m_openIndex;
+	DEBUG_ASSERTCRASH(index >= 0 && index < (Int)m_heap.size() && m_heap[index] == cell, ("Cell is not on the open list heap."));
+
+	PathfindCell* last = m_heap.back();
+	m_heap.pop_back();
+	cell->m_info->m_openIndex = -1;
+
+	if (last != cell) {
+		heapSet(index, last);
+		heapSiftUp(index);
+		heapSiftDown(last->m_info->m_openIndex);
+	}
+
+	m_head = m_heap.empty() ? nullptr : m_heap[0];
+}
+
+PathfindCell* PathfindCellList::getNext(PathfindCell* cell) const
+{
+	if (!m_heap.empty()) {
+		const Int next = cell->m_info->m_openIndex + 1;
+		return next < (Int)m_heap.size() ? m_heap[next] : nullptr;
+	}
+
+	return cell->getNextOpen();
 }
 
 //-----------------------------------------------------------------------------------
@@ -1348,17 +1448,6 @@ inline void PathfindCell::setBlockedByAlly(Bool blocked)
 #endif
 }
 
-/**
- * Determine absolute total path cost difference between two cells.
- * Returns UINT_MAX if used with an uninitialised cell, so will be sorted as maximally dissimilar.
- */
-inline UnsignedInt PathfindCell::getTotalCostDifference(PathfindCell& other) const
-{
-	if (m_info && other.m_info)
-		return abs((Int)m_info->m_totalCost - (Int)other.m_info->m_totalCost);
-
-	return UINT_MAX;
-}
 
 /**
  * Set the parent pointer.
@@ -1756,55 +1845,16 @@ void PathfindCell::forwardInsertionSortRetailCompatible(PathfindCellList& list)
 }
 #endif
 
-// Forward insertion sort, returns early if the list is being initialized or we are prepending the list
-void PathfindCell::forwardInsertionSort(PathfindCellList& list)
+/// put self on "open" list in ascending cost order, return new list
+void PathfindCell::putOnSortedOpenList( PathfindCellList &list )
 {
-	DEBUG_ASSERTCRASH(m_info, ("Has to have info."));
-	DEBUG_ASSERTCRASH(m_info->m_closed == FALSE && m_info->m_open == FALSE, ("Serious error - Invalid flags. jba"));
-
-	// mark the new cell as being on the open list
-	m_info->m_open = true;
-	m_info->m_closed = false;
-
-	if (list.m_head == nullptr) {
-		m_info->m_prevOpen = nullptr;
-		m_info->m_nextOpen = nullptr;
-		list.m_head = this;
-		list.m_tail = this;
-		return;
-	}
-
-	// If the node needs inserting before the current list head
-	if (m_info->m_totalCost < list.m_head->m_info->m_totalCost) {
-		m_info->m_prevOpen = nullptr;
-		list.m_head->m_info->m_prevOpen = this->m_info;
-		m_info->m_nextOpen = list.m_head->m_info;
-		list.m_head = this;
+#if RETAIL_COMPATIBLE_PATHFINDING
+	if (!s_useFixedPathfinding) {
+		forwardInsertionSortRetailCompatible(list);
 		return;
 	}
+#endif
 
-	// Traverse the list to find correct position
-	PathfindCell* current = list.m_head;
-	while (current->m_info->m_nextOpen && current->m_info->m_nextOpen->m_totalCost <= m_info->m_totalCost) {
-		current = current->getNextOpen();
-	}
-
-	// Insert the new node in the correct position
-	m_info->m_nextOpen = current->m_info->m_nextOpen;
-	if (current->m_info->m_nextOpen != nullptr) {
-		current->m_info->m_nextOpen->m_prevOpen = this->m_info;
-	}
-	else {
-		list.m_tail = this;
-	}
-
-	current->m_info->m_nextOpen = this->m_info;
-	m_info->m_prevOpen = current->m_info;
-}
-
-// Reverse insertion sort, returns early if the list is being initialized or we are appending the list
-void PathfindCell::reverseInsertionSort(PathfindCellList& list)
-{
 	DEBUG_ASSERTCRASH(m_info, ("Has to have info."));
 	DEBUG_ASSERTCRASH(m_info->m_closed == FALSE && m_info->m_open == FALSE, ("Serious error - Invalid flags. jba"));
 
@@ -1812,61 +1862,7 @@ void PathfindCell::reverseInsertionSort(PathfindCellList& list)
 	m_info->m_open = true;
 	m_info->m_closed = false;
 
-	if (list.m_tail == nullptr) {
-		m_info->m_prevOpen = nullptr;
-		m_info->m_nextOpen = nullptr;
-		list.m_tail = this;
-		list.m_head = this;
-		return;
-	}
-
-	// If the node needs inserting after the current list tail
-	if (m_info->m_totalCost >= list.m_tail->m_info->m_totalCost) {
-		m_info->m_prevOpen = list.m_tail->m_info;
-		list.m_tail->m_info->m_nextOpen = this->m_info;
-		m_info->m_nextOpen = nullptr;
-		list.m_tail = this;
-		return;
-	}
-
-	// Traverse the list to find correct position
-	PathfindCell* current = list.m_tail;
-	while (current->m_info->m_prevOpen && current->m_info->m_prevOpen->m_totalCost > m_info->m_totalCost) {
-		current = current->getPrevOpen();
-	}
-
-	// Insert the new node in the correct position
-	m_info->m_prevOpen = current->m_info->m_prevOpen;
-	if (current->m_info->m_prevOpen != nullptr) {
-		current->m_info->m_prevOpen->m_nextOpen = this->m_info;
-	}
-	else {
-		list.m_head = this;
-	}
-
-	current->m_info->m_prevOpen = this->m_info;
-	m_info->m_nextOpen = current->m_info;
-}
-
-/// put self on "open" list in ascending cost order, return new list
-void PathfindCell::putOnSortedOpenList( PathfindCellList &list )
-{
-#if RETAIL_COMPATIBLE_PATHFINDING
-	if (!s_useFixedPathfinding) {
-		forwardInsertionSortRetailCompatible(list);
-		return;
-	}
-#endif
-
-	// TheSuperHackers @performance Mauller 20/03/2026 Implement reverse insertion sorting.
-	// Long and complex paths often append PathfindCell's, with high total path costs, to the open list.
-	// Appending and reverse traversal allow faster insertion of these cells, reducing pathfinding overhead by 50 - 66%.
-	if (list.canReverseSort(*this)) {
-		reverseInsertionSort(list);
-	}
-	else {
-		forwardInsertionSort(list);
-	}
+	list.heapPush(this);
 }
 
 /// remove self from "open" list
@@ -1874,11 +1870,14 @@ void PathfindCell::removeFromOpenList( PathfindCellList &list )
 {
 	DEBUG_ASSERTCRASH(m_info, ("Has to have info."));
 	DEBUG_ASSERTCRASH(m_info->m_closed==FALSE && m_info->m_open==TRUE, ("Serious error - Invalid flags. jba"));
+	if (PathfindCellList::useHeap()) {
+		list.heapRemove(this);
+		m_info->m_open = false;
+		return;
+	}
+
 	if (m_info->m_nextOpen)
 		m_info->m_nextOpen->m_prevOpen = m_info->m_prevOpen;
-	else {
-		list.m_tail = getPrevOpen();
-	}
 
 	if (m_info->m_prevOpen)
 		m_info->m_prevOpen->m_nextOpen = m_info->m_nextOpen;
@@ -1895,6 +1894,22 @@ void PathfindCell::removeFromOpenList( PathfindCellList &list )
 Int PathfindCell::releaseOpenList( PathfindCellList &list )
 {
 	Int count = 0;
+	if (PathfindCellList::useHeap()) {
+		for (size_t i = 0; i < list.m_heap.size(); ++i) {
+			count++;
+			PathfindCell *cur = list.m_heap[i];
+			PathfindCellInfo *curInfo = cur->m_info;
+			DEBUG_ASSERTCRASH(curInfo, ("Has to have info."));
+			DEBUG_ASSERTCRASH(curInfo->m_closed==FALSE && curInfo->m_open==TRUE, ("Serious error - Invalid flags. jba"));
+			DEBUG_ASSERTCRASH(cur == curInfo->m_cell, ("Bad backpointer in PathfindCellInfo"));
+			curInfo->m_openIndex = -1;
+			curInfo->m_open = FALSE;
+			cur->releaseInfo();
+		}
+		list.reset();
+		return count;
+	}
+
 	while (list.m_head) {
 		count++;
 		DEBUG_ASSERTCRASH(list.m_head->m_info, ("Has to have info."));
@@ -2247,6 +2262,55 @@ inline Bool groundCliff(const PathfindCell &targetCell, const PathfindCell &sour
 	return false;
 }
 
+/**
+ * Returns the zone equivalency arrays in which the zones of two adjacent cells are joined,
+ * the same way as PathfindZoneManager::calculateZones joins them.
+ */
+static UnsignedByte getZoneLinkEquivalencies(const PathfindCell &thisCell, const PathfindCell &otherCell)
+{
+	UnsignedByte equivalencies = 0;
+#if RTS_GENERALS && RETAIL_COMPATIBLE_PATHFINDING
+	if (thisCell.getType() == otherCell.getType()) {
+		equivalencies |= PathfindZoneLink::HIERARCHICAL;
+	}
+	if (waterGround(thisCell, otherCell)) {
+		equivalencies |= PathfindZoneLink::GROUND_WATER;
+	}
+	if (groundRubble(thisCell, otherCell)) {
+		equivalencies |= PathfindZoneLink::GROUND_RUBBLE;
+	}
+	if (groundCliff(thisCell, otherCell)) {
+		equivalencies |= PathfindZoneLink::GROUND_CLIFF;
+	}
+	if (terrain(thisCell, otherCell)) {
+		equivalencies |= PathfindZoneLink::TERRAIN;
+	}
+	if (crusherGround(thisCell, otherCell)) {
+		equivalencies |= PathfindZoneLink::CRUSHER;
+	}
+#else
+	if (thisCell.getType() == otherCell.getType()) {
+		equivalencies |= PathfindZoneLink::HIERARCHICAL;
+	} else {
+		if (terrain(thisCell, otherCell)) {
+			equivalencies |= PathfindZoneLink::TERRAIN;
+		}
+		if (crusherGround(thisCell, otherCell)) {
+			equivalencies |= PathfindZoneLink::CRUSHER;
+		}
+		if (equivalencies == 0) {
+			if (waterGround(thisCell, otherCell))
+				equivalencies |= PathfindZoneLink::GROUND_WATER;
+			else if (groundRubble(thisCell, otherCell))
+				equivalencies |= PathfindZoneLink::GROUND_RUBBLE;
+			else if (groundCliff(thisCell, otherCell))
+				equivalencies |= PathfindZoneLink::GROUND_CLIFF;
+		}
+	}
+#endif
+	return equivalencies;
+}
+
 static void __fastcall resolveBlockZones(Int srcZone, Int targetZone, zoneStorageType *zoneEquivalency, Int sizeOfZE)
 {
 	Int i;
@@ -2291,6 +2355,42 @@ static void __fastcall resolveZones(Int srcZone, Int targetZone, zoneStorageType
 	}
 }
 
+/**
+ * Union-find on a zone equivalency array. Every zone links to a lower zone of its set, so the
+ * root of a set is its lowest zone, just like with resolveZones.
+ */
+static Int findZoneRoot(zoneStorageType *zoneEquivalency, Int zone)
+{
+	while (zoneEquivalency[zone] != zone) {
+		zoneEquivalency[zone] = zoneEquivalency[zoneEquivalency[zone]];
+		zone = zoneEquivalency[zone];
+	}
+	return zone;
+}
+
+static void uniteZones(zoneStorageType *zoneEquivalency, Int zone1, Int zone2)
+{
+	Int root1 = findZoneRoot(zoneEquivalency, zone1);
+	Int root2 = findZoneRoot(zoneEquivalency, zone2);
+	if (root1 < root2) {
+		zoneEquivalency[root2] = root1;
+	} else if (root2 < root1) {
+		zoneEquivalency[root1] = root2;
+	}
+}
+
+/**
+ * Points every zone directly to the root of its set. As every zone links to a lower zone,
+ * a single pass in ascending order does it.
+ */
+static void compressZones(zoneStorageType *zoneEquivalency, Int sizeOfZE)
+{
+	Int i;
+	for (i=1; i<sizeOfZE; i++) {
+		zoneEquivalency[i] = zoneEquivalency[zoneEquivalency[i]];
+	}
+}
+
 static void flattenZones(zoneStorageType *zoneArray, zoneStorageType *zoneHierarchical, Int sizeOfZones)
 {
 	Int i;
@@ -2352,7 +2452,9 @@ m_groundWaterZones(nullptr),
 m_groundRubbleZones(nullptr),
 m_crusherZones(nullptr),
 m_zonesAllocated(0),
-m_interactsWithBridge(FALSE)
+m_interactsWithBridge(FALSE),
+m_version(0),
+m_reservedZones(0)
 {
 	m_cellOrigin.x = 0;
 	m_cellOrigin.y = 0;
@@ -2449,6 +2551,76 @@ void ZoneBlock::blockCalculateZones(PathfindCell **map, PathfindLayer layers[],
 
 }
 
+/* Collect the links of the zones of the cells in this block to the zones of their left and top
+neighbors, which may be in the neighboring blocks, and to the zones of the bridge layers. */
+void ZoneBlock::blockCalculateLinks(PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds, const IRegion2D &globalBounds)
+{
+	m_links.clear();
+	Int i, j;
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			const PathfindCell &cell = map[i][j];
+			if (i>globalBounds.lo.x && cell.getZone()!=map[i-1][j].getZone()) {
+				addLink(cell.getZone(), map[i-1][j].getZone(), getZoneLinkEquivalencies(cell, map[i-1][j]));
+			}
+			if (j>globalBounds.lo.y && cell.getZone()!=map[i][j-1].getZone()) {
+				addLink(cell.getZone(), map[i][j-1].getZone(), getZoneLinkEquivalencies(cell, map[i][j-1]));
+			}
+			if ( (cell.getConnectLayer() > LAYER_GROUND) && (cell.getType() == PathfindCell::CELL_CLEAR) ) {
+				addLink(cell.getZone(), layers[cell.getConnectLayer()].getZone(), PathfindZoneLink::HIERARCHICAL);
+			}
+		}
+	}
+}
+
+void ZoneBlock::addLink(zoneStorageType zone1, zoneStorageType zone2, UnsignedByte equivalencies)
+{
+	if (equivalencies == 0 || zone1 == zone2) {
+		return;
+	}
+	PathfindZoneLink link;
+	link.m_zone1 = min(zone1, zone2);
+	link.m_zone2 = max(zone1, zone2);
+	link.m_equivalencies = equivalencies;
+
+	// A block has few different links, so merge the duplicates right away.
+	PathfindZoneLinkVector::iterator it;
+	for (it = m_links.begin(); it != m_links.end(); ++it) {
+		if (it->m_zone1 == link.m_zone1 && it->m_zone2 == link.m_zone2) {
+			it->m_equivalencies |= link.m_equivalencies;
+			return;
+		}
+	}
+	m_links.push_back(link);
+}
+
+/* Move the zones of this block and the zones of its links to their new numbers. The zones of a block
+are consecutive, so they all move by the same amount. */
+void ZoneBlock::renumberZones(const zoneStorageType *newZones)
+{
+	Int delta = (Int)newZones[m_firstZone] - (Int)m_firstZone;
+	if (delta != 0) {
+		m_firstZone = newZones[m_firstZone];
+		if (m_groundCliffZones != nullptr) {
+			Int i;
+			for (i=0; i<m_zonesAllocated; i++) {
+				m_groundCliffZones[i] += delta;
+				m_groundWaterZones[i] += delta;
+				m_groundRubbleZones[i] += delta;
+				m_crusherZones[i] += delta;
+			}
+		}
+	}
+
+	PathfindZoneLinkVector::iterator it;
+	for (it = m_links.begin(); it != m_links.end(); ++it) {
+		zoneStorageType zone1 = newZones[it->m_zone1];
+		zoneStorageType zone2 = newZones[it->m_zone2];
+		it->m_zone1 = min(zone1, zone2);
+		it->m_zone2 = max(zone1, zone2);
+	}
+}
+
 //
 // Return the zone at this location.
 //
@@ -2546,6 +2718,9 @@ void ZoneBlock::allocateZones()
 //------------------------  PathfindZoneManager  -------------------------------
 PathfindZoneManager::PathfindZoneManager() : m_maxZone(0),
 m_nextFrameToCalculateZones(0),
+m_zoneVersion(0),
+m_equivalencyVersion(0),
+m_zoneLinksValid(FALSE),
 m_groundCliffZones(nullptr),
 m_groundWaterZones(nullptr),
 m_groundRubbleZones(nullptr),
@@ -2599,6 +2774,7 @@ void PathfindZoneManager::freeBlocks()
 
 	m_zoneBlockExtent.x = 0;
 	m_zoneBlockExtent.y = 0;
+	m_zoneLinksValid = FALSE;
 }
 
 /* Allocate zone equivalency arrays large enough to hold m_maxZone entries.  If the arrays are already
@@ -2799,6 +2975,9 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 
 	allocateZones();
 
+	// All zones are new, so the blocks share one new version.
+	++m_zoneVersion;
+	m_equivalencyVersion = m_zoneVersion;
 	for (xBlock=0; xBlock<xCount; xBlock++) {
 		for (yBlock=0; yBlock<yCount; yBlock++) {
 			IRegion2D bounds;
@@ -2819,6 +2998,7 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 			}
 #endif
 			m_zoneBlocks[xBlock][yBlock].blockCalculateZones(map, layers, bounds);
+			m_zoneBlocks[xBlock][yBlock].setVersion(m_zoneVersion);
 		}
 	}
 
@@ -3008,6 +3188,10 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 		}
 	}
 #endif
+	m_zoneLinksValid = FALSE;
+	if (TheGameLogic->hasPathfindOption(PATHFIND_OPTION_INCREMENTAL_ZONES)) {
+		calculateZoneLinks(map, layers, globalBounds);
+	}
 	m_nextFrameToCalculateZones = 0xffffffff;
 }
 
@@ -3037,6 +3221,7 @@ void PathfindZoneManager::updateZonesForModify(PathfindCell **map, PathfindLayer
 		bounds.hi.y = globalBounds.hi.y;
 	}
 
+	++m_zoneVersion;
 	Int xBlock, yBlock;
 	for (xBlock = 0; xBlock<m_zoneBlockExtent.x; xBlock++) {
 		for (yBlock=0; yBlock<m_zoneBlockExtent.y; yBlock++) {
@@ -3061,6 +3246,7 @@ void PathfindZoneManager::updateZonesForModify(PathfindCell **map, PathfindLayer
 				continue;
 			}
 			m_zoneBlocks[xBlock][yBlock].setInteractsWithBridge(false);
+			m_zoneBlocks[xBlock][yBlock].setVersion(m_zoneVersion);
 			Int i, j;
 			for( j=blockBounds.lo.y; j<=blockBounds.hi.y; j++ )	{
 				for( i=blockBounds.lo.x; i<=blockBounds.hi.x; i++ )	{
@@ -3152,71 +3338,391 @@ void PathfindZoneManager::updateZonesForModify(PathfindCell **map, PathfindLayer
 
 }
 
-//
-// Clear the passable flags.
-//
-void PathfindZoneManager::clearPassableFlags()
-{	Int blockX;
-	Int blockY;
-	for (blockX = 0; blockX<m_zoneBlockExtent.x; blockX++) {
-		for (blockY = 0; blockY<m_zoneBlockExtent.y; blockY++) {
-			m_zoneBlocks[blockX][blockY].setPassable(false);
-		}
+/**
+ * Returns the cell bounds of a zone block, clipped to the map. Bounds are inclusive.
+ */
+Bool PathfindZoneManager::getBlockBounds(Int xBlock, Int yBlock, const IRegion2D &globalBounds, IRegion2D &bounds) const
+{
+	bounds.lo.x = globalBounds.lo.x + xBlock*ZONE_BLOCK_SIZE;
+	bounds.lo.y = globalBounds.lo.y + yBlock*ZONE_BLOCK_SIZE;
+	bounds.hi.x = bounds.lo.x + ZONE_BLOCK_SIZE - 1;
+	bounds.hi.y = bounds.lo.y + ZONE_BLOCK_SIZE - 1;
+	if (bounds.hi.x > globalBounds.hi.x) {
+		bounds.hi.x = globalBounds.hi.x;
 	}
-}
-
-//
-// Set the passable flags.
-//
-void PathfindZoneManager::setAllPassable()
-{	Int blockX;
-	Int blockY;
-	for (blockX = 0; blockX<m_zoneBlockExtent.x; blockX++) {
-		for (blockY = 0; blockY<m_zoneBlockExtent.y; blockY++) {
-			m_zoneBlocks[blockX][blockY].setPassable(true);
-		}
+	if (bounds.hi.y > globalBounds.hi.y) {
+		bounds.hi.y = globalBounds.hi.y;
 	}
+	return bounds.lo.x<=bounds.hi.x && bounds.lo.y<=bounds.hi.y;
 }
 
-//
-// Set the passable flag for the block at this location.
-//
-void PathfindZoneManager::setPassable(Int cellX, Int cellY, Bool passable)
+/**
+ * Collects the zone links of all blocks after the zones of the whole map were calculated.
+ * Each block reserves the zones that calculateZones gave to it.
+ */
+void PathfindZoneManager::calculateZoneLinks(PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds)
 {
-	Int blockX = cellX/ZONE_BLOCK_SIZE;
-	Int blockY = cellY/ZONE_BLOCK_SIZE;
-
-	if (blockX<0 || blockX>=m_zoneBlockExtent.x) {
-		DEBUG_CRASH(("Invalid block."));
-		return;
-	}
-	if (blockY<0 || blockY>=m_zoneBlockExtent.y) {
-		DEBUG_CRASH(("Invalid block."));
-		return;
+	Int xBlock, yBlock;
+	for (xBlock=0; xBlock<m_zoneBlockExtent.x; xBlock++) {
+		for (yBlock=0; yBlock<m_zoneBlockExtent.y; yBlock++) {
+			IRegion2D bounds;
+			if (!getBlockBounds(xBlock, yBlock, globalBounds, bounds)) {
+				continue;
+			}
+			ZoneBlock &block = m_zoneBlocks[xBlock][yBlock];
+			block.setReservedZones(block.getNumZones());
+			block.blockCalculateLinks(map, layers, bounds, globalBounds);
+		}
 	}
-	m_zoneBlocks[blockX][blockY].setPassable(passable);
+	m_zoneLinksValid = TRUE;
 }
 
-//
-// Get the passable flag for the block at this location.
-//
-Bool PathfindZoneManager::isPassable(Int cellX, Int cellY) const
+/**
+ * TheSuperHackers @performance Recalculates the zones of the blocks that contain the changed cells,
+ * instead of the zones of the whole map. The cells of a block are joined into zones with a small
+ * union-find. If a block gets more zones than it has reserved, it reserves new zones above m_maxZone.
+ * The zones are then renumbered the way calculateZones numbers them, and the zone equivalency arrays
+ * are rebuilt with union-find from the zone links of the blocks, which is much less work than scanning
+ * the map. The whole map is only recalculated again when the zones run out, or if the links are not
+ * known yet.
+ */
+Bool PathfindZoneManager::repairZones(PathfindCell **map, PathfindLayer layers[], const IRegion2D &cellBounds, const IRegion2D &globalBounds)
 {
-	Int blockX = cellX/ZONE_BLOCK_SIZE;
-	Int blockY = cellY/ZONE_BLOCK_SIZE;
+	if (!m_zoneLinksValid || m_nextFrameToCalculateZones != 0xffffffff) {
+		// The zones of the whole map are not calculated yet, or will be calculated anyway.
+		markZonesDirty();
+		return false;
+	}
 
-	if (blockX<0 || blockX>=m_zoneBlockExtent.x) {
-		DEBUG_CRASH(("Invalid block."));
+	ICoord2D loBlock, hiBlock;
+	loBlock.x = max(0, (cellBounds.lo.x-globalBounds.lo.x)/ZONE_BLOCK_SIZE);
+	loBlock.y = max(0, (cellBounds.lo.y-globalBounds.lo.y)/ZONE_BLOCK_SIZE);
+	hiBlock.x = min(m_zoneBlockExtent.x-1, (cellBounds.hi.x-globalBounds.lo.x)/ZONE_BLOCK_SIZE);
+	hiBlock.y = min(m_zoneBlockExtent.y-1, (cellBounds.hi.y-globalBounds.lo.y)/ZONE_BLOCK_SIZE);
+	if (loBlock.x>hiBlock.x || loBlock.y>hiBlock.y) {
 		return false;
 	}
-	if (blockY<0 || blockY>=m_zoneBlockExtent.y) {
-		DEBUG_CRASH(("Invalid block."));
+
+	// Make sure that the new zones fit, even if every cell of the blocks becomes a zone of its own.
+	Int blockCount = (hiBlock.x-loBlock.x+1)*(hiBlock.y-loBlock.y+1);
+	if (m_maxZone + blockCount*ZONE_BLOCK_SIZE*ZONE_BLOCK_SIZE >= MAX_ZONES) {
+		markZonesDirty();
 		return false;
 	}
-	return m_zoneBlocks[blockX][blockY].isPassable();
-}
 
-//
+	++m_zoneVersion;
+	Int xBlock, yBlock;
+	for (xBlock=loBlock.x; xBlock<=hiBlock.x; xBlock++) {
+		for (yBlock=loBlock.y; yBlock<=hiBlock.y; yBlock++) {
+			IRegion2D bounds;
+			if (getBlockBounds(xBlock, yBlock, globalBounds, bounds)) {
+				repairBlockZones(map, layers, xBlock, yBlock, bounds);
+			}
+		}
+	}
+	Bool renumbered = renumberZones(map, layers, globalBounds);
+
+	// The blocks to the right and below link to the zones of the repaired blocks.
+	for (xBlock=loBlock.x; xBlock<=hiBlock.x+1 && xBlock<m_zoneBlockExtent.x; xBlock++) {
+		for (yBlock=loBlock.y; yBlock<=hiBlock.y+1 && yBlock<m_zoneBlockExtent.y; yBlock++) {
+			IRegion2D bounds;
+			if (getBlockBounds(xBlock, yBlock, globalBounds, bounds)) {
+				m_zoneBlocks[xBlock][yBlock].blockCalculateLinks(map, layers, bounds, globalBounds);
+			}
+		}
+	}
+
+	rebuildZoneEquivalencies();
+	applyBridges(layers);
+	return renumbered;
+}
+
+/**
+ * Joins the cells of a block into zones of the same type of terrain, like calculateZones.
+ */
+void PathfindZoneManager::repairBlockZones(PathfindCell **map, PathfindLayer layers[], Int xBlock, Int yBlock, const IRegion2D &bounds)
+{
+	enum {BLOCK_CELLS = ZONE_BLOCK_SIZE*ZONE_BLOCK_SIZE};
+	zoneStorageType labels[BLOCK_CELLS];
+	zoneStorageType equivalency[BLOCK_CELLS+1];
+	Int width = bounds.hi.x-bounds.lo.x+1;
+	Int numLabels = 0;
+	Int i, j;
+	equivalency[0] = 0;
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			Int ndx = (j-bounds.lo.y)*width + (i-bounds.lo.x);
+			Int label = 0;
+			if (i>bounds.lo.x && map[i][j].getType() == map[i-1][j].getType()) {
+				label = labels[ndx-1];
+			}
+			if (j>bounds.lo.y && map[i][j].getType() == map[i][j-1].getType()) {
+				if (label == 0) {
+					label = labels[ndx-width];
+				} else {
+					uniteZones(equivalency, label, labels[ndx-width]);
+				}
+			}
+			if (label == 0) {
+				numLabels++;
+				equivalency[numLabels] = numLabels;
+				label = numLabels;
+			}
+			labels[ndx] = label;
+		}
+	}
+
+	// Number the zones in the order of their first cell.
+	compressZones(equivalency, numLabels+1);
+	zoneStorageType zoneOffsets[BLOCK_CELLS+1];
+	Int numZones = 0;
+	for (i=1; i<=numLabels; i++) {
+		if (equivalency[i] == i) {
+			zoneOffsets[i] = numZones++;
+		} else {
+			zoneOffsets[i] = zoneOffsets[equivalency[i]];
+		}
+	}
+
+	ZoneBlock &block = m_zoneBlocks[xBlock][yBlock];
+	zoneStorageType firstZone = block.getFirstZone();
+	if (numZones > block.getReservedZones()) {
+		firstZone = m_maxZone;
+		m_maxZone += numZones;
+		block.setReservedZones(numZones);
+	}
+
+	block.setInteractsWithBridge(false);
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			Int ndx = (j-bounds.lo.y)*width + (i-bounds.lo.x);
+			map[i][j].setZone(firstZone + zoneOffsets[labels[ndx]]);
+			if (map[i][j].getConnectLayer() > LAYER_GROUND) {
+				block.setInteractsWithBridge(true);
+			}
+		}
+	}
+	block.blockCalculateZones(map, layers, bounds);
+	block.setVersion(m_zoneVersion);
+}
+
+/**
+ * TheSuperHackers @fix Gives the zones the numbers that calculateZones gives them, so that the zones
+ * do not depend on whether they were repaired or calculated for the whole map, for example after a
+ * save game was loaded. calculateZones numbers the zones of the blocks one block after another, in
+ * the order of their first cell, and the bridge layers after all the blocks. repairBlockZones already
+ * numbers the zones of a block in the order of their first cell, so the zones of each block only move
+ * by the same amount. Returns true if any zone was moved.
+ */
+Bool PathfindZoneManager::renumberZones(PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds)
+{
+	zoneStorageType newZones[MAX_ZONES];
+	memset(newZones, 0, sizeof(newZones));
+
+	Bool renumbered = false;
+	Int nextZone = 1;
+	Int xBlock, yBlock;
+	for (xBlock=0; xBlock<m_zoneBlockExtent.x; xBlock++) {
+		for (yBlock=0; yBlock<m_zoneBlockExtent.y; yBlock++) {
+			IRegion2D bounds;
+			if (!getBlockBounds(xBlock, yBlock, globalBounds, bounds)) {
+				continue;
+			}
+			const ZoneBlock &block = m_zoneBlocks[xBlock][yBlock];
+			Int i;
+			for (i=0; i<block.getNumZones(); i++) {
+				newZones[block.getFirstZone()+i] = nextZone+i;
+			}
+			if (block.getFirstZone() != nextZone) {
+				renumbered = true;
+			}
+			nextZone += block.getNumZones();
+		}
+	}
+
+	Int i;
+	for (i=0; i<=LAYER_LAST; i++) {
+		if (layers[i].getZone() != nextZone) {
+			renumbered = true;
+		}
+		newZones[layers[i].getZone()] = nextZone;
+		nextZone++;
+	}
+	if (!renumbered) {
+		m_maxZone = nextZone;
+		return false;
+	}
+
+	for (i=0; i<=LAYER_LAST; i++) {
+		if (layers[i].getZone() != newZones[layers[i].getZone()]) {
+			layers[i].setZone(newZones[layers[i].getZone()]);
+			layers[i].applyZone();
+		}
+	}
+
+	for (xBlock=0; xBlock<m_zoneBlockExtent.x; xBlock++) {
+		for (yBlock=0; yBlock<m_zoneBlockExtent.y; yBlock++) {
+			IRegion2D bounds;
+			if (!getBlockBounds(xBlock, yBlock, globalBounds, bounds)) {
+				continue;
+			}
+			ZoneBlock &block = m_zoneBlocks[xBlock][yBlock];
+			if (block.getFirstZone() != newZones[block.getFirstZone()]) {
+				Int j;
+				for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+					for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+						map[i][j].setZone(newZones[map[i][j].getZone()]);
+					}
+				}
+				block.setVersion(m_zoneVersion);
+			}
+			block.renumberZones(newZones);
+			block.setReservedZones(block.getNumZones());
+		}
+	}
+	m_maxZone = nextZone;
+	return true;
+}
+
+/**
+ * Rebuilds the zone equivalency arrays from the zone links of all blocks. Zones that are equivalent
+ * in the hierarchical array are equivalent in all the other arrays as well, see flattenZones.
+ */
+void PathfindZoneManager::rebuildZoneEquivalencies()
+{
+	allocateZones();
+	m_equivalencyVersion = m_zoneVersion;
+
+	Int i;
+	for (i=0; i<m_zonesAllocated; i++) {
+		m_groundCliffZones[i] = i;
+		m_groundWaterZones[i] = i;
+		m_groundRubbleZones[i] = i;
+		m_terrainZones[i] = i;
+		m_crusherZones[i] = i;
+		m_hierarchicalZones[i] = i;
+	}
+
+	Int xBlock, yBlock;
+	for (xBlock=0; xBlock<m_zoneBlockExtent.x; xBlock++) {
+		for (yBlock=0; yBlock<m_zoneBlockExtent.y; yBlock++) {
+			const PathfindZoneLinkVector &links = m_zoneBlocks[xBlock][yBlock].getLinks();
+			PathfindZoneLinkVector::const_iterator it;
+			for (it = links.begin(); it != links.end(); ++it) {
+				const Bool hierarchical = (it->m_equivalencies & PathfindZoneLink::HIERARCHICAL) != 0;
+				if (hierarchical) {
+					uniteZones(m_hierarchicalZones, it->m_zone1, it->m_zone2);
+				}
+				if (hierarchical || (it->m_equivalencies & PathfindZoneLink::GROUND_WATER)) {
+					uniteZones(m_groundWaterZones, it->m_zone1, it->m_zone2);
+				}
+				if (hierarchical || (it->m_equivalencies & PathfindZoneLink::GROUND_RUBBLE)) {
+					uniteZones(m_groundRubbleZones, it->m_zone1, it->m_zone2);
+				}
+				if (hierarchical || (it->m_equivalencies & PathfindZoneLink::GROUND_CLIFF)) {
+					uniteZones(m_groundCliffZones, it->m_zone1, it->m_zone2);
+				}
+				if (hierarchical || (it->m_equivalencies & PathfindZoneLink::TERRAIN)) {
+					uniteZones(m_terrainZones, it->m_zone1, it->m_zone2);
+				}
+				if (hierarchical || (it->m_equivalencies & PathfindZoneLink::CRUSHER)) {
+					uniteZones(m_crusherZones, it->m_zone1, it->m_zone2);
+				}
+			}
+		}
+	}
+
+	compressZones(m_groundCliffZones, m_maxZone);
+	compressZones(m_groundWaterZones, m_maxZone);
+	compressZones(m_groundRubbleZones, m_maxZone);
+	compressZones(m_terrainZones, m_maxZone);
+	compressZones(m_crusherZones, m_maxZone);
+	compressZones(m_hierarchicalZones, m_maxZone);
+}
+
+/**
+ * Marks the blocks at the ends of the intact bridges, like calculateZones.
+ */
+void PathfindZoneManager::applyBridges(PathfindLayer layers[])
+{
+	Int i;
+	for (i=0; i<=LAYER_LAST; i++) {
+		PathfindLayer &r_thisLayer = layers[i];
+		if (!r_thisLayer.isUnused() && !r_thisLayer.isDestroyed()) {
+			ICoord2D ndx;
+			r_thisLayer.getStartCellIndex(&ndx);
+			setBridge(ndx.x, ndx.y, true);
+			r_thisLayer.getEndCellIndex(&ndx);
+			setBridge(ndx.x, ndx.y, true);
+		}
+	}
+}
+
+//
+// Clear the passable flags.
+//
+void PathfindZoneManager::clearPassableFlags()
+{	Int blockX;
+	Int blockY;
+	for (blockX = 0; blockX<m_zoneBlockExtent.x; blockX++) {
+		for (blockY = 0; blockY<m_zoneBlockExtent.y; blockY++) {
+			m_zoneBlocks[blockX][blockY].setPassable(false);
+		}
+	}
+}
+
+//
+// Set the passable flags.
+//
+void PathfindZoneManager::setAllPassable()
+{	Int blockX;
+	Int blockY;
+	for (blockX = 0; blockX<m_zoneBlockExtent.x; blockX++) {
+		for (blockY = 0; blockY<m_zoneBlockExtent.y; blockY++) {
+			m_zoneBlocks[blockX][blockY].setPassable(true);
+		}
+	}
+}
+
+//
+// Set the passable flag for the block at this location.
+//
+void PathfindZoneManager::setPassable(Int cellX, Int cellY, Bool passable)
+{
+	Int blockX = cellX/ZONE_BLOCK_SIZE;
+	Int blockY = cellY/ZONE_BLOCK_SIZE;
+
+	if (blockX<0 || blockX>=m_zoneBlockExtent.x) {
+		DEBUG_CRASH(("Invalid block."));
+		return;
+	}
+	if (blockY<0 || blockY>=m_zoneBlockExtent.y) {
+		DEBUG_CRASH(("Invalid block."));
+		return;
+	}
+	m_zoneBlocks[blockX][blockY].setPassable(passable);
+}
+
+//
+// Get the passable flag for the block at this location.
+//
+Bool PathfindZoneManager::isPassable(Int cellX, Int cellY) const
+{
+	Int blockX = cellX/ZONE_BLOCK_SIZE;
+	Int blockY = cellY/ZONE_BLOCK_SIZE;
+
+	if (blockX<0 || blockX>=m_zoneBlockExtent.x) {
+		DEBUG_CRASH(("Invalid block."));
+		return false;
+	}
+	if (blockY<0 || blockY>=m_zoneBlockExtent.y) {
+		DEBUG_CRASH(("Invalid block."));
+		return false;
+	}
+	return m_zoneBlocks[blockX][blockY].isPassable();
+}
+
+//
 // Get the passable flag for the block at this location.
 //
 Bool PathfindZoneManager::clipIsPassable(Int cellX, Int cellY) const
@@ -3352,22 +3858,597 @@ zoneStorageType PathfindZoneManager::getEffectiveZone( LocomotorSurfaceTypeMask
 		return zone;
 	}
 
-	if ( (acceptableSurfaces&LOCOMOTORSURFACE_GROUND) &&
-			(acceptableSurfaces&LOCOMOTORSURFACE_RUBBLE)) {
-		// Locomotors can go on ground & rubble, so use the ground rubble combiner.
-		zone = m_groundRubbleZones[zone];
-		return zone;
+	if ( (acceptableSurfaces&LOCOMOTORSURFACE_GROUND) &&
+			(acceptableSurfaces&LOCOMOTORSURFACE_RUBBLE)) {
+		// Locomotors can go on ground & rubble, so use the ground rubble combiner.
+		zone = m_groundRubbleZones[zone];
+		return zone;
+	}
+
+	if ( (acceptableSurfaces&LOCOMOTORSURFACE_CLIFF) &&
+			(acceptableSurfaces&LOCOMOTORSURFACE_WATER)) {
+		// Locomotors can go on ground & cliff, so use the ground cliff combiner.
+		DEBUG_CRASH(("Cliff water only locomotor sets not supported yet."));
+	}
+	zone = m_hierarchicalZones[zone];
+
+	return zone;
+}
+//------------------------  PathfindPortalGraph  -------------------------------
+PathfindPortalGraph::PathfindPortalGraph() : m_surfaces(0),
+m_crusher(FALSE),
+m_initialized(FALSE),
+m_lastUse(0),
+m_searchID(0)
+{
+	m_blockExtent.x = 0;
+	m_blockExtent.y = 0;
+}
+
+void PathfindPortalGraph::reset()
+{
+	m_blocks.clear();
+	m_blockExtent.x = 0;
+	m_blockExtent.y = 0;
+	m_surfaces = 0;
+	m_crusher = FALSE;
+	m_initialized = FALSE;
+	m_lastUse = 0;
+	m_searchID = 0;
+}
+
+void PathfindPortalGraph::init(LocomotorSurfaceTypeMask surfaces, Bool crusher, const ICoord2D &blockExtent)
+{
+	reset();
+	m_surfaces = surfaces;
+	m_crusher = crusher;
+	m_blockExtent = blockExtent;
+	m_initialized = TRUE;
+
+	Block block;
+	block.m_version = 0;
+	block.m_built = FALSE;
+	m_blocks.resize(blockExtent.x*blockExtent.y, block);
+}
+
+Bool PathfindPortalGraph::isFor(LocomotorSurfaceTypeMask surfaces, Bool crusher, const ICoord2D &blockExtent) const
+{
+	return m_initialized && m_surfaces == surfaces && m_crusher == crusher &&
+		m_blockExtent.x == blockExtent.x && m_blockExtent.y == blockExtent.y;
+}
+
+UnsignedInt PathfindPortalGraph::beginSearch()
+{
+	++m_searchID;
+	if (m_searchID == 0) {
+		// The ids wrapped around, so forget the ids of the old searches.
+		for (size_t i = 0; i < m_blocks.size(); i++) {
+			PortalVector &portals = m_blocks[i].m_portals;
+			for (size_t j = 0; j < portals.size(); j++) {
+				portals[j].m_searchID = 0;
+			}
+		}
+		m_searchID = 1;
+	}
+	return m_searchID;
+}
+
+/* The portals on the sides of a block depend on the cells of the neighboring blocks as well. */
+Bool PathfindPortalGraph::isOutOfDate(const PathfindZoneManager &zoneManager, Int blockX, Int blockY) const
+{
+	const Block &block = m_blocks[blockX*m_blockExtent.y + blockY];
+	if (!block.m_built) {
+		return true;
+	}
+	// TheSuperHackers @fix The equivalencies decide which block zones can be crossed, and a repair can
+	// change them anywhere in the map.
+	if (zoneManager.getEquivalencyVersion() > block.m_version) {
+		return true;
+	}
+	if (zoneManager.getBlockVersion(blockX, blockY) > block.m_version) {
+		return true;
+	}
+	if (blockX > 0 && zoneManager.getBlockVersion(blockX-1, blockY) > block.m_version) {
+		return true;
+	}
+	if (blockX < m_blockExtent.x-1 && zoneManager.getBlockVersion(blockX+1, blockY) > block.m_version) {
+		return true;
+	}
+	if (blockY > 0 && zoneManager.getBlockVersion(blockX, blockY-1) > block.m_version) {
+		return true;
+	}
+	if (blockY < m_blockExtent.y-1 && zoneManager.getBlockVersion(blockX, blockY+1) > block.m_version) {
+		return true;
+	}
+	return false;
+}
+
+PathfindPortalGraph::PortalVector &PathfindPortalGraph::getPortals(const PathfindZoneManager &zoneManager, PathfindCell **map,
+	const IRegion2D &extent, Int blockX, Int blockY)
+{
+	if (isOutOfDate(zoneManager, blockX, blockY)) {
+		buildPortals(zoneManager, map, extent, blockX, blockY);
+	}
+	return m_blocks[blockX*m_blockExtent.y + blockY].m_portals;
+}
+
+void PathfindPortalGraph::buildPortals(const PathfindZoneManager &zoneManager, PathfindCell **map, const IRegion2D &extent,
+	Int blockX, Int blockY)
+{
+	Block &block = m_blocks[blockX*m_blockExtent.y + blockY];
+	block.m_portals.clear();
+
+	ICoord2D lo, hi;
+	lo.x = blockX*PathfindZoneManager::ZONE_BLOCK_SIZE;
+	lo.y = blockY*PathfindZoneManager::ZONE_BLOCK_SIZE;
+	hi.x = min(lo.x + PathfindZoneManager::ZONE_BLOCK_SIZE - 1, extent.hi.x);
+	hi.y = min(lo.y + PathfindZoneManager::ZONE_BLOCK_SIZE - 1, extent.hi.y);
+
+	ICoord2D first, step, delta;
+	// Left side.
+	if (blockX > 0) {
+		first = lo;
+		step.x = 0; step.y = 1;
+		delta.x = -1; delta.y = 0;
+		addSidePortals(zoneManager, map, block.m_portals, first, step, delta, hi.y-lo.y+1);
+	}
+	// Right side.
+	if (blockX < m_blockExtent.x-1) {
+		first.x = hi.x; first.y = lo.y;
+		step.x = 0; step.y = 1;
+		delta.x = 1; delta.y = 0;
+		addSidePortals(zoneManager, map, block.m_portals, first, step, delta, hi.y-lo.y+1);
+	}
+	// Top side.
+	if (blockY > 0) {
+		first = lo;
+		step.x = 1; step.y = 0;
+		delta.x = 0; delta.y = -1;
+		addSidePortals(zoneManager, map, block.m_portals, first, step, delta, hi.x-lo.x+1);
+	}
+	// Bottom side.
+	if (blockY < m_blockExtent.y-1) {
+		first.x = lo.x; first.y = hi.y;
+		step.x = 1; step.y = 0;
+		delta.x = 0; delta.y = 1;
+		addSidePortals(zoneManager, map, block.m_portals, first, step, delta, hi.x-lo.x+1);
+	}
+
+	block.m_version = zoneManager.getZoneVersion();
+	block.m_built = TRUE;
+}
+
+/* Adds one portal for every run of border cells that cross into the same pair of block zones. The portal
+takes the unpinched pair of cells closest to the middle of the run, like the scan of the border cells in
+Pathfinder::internal_findHierarchicalPath. */
+void PathfindPortalGraph::addSidePortals(const PathfindZoneManager &zoneManager, PathfindCell **map, PortalVector &portals,
+	const ICoord2D &first, const ICoord2D &step, const ICoord2D &delta, Int count)
+{
+	Int runStart = -1;
+	zoneStorageType runFromZone = PathfindZoneManager::UNINITIALIZED_ZONE;
+	zoneStorageType runToZone = PathfindZoneManager::UNINITIALIZED_ZONE;
+	Int i;
+	for (i=0; i<=count; i++) {
+		Bool crossable = false;
+		zoneStorageType fromZone = PathfindZoneManager::UNINITIALIZED_ZONE;
+		zoneStorageType toZone = PathfindZoneManager::UNINITIALIZED_ZONE;
+		if (i < count) {
+			Int x = first.x + i*step.x;
+			Int y = first.y + i*step.y;
+			fromZone = zoneManager.getBlockZone(m_surfaces, m_crusher, x, y, map);
+			toZone = zoneManager.getBlockZone(m_surfaces, m_crusher, x+delta.x, y+delta.y, map);
+			crossable = fromZone != PathfindZoneManager::UNINITIALIZED_ZONE && toZone != PathfindZoneManager::UNINITIALIZED_ZONE &&
+				zoneManager.getEffectiveZone(m_surfaces, m_crusher, fromZone) == zoneManager.getEffectiveZone(m_surfaces, m_crusher, toZone);
+		}
+
+		if (runStart >= 0 && (!crossable || fromZone != runFromZone || toZone != runToZone)) {
+			// The run ended, so add its portal.
+			const Int runCount = i - runStart;
+			Portal portal;
+			portal.m_fromZone = runFromZone;
+			portal.m_toZone = runToZone;
+			portal.m_pinched = true;
+			portal.m_searchID = 0;
+			Int j;
+			for (j=1; j<=runCount+1; j++) {
+				Int offset = j>>1;
+				if (j&1) offset = -offset;
+				Int k = runStart + runCount/2 + offset;
+				if (k < runStart || k >= i) {
+					continue;
+				}
+				ICoord2D from, to;
+				from.x = first.x + k*step.x;
+				from.y = first.y + k*step.y;
+				to.x = from.x + delta.x;
+				to.y = from.y + delta.y;
+				Bool pinched = map[from.x][from.y].getPinched() || map[to.x][to.y].getPinched();
+				if (j == 1 || (portal.m_pinched && !pinched)) {
+					portal.m_from = from;
+					portal.m_to = to;
+					portal.m_pinched = pinched;
+				}
+				if (!pinched) {
+					break;
+				}
+			}
+			portals.push_back(portal);
+			runStart = -1;
+		}
+
+		if (crossable && runStart < 0) {
+			runStart = i;
+			runFromZone = fromZone;
+			runToZone = toZone;
+		}
+	}
+}
+
+//------------------------  PathfindPathCache  -------------------------------
+Bool PathfindPathCache::Key::operator==(const Key &other) const
+{
+	return m_surfaces == other.m_surfaces && m_crusher == other.m_crusher && m_isHuman == other.m_isHuman &&
+		m_centerInCell == other.m_centerInCell && m_radius == other.m_radius &&
+		m_fromBlock.x == other.m_fromBlock.x && m_fromBlock.y == other.m_fromBlock.y &&
+		m_toBlock.x == other.m_toBlock.x && m_toBlock.y == other.m_toBlock.y &&
+		m_fromZone == other.m_fromZone && m_toZone == other.m_toZone;
+}
+
+PathfindPathCache::PathfindPathCache() : m_useCount(0),
+m_hits(0),
+m_misses(0)
+{
+	clear();
+}
+
+void PathfindPathCache::clear()
+{
+	Int i;
+	for (i=0; i<MAX_ENTRIES; i++) {
+		m_entries[i].m_nodes.clear();
+		m_entries[i].m_lastUse = 0;
+		m_entries[i].m_used = FALSE;
+	}
+}
+
+const PathfindPathCache::NodeVector *PathfindPathCache::find(const Key &key)
+{
+	Int i;
+	for (i=0; i<MAX_ENTRIES; i++) {
+		Entry &entry = m_entries[i];
+		if (entry.m_used && entry.m_key == key) {
+			entry.m_lastUse = ++m_useCount;
+			return &entry.m_nodes;
+		}
+	}
+	return nullptr;
+}
+
+void PathfindPathCache::add(const Key &key, Path *path)
+{
+	// Replace the same key, or else the entry that was used least recently.
+	Int slot = 0;
+	Int i;
+	for (i=0; i<MAX_ENTRIES; i++) {
+		if (m_entries[i].m_used && m_entries[i].m_key == key) {
+			slot = i;
+			break;
+		}
+		if (!m_entries[i].m_used) {
+			if (m_entries[slot].m_used) {
+				slot = i;
+			}
+		} else if (m_entries[slot].m_used && m_entries[i].m_lastUse < m_entries[slot].m_lastUse) {
+			slot = i;
+		}
+	}
+
+	Entry &entry = m_entries[slot];
+	entry.m_key = key;
+	entry.m_nodes.clear();
+	entry.m_bounds.lo.x = entry.m_bounds.lo.y = INT_MAX;
+	entry.m_bounds.hi.x = entry.m_bounds.hi.y = INT_MIN;
+	for (PathNode *pathNode = path->getFirstNode(); pathNode; pathNode = pathNode->getNext()) {
+		Node node;
+		node.m_pos = *pathNode->getPosition();
+		node.m_layer = pathNode->getLayer();
+		entry.m_nodes.push_back(node);
+
+		Int cellX = REAL_TO_INT_FLOOR(node.m_pos.x/PATHFIND_CELL_SIZE_F);
+		Int cellY = REAL_TO_INT_FLOOR(node.m_pos.y/PATHFIND_CELL_SIZE_F);
+		entry.m_bounds.lo.x = min(entry.m_bounds.lo.x, cellX);
+		entry.m_bounds.lo.y = min(entry.m_bounds.lo.y, cellY);
+		entry.m_bounds.hi.x = max(entry.m_bounds.hi.x, cellX);
+		entry.m_bounds.hi.y = max(entry.m_bounds.hi.y, cellY);
+	}
+	// The segments between the nodes stay within the bounds of the nodes, the unit needs its radius around them.
+	Int margin = key.m_radius + 1;
+	entry.m_bounds.lo.x -= margin;
+	entry.m_bounds.lo.y -= margin;
+	entry.m_bounds.hi.x += margin;
+	entry.m_bounds.hi.y += margin;
+	entry.m_lastUse = ++m_useCount;
+	entry.m_used = !entry.m_nodes.empty();
+}
+
+void PathfindPathCache::invalidate(const IRegion2D &cellBounds)
+{
+	Int i;
+	for (i=0; i<MAX_ENTRIES; i++) {
+		Entry &entry = m_entries[i];
+		if (!entry.m_used) {
+			continue;
+		}
+		if (entry.m_bounds.hi.x < cellBounds.lo.x || entry.m_bounds.lo.x > cellBounds.hi.x ||
+				entry.m_bounds.hi.y < cellBounds.lo.y || entry.m_bounds.lo.y > cellBounds.hi.y) {
+			continue;
+		}
+		entry.m_nodes.clear();
+		entry.m_used = FALSE;
+	}
+}
+
+void PathfindPathCache::xfer(Xfer *xfer)
+{
+	xfer->xferUnsignedInt(&m_useCount);
+	Int i;
+	for (i=0; i<MAX_ENTRIES; i++) {
+		Entry &entry = m_entries[i];
+		xfer->xferBool(&entry.m_used);
+		xfer->xferUnsignedInt(&entry.m_lastUse);
+		if (!entry.m_used) {
+			entry.m_nodes.clear();
+			continue;
+		}
+		xfer->xferInt(&entry.m_key.m_surfaces);
+		xfer->xferBool(&entry.m_key.m_crusher);
+		xfer->xferBool(&entry.m_key.m_isHuman);
+		xfer->xferBool(&entry.m_key.m_centerInCell);
+		xfer->xferInt(&entry.m_key.m_radius);
+		xfer->xferICoord2D(&entry.m_key.m_fromBlock);
+		xfer->xferICoord2D(&entry.m_key.m_toBlock);
+		xfer->xferUnsignedShort(&entry.m_key.m_fromZone);
+		xfer->xferUnsignedShort(&entry.m_key.m_toZone);
+		xfer->xferIRegion2D(&entry.m_bounds);
+
+		Int count = (Int)entry.m_nodes.size();
+		xfer->xferInt(&count);
+		entry.m_nodes.resize(count);
+		Int j;
+		for (j=0; j<count; j++) {
+			xfer->xferCoord3D(&entry.m_nodes[j].m_pos);
+			xfer->xferUser(&entry.m_nodes[j].m_layer, sizeof(PathfindLayerEnum));
+		}
+	}
+}
+
+//------------------------  PathfindFlowField  -------------------------------
+PathfindFlowField::PathfindFlowField() : m_requested(FALSE),
+m_computed(FALSE),
+m_frame(0),
+m_surfaces(0),
+m_crusher(FALSE),
+m_isHuman(FALSE)
+{
+	m_goal.x = m_goal.y = 0;
+	m_bounds.lo.x = m_bounds.lo.y = m_bounds.hi.x = m_bounds.hi.y = 0;
+}
+
+void PathfindFlowField::clear()
+{
+	m_requested = FALSE;
+	m_computed = FALSE;
+	m_members.clear();
+	m_costs.clear();
+	m_openList.clear();
+}
+
+void PathfindFlowField::request(const ICoord2D &goal, const IRegion2D &bounds, UnsignedInt frame, const ObjectIDVector &members)
+{
+	clear();
+	m_requested = TRUE;
+	m_goal = goal;
+	m_bounds = bounds;
+	m_frame = frame;
+	m_members = members;
+	std::sort(m_members.begin(), m_members.end());
+}
+
+void PathfindFlowField::reset(LocomotorSurfaceTypeMask surfaces, Bool crusher, Bool isHuman)
+{
+	m_surfaces = surfaces;
+	m_crusher = crusher;
+	m_isHuman = isHuman;
+	m_computed = TRUE;
+	const Int width = m_bounds.hi.x - m_bounds.lo.x + 1;
+	const Int height = m_bounds.hi.y - m_bounds.lo.y + 1;
+	m_costs.assign(width*height, (UnsignedInt)UNREACHED);
+	m_openList.clear();
+}
+
+void PathfindFlowField::invalidate(const IRegion2D &cellBounds)
+{
+	if (m_requested && cellBounds.lo.x <= m_bounds.hi.x && cellBounds.hi.x >= m_bounds.lo.x &&
+			cellBounds.lo.y <= m_bounds.hi.y && cellBounds.hi.y >= m_bounds.lo.y) {
+		clear();
+	}
+}
+
+void PathfindFlowField::xfer(Xfer *xfer)
+{
+	xfer->xferBool(&m_requested);
+	if (!m_requested) {
+		clear();
+		return;
+	}
+	xfer->xferICoord2D(&m_goal);
+	xfer->xferIRegion2D(&m_bounds);
+	xfer->xferUnsignedInt(&m_frame);
+	xfer->xferSTLObjectIDVector(&m_members);
+	xfer->xferBool(&m_computed);
+	xfer->xferInt(&m_surfaces);
+	xfer->xferBool(&m_crusher);
+	xfer->xferBool(&m_isHuman);
+
+	// The search finishes when the field is computed, so the open list is always empty here.
+	Int count = (Int)m_costs.size();
+	xfer->xferInt(&count);
+	m_costs.resize(count);
+	if (count > 0) {
+		xfer->xferUser(&m_costs[0], count*sizeof(UnsignedInt));
+	}
+	m_openList.clear();
+}
+
+Bool PathfindFlowField::matches(LocomotorSurfaceTypeMask surfaces, Bool crusher, Bool isHuman) const
+{
+	return m_computed && m_surfaces == surfaces && m_crusher == crusher && m_isHuman == isHuman;
+}
+
+Bool PathfindFlowField::isMember(ObjectID id) const
+{
+	return std::binary_search(m_members.begin(), m_members.end(), id);
+}
+
+Bool PathfindFlowField::isInBounds(Int x, Int y) const
+{
+	return x >= m_bounds.lo.x && x <= m_bounds.hi.x && y >= m_bounds.lo.y && y <= m_bounds.hi.y;
+}
+
+UnsignedInt PathfindFlowField::getCost(Int x, Int y) const
+{
+	if (!m_computed || !isInBounds(x, y)) {
+		return UNREACHED;
+	}
+	const Int height = m_bounds.hi.y - m_bounds.lo.y + 1;
+	return m_costs[(x - m_bounds.lo.x)*height + (y - m_bounds.lo.y)];
+}
+
+void PathfindFlowField::setCost(Int x, Int y, UnsignedInt cost)
+{
+	const Int height = m_bounds.hi.y - m_bounds.lo.y + 1;
+	m_costs[(x - m_bounds.lo.x)*height + (y - m_bounds.lo.y)] = cost;
+}
+
+static Bool isOpenCellBefore(const PathfindFlowField::OpenCell &a, const PathfindFlowField::OpenCell &b)
+{
+	if (a.m_cost != b.m_cost) {
+		return a.m_cost < b.m_cost;
+	}
+	if (a.m_x != b.m_x) {
+		return a.m_x < b.m_x;
+	}
+	return a.m_y < b.m_y;
+}
+
+void PathfindFlowField::pushOpenCell(const OpenCell &cell)
+{
+	Int i = (Int)m_openList.size();
+	m_openList.push_back(cell);
+	while (i > 0) {
+		Int parent = (i-1)>>1;
+		if (!isOpenCellBefore(cell, m_openList[parent])) {
+			break;
+		}
+		m_openList[i] = m_openList[parent];
+		i = parent;
+	}
+	m_openList[i] = cell;
+}
+
+Bool PathfindFlowField::popOpenCell(OpenCell &cell)
+{
+	if (m_openList.empty()) {
+		return false;
+	}
+	cell = m_openList[0];
+	OpenCell last = m_openList.back();
+	m_openList.pop_back();
+	Int count = (Int)m_openList.size();
+	if (count == 0) {
+		return true;
+	}
+	Int i = 0;
+	for (;;) {
+		Int child = 2*i+1;
+		if (child >= count) {
+			break;
+		}
+		if (child+1 < count && isOpenCellBefore(m_openList[child+1], m_openList[child])) {
+			child++;
+		}
+		if (!isOpenCellBefore(m_openList[child], last)) {
+			break;
+		}
+		m_openList[i] = m_openList[child];
+		i = child;
+	}
+	m_openList[i] = last;
+	return true;
+}
+
+//------------------------  PathfindLineOfSightCache  -------------------------------
+Bool PathfindLineOfSightCache::Key::operator==(const Key &other) const
+{
+	return m_from.x == other.m_from.x && m_from.y == other.m_from.y &&
+		m_to.x == other.m_to.x && m_to.y == other.m_to.y &&
+		m_layer == other.m_layer && m_victimLayer == other.m_victimLayer && m_skipCount == other.m_skipCount &&
+		m_attacker == other.m_attacker && m_attackerContainer == other.m_attackerContainer &&
+		m_attackerSlaver == other.m_attackerSlaver && m_victim == other.m_victim && m_victimSlaver == other.m_victimSlaver;
+}
+
+static UnsignedInt hashReal(Real value)
+{
+	UnsignedInt bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+UnsignedInt PathfindLineOfSightCache::Key::hash() const
+{
+	UnsignedInt h = hashReal(m_from.x);
+	h = h*31 + hashReal(m_from.y);
+	h = h*31 + hashReal(m_to.x);
+	h = h*31 + hashReal(m_to.y);
+	h = h*31 + (UnsignedInt)m_attacker;
+	h = h*31 + (UnsignedInt)m_victim;
+	return h ^ (h >> 16);
+}
+
+PathfindLineOfSightCache::PathfindLineOfSightCache() : m_hits(0),
+m_misses(0)
+{
+	clear();
+}
+
+void PathfindLineOfSightCache::clear()
+{
+	Int i;
+	for (i=0; i<MAX_ENTRIES; i++) {
+		m_entries[i].m_used = FALSE;
 	}
+}
 
-	if ( (acceptableSurfaces&LOCOMOTORSURFACE_CLIFF) &&
-			(acceptableSurfaces&LOCOMOTORSURFACE_WATER)) {
-		// Locomotors can go on ground & cliff, so use the ground cliff combiner.
-		DEBUG_CRASH(("Cliff water only locomotor sets not supported yet."));
+Bool PathfindLineOfSightCache::find(const Key &key, Bool &blocked)
+{
+	const Entry &entry = m_entries[key.hash() & (MAX_ENTRIES-1)];
+	if (entry.m_used && entry.m_key == key) {
+		blocked = entry.m_blocked;
+		++m_hits;
+		return true;
 	}
-	zone = m_hierarchicalZones[zone];
+	++m_misses;
+	return false;
+}
 
-	return zone;
+void PathfindLineOfSightCache::add(const Key &key, Bool blocked)
+{
+	Entry &entry = m_entries[key.hash() & (MAX_ENTRIES-1)];
+	entry.m_key = key;
+	entry.m_blocked = blocked;
+	entry.m_used = TRUE;
 }
+
 //-------------------- PathfindLayer ----------------------------------------
 PathfindLayer::PathfindLayer() : m_blockOfMapCells(nullptr), m_layerCells(nullptr), m_bridge(nullptr),
 m_destroyed(FALSE),
@@ -4026,7 +5107,7 @@ void PathfindLayer::classifyWallMapCell( Int i, Int j , PathfindCell *cell, Obje
 
 //----------------------- Pathfinder ---------------------------------------
 
-Pathfinder::Pathfinder() :m_map(nullptr)
+Pathfinder::Pathfinder() :m_map(nullptr), m_groundCellFlags(nullptr)
 {
 	debugPath = nullptr;
 	PathfindCellInfo::allocateCellInfos();
@@ -4049,11 +5130,24 @@ void Pathfinder::reset()
 	delete [] m_map;
 	m_map = nullptr;
 
+	delete [] m_groundCellFlags;
+	m_groundCellFlags = nullptr;
+
 	Int i;
 	for (i=0; i<=LAYER_LAST; i++) {
 		m_layers[i].reset();
 	}
 
+	for (i=0; i<MAX_PORTAL_GRAPHS; i++) {
+		m_portalGraphs[i].reset();
+	}
+	m_portalGraphUseCount = 0;
+	m_portalNodes.clear();
+	m_portalOpenList.clear();
+	m_pathCache.clear();
+	m_flowField.clear();
+	m_lineOfSightCache.clear();
+
 	// reset the pathfind grid
 	m_extent.lo.x=m_extent.lo.y=m_extent.hi.x=m_extent.hi.y=0;
 	m_logicalExtent.lo.x=m_logicalExtent.lo.y=m_logicalExtent.hi.x=m_logicalExtent.hi.y=0;
@@ -4310,9 +5404,23 @@ void Pathfinder::classifyFence( Object *obj, Bool insert )
  	}
 #if !(RTS_GENERALS && RETAIL_COMPATIBLE_PATHFINDING)
 	if (didAnything) {
-		m_zoneManager.markZonesDirty();
 		m_zoneManager.updateZonesForModify(m_map, m_layers, cellBounds, m_extent);
+		if (TheGameLogic->hasPathfindOption(PATHFIND_OPTION_INCREMENTAL_ZONES)) {
+			if (m_zoneManager.repairZones(m_map, m_layers, cellBounds, m_extent)) {
+				// The cached paths are keyed by the old zones.
+				m_pathCache.clear();
+			}
+		} else {
+			m_zoneManager.markZonesDirty();
+		}
+		m_pathCache.invalidate(cellBounds);
+		m_flowField.invalidate(cellBounds);
+		m_lineOfSightCache.clear();
 	}
+#else
+	m_pathCache.clear();
+	m_flowField.clear();
+	m_lineOfSightCache.clear();
 #endif
 }
 
@@ -4425,7 +5533,9 @@ void Pathfinder::internal_classifyObjectFootprint( Object *obj, Bool insert )
 	{
 		case GEOMETRY_BOX:
 		{
-			m_zoneManager.markZonesDirty();
+			if (!TheGameLogic->hasPathfindOption(PATHFIND_OPTION_INCREMENTAL_ZONES)) {
+				m_zoneManager.markZonesDirty();
+			}
 			Real angle = obj->getOrientation();
 
 			Real halfsizeX = obj->getGeometryInfo().getMajorRadius();
@@ -4497,7 +5607,9 @@ void Pathfinder::internal_classifyObjectFootprint( Object *obj, Bool insert )
 		case GEOMETRY_SPHERE:	// not quite right, but close enough
 		case GEOMETRY_CYLINDER:
 		{
-			m_zoneManager.markZonesDirty();
+			if (!TheGameLogic->hasPathfindOption(PATHFIND_OPTION_INCREMENTAL_ZONES)) {
+				m_zoneManager.markZonesDirty();
+			}
 			// fill in all cells that overlap as obstacle cells
 			/// @todo This is a very inefficient circle-rasterizer
 			ICoord2D topLeft, bottomRight;
@@ -4602,6 +5714,10 @@ void Pathfinder::internal_classifyObjectFootprint( Object *obj, Bool insert )
 		cellBounds.hi.y = m_extent.hi.y;
 	}
 
+	m_pathCache.invalidate(cellBounds);
+	m_flowField.invalidate(cellBounds);
+	m_lineOfSightCache.clear();
+
 	if (!insert) {
 		for( j=cellBounds.lo.y; j<=cellBounds.hi.y; j++ )
 		{
@@ -4686,6 +5802,14 @@ void Pathfinder::internal_classifyObjectFootprint( Object *obj, Bool insert )
 			}
 		}
 	}
+
+	// TheSuperHackers @performance Repair the zones around the changed cells right away.
+	if (TheGameLogic->hasPathfindOption(PATHFIND_OPTION_INCREMENTAL_ZONES)) {
+		if (m_zoneManager.repairZones(m_map, m_layers, cellBounds, m_extent)) {
+			// The cached paths are keyed by the old zones.
+			m_pathCache.clear();
+		}
+	}
 }
 
 /**
@@ -4764,6 +5888,8 @@ void Pathfinder::newMap()
 		for (i=0; i<=bounds.hi.x; i++) {
 			m_map[i] = &m_blockOfMapCells[i*(bounds.hi.y+1)];
 		}
+		m_groundCellFlags = MSGNEW("PathfindMapCells") UnsignedByte[(bounds.hi.x+1)*(bounds.hi.y+1)];
+		memset(m_groundCellFlags, PathfindCell::NO_UNITS, (bounds.hi.x+1)*(bounds.hi.y+1));
 		for (i=0; i<LAYER_LAST; i++) {
 			if (!m_layers[i].isUnused()) {
 				m_layers[i].allocateCells(&m_extent);
@@ -4774,6 +5900,9 @@ void Pathfinder::newMap()
 			m_layers[LAYER_WALL].allocateCellsForWallLayer(&m_extent, m_wallPieces, m_numWallPieces);
 		}
 	}
+	m_pathCache.clear();
+	m_flowField.clear();
+	m_lineOfSightCache.clear();
 	classifyMap();
 	// Add existing objects.
 	Object *obj;
@@ -4790,6 +5919,7 @@ void Pathfinder::newMap()
  */
 void Pathfinder::classifyMap()
 {
+	m_lineOfSightCache.clear();
 
 	Int i, j;
 	// for now, sample cell corners and classify cell accordingly
@@ -4893,7 +6023,7 @@ void Pathfinder::debugShowSearch(  Bool pathFound  )
 		addIcon(nullptr, 0, 0, color);	 // erase.
 	}
 
-	for( s = m_openList.getHead(); s; s=s->getNextOpen() )
+	for( s = m_openList.getHead(); s; s=m_openList.getNext(s) )
 	{
 		// create objects to show path - they decay
 		RGBColor color;
@@ -5171,10 +6301,27 @@ Bool Pathfinder::checkForMovement(const Object *obj, TCheckMovementInfo &info)
 
 	Int numCellsAbove = info.radius;
 	if (info.centerInCell) numCellsAbove++;
+
+	// TheSuperHackers @performance If all cells are ground cells on the map, look up their flags in
+	// m_groundCellFlags first, and only look at the cells that have units. A single cell was just
+	// looked at by the caller, so it is checked directly.
+	const UnsignedByte *groundFlags = nullptr;
+	const Int groundColumnSize = m_extent.hi.y+1;
+	if (info.radius > 0 && !(info.layer > LAYER_GROUND && info.layer <= LAYER_LAST) &&
+		info.cell.x-info.radius >= m_extent.lo.x && info.cell.x+numCellsAbove-1 <= m_extent.hi.x &&
+		info.cell.y-info.radius >= m_extent.lo.y && info.cell.y+numCellsAbove-1 <= m_extent.hi.y) {
+		groundFlags = m_groundCellFlags;
+	}
+
 	Int i, j;
 //	Bool isInfantry = obj->isKindOf(KINDOF_INFANTRY);
 	for (i=info.cell.x-info.radius; i<info.cell.x+numCellsAbove; i++) {
 		for (j=info.cell.y-info.radius; j<info.cell.y+numCellsAbove; j++) {
+			if (groundFlags && groundFlags[i*groundColumnSize + j] == PathfindCell::NO_UNITS) {
+				DEBUG_ASSERTCRASH(m_map[i][j].getFlags() == PathfindCell::NO_UNITS, ("Ground cell flags are out of date."));
+				continue;  // Nobody is here, so it's ok.
+			}
+
 			PathfindCell	*cell = getCell(info.layer,i, j);
 			if (!cell) {
 				return false; // off the map, so can't move here.
@@ -6060,6 +7207,8 @@ void Pathfinder::processPathfindQueue()
 
 	if (m_zoneManager.needToCalculateZones()) {
 		m_zoneManager.calculateZones(m_map, m_layers, m_extent);
+		m_pathCache.clear();
+		m_flowField.clear();
 		return;
 	}
 
@@ -6076,6 +7225,7 @@ void Pathfinder::processPathfindQueue()
 	m_logicalExtent = bounds;
 
 	m_cumulativeCellsAllocated = 0;	// Number of pathfind cells examined.
+	m_pathCache.resetCounters();
 	Int pathsFound = 0;
 	while (m_cumulativeCellsAllocated < PATHFIND_CELLS_PER_FRAME &&
 		m_queuePRTail!=m_queuePRHead) {
@@ -6096,7 +7246,11 @@ void Pathfinder::processPathfindQueue()
 	if (pathsFound > 0) {
 		PROFILER_PLOT("PathfindCells", (double)m_cumulativeCellsAllocated);
 		PROFILER_PLOT("PathfindPaths", (double)pathsFound);
+		PROFILER_PLOT("PathfindCacheHits", (double)m_pathCache.getHits());
+		PROFILER_PLOT("PathfindCacheMisses", (double)m_pathCache.getMisses());
 	}
+	PROFILER_PLOT("AttackLineOfSightCacheHits", (double)m_lineOfSightCache.getHits());
+	PROFILER_PLOT("AttackLineOfSightCacheMisses", (double)m_lineOfSightCache.getMisses());
 #ifdef DEBUG_QPF
 	if (pathsFound>0) {
 #ifdef DEBUG_LOGGING
@@ -6419,82 +7573,502 @@ Int Pathfinder::examineNeighboringCells(PathfindCell *parentCell, PathfindCell *
 				toPos.y = newCellCoord.y * PATHFIND_CELL_SIZE_F ;
 				toPos.z = TheTerrainLogic->getGroundHeight(toPos.x , toPos.y);
 
-				if ( fabs(fromPos.z - toPos.z)<PATHFIND_CELL_SIZE_F) {
-					newCostSoFar += 7*COST_DIAGONAL;
-				}
-			} else if (newCell->getPinched()) {
-				newCostSoFar += COST_ORTHOGONAL;
-			}
+				if ( fabs(fromPos.z - toPos.z)<PATHFIND_CELL_SIZE_F) {
+					newCostSoFar += 7*COST_DIAGONAL;
+				}
+			} else if (newCell->getPinched()) {
+				newCostSoFar += COST_ORTHOGONAL;
+			}
+
+			newCell->setBlockedByAlly(false);
+			if (info.allyFixedCount>0) {
+#if RTS_GENERALS && RETAIL_COMPATIBLE_PATHFINDING
+				newCostSoFar += 3*COST_DIAGONAL*info.allyFixedCount;
+#else
+				newCostSoFar += 3*COST_DIAGONAL;
+#endif
+				if (!canPathThroughUnits)
+					newCell->setBlockedByAlly(true);
+			}
+
+			Int costRemaining = 0;
+			if (goalCell) {
+				if (attackDistance == NO_ATTACK)  {
+					costRemaining = newCell->costToGoal( goalCell );
+				}	else {
+					dx = newCellCoord.x - goalCell->getXIndex();
+					dy = newCellCoord.y - goalCell->getYIndex();
+					costRemaining = COST_ORTHOGONAL*sqrt(dx*dx + dy*dy);
+					costRemaining -= attackDistance/2;
+					if (costRemaining<0)
+						costRemaining=0;
+					if (info.allyGoal) {
+						if (obj->isKindOf(KINDOF_VEHICLE)) {
+							newCostSoFar += 3*COST_ORTHOGONAL;
+						}	else {
+							// Infantry can pass through infantry.
+							newCostSoFar += COST_ORTHOGONAL;
+						}
+					}
+				}
+			}
+
+			if (notZonePassable) {
+				newCostSoFar += 100*COST_ORTHOGONAL;
+			}
+
+			if (newCell->getType()==PathfindCell::CELL_OBSTACLE) {
+				newCostSoFar += 100*COST_ORTHOGONAL;
+			}
+
+			if (m_isTunneling) {
+				if (!validMovementPosition( isCrusher, locomotorSet.getValidSurfaces(), newCell, parentCell )) {
+					newCostSoFar += 10*COST_ORTHOGONAL;
+				}
+			}
+
+			newCell->setCostSoFar(newCostSoFar);
+			// keep track of path we're building - point back to cell we moved here from
+			newCell->setParentCell(parentCell) ;
+			if (m_isTunneling) {
+				costRemaining = 0; // find the closest valid cell.
+			}
+			newCell->setTotalCost(newCell->getCostSoFar() + costRemaining) ;
+
+			// if newCell was on closed list, remove it from the list
+			if (newCell->getClosed())
+				newCell->removeFromClosedList( m_closedList );
+
+			// if the newCell was already on the open list, remove it so it can be re-inserted in order
+			if (newCell->getOpen())
+				newCell->removeFromOpenList( m_openList );
+
+			// insert newCell in open list such that open list is sorted, smallest total path cost first
+			newCell->putOnSortedOpenList( m_openList );
+		}
+	return cellCount;
+}
+
+
+/**
+ * Fills the key of the path cache for a path of the object from its position to the destination.
+ * Returns false if the path must not be looked up in the cache or added to it.
+ */
+Bool Pathfinder::getPathCacheKey(const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from,
+																 const Coord3D *to, PathfindPathCache::Key &key)
+{
+	if (!TheGameLogic->hasPathfindOption(PATHFIND_OPTION_PATH_CACHE) || !m_isMapReady) {
+		return false;
+	}
+	// Only ground paths that start at the object, as patchPath starts from the position of the object.
+	if (obj == nullptr || obj->getAIUpdateInterface() == nullptr || obj->getLayer() != LAYER_GROUND) {
+		return false;
+	}
+	if (from->x != obj->getPosition()->x || from->y != obj->getPosition()->y) {
+		return false;
+	}
+	if (TheTerrainLogic->getLayerForDestination(to) != LAYER_GROUND) {
+		return false;
+	}
+
+	Bool centerInCell;
+	Int radius;
+	getRadiusAndCenter(obj, radius, centerInCell);
+	Coord3D adjustTo = *to;
+	if (!centerInCell) {
+		adjustTo.x += PATHFIND_CELL_SIZE_F/2;
+		adjustTo.y += PATHFIND_CELL_SIZE_F/2;
+	}
+
+	ICoord2D fromCell, toCell;
+	worldToCell(from, &fromCell);
+	worldToCell(&adjustTo, &toCell);
+	if (getCell(LAYER_GROUND, fromCell.x, fromCell.y) == nullptr || getCell(LAYER_GROUND, toCell.x, toCell.y) == nullptr) {
+		return false;
+	}
+
+	key.m_fromBlock.x = fromCell.x/PathfindZoneManager::ZONE_BLOCK_SIZE;
+	key.m_fromBlock.y = fromCell.y/PathfindZoneManager::ZONE_BLOCK_SIZE;
+	key.m_toBlock.x = toCell.x/PathfindZoneManager::ZONE_BLOCK_SIZE;
+	key.m_toBlock.y = toCell.y/PathfindZoneManager::ZONE_BLOCK_SIZE;
+	// Paths within a single block are cheap to find anyway.
+	if (key.m_fromBlock.x == key.m_toBlock.x && key.m_fromBlock.y == key.m_toBlock.y) {
+		return false;
+	}
+
+	Bool isHuman = true;
+	if (obj->getControllingPlayer() && (obj->getControllingPlayer()->getPlayerType()==PLAYER_COMPUTER)) {
+		isHuman = false; // computer gets to cheat.
+	}
+
+	key.m_surfaces = locomotorSet.getValidSurfaces();
+	key.m_crusher = obj->getCrusherLevel() > 0;
+	key.m_isHuman = isHuman;
+	key.m_centerInCell = centerInCell;
+	key.m_radius = radius;
+	key.m_fromZone = m_zoneManager.getBlockZone(key.m_surfaces, key.m_crusher, fromCell.x, fromCell.y, m_map);
+	key.m_toZone = m_zoneManager.getBlockZone(key.m_surfaces, key.m_crusher, toCell.x, toCell.y, m_map);
+	return true;
+}
+
+/**
+ * Builds a path from a recent path between the same zone blocks. The recent path is cut off where it
+ * enters the block of the destination and continues to the destination in a straight line.
+ * patchPath then finds the way from the position of the object onto that path.
+ */
+Path *Pathfinder::findCachedPath(Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from,
+																 const Coord3D *to)
+{
+	PathfindPathCache::Key key;
+	if (!getPathCacheKey(obj, locomotorSet, from, to, key)) {
+		return nullptr;
+	}
+	const PathfindPathCache::NodeVector *nodes = m_pathCache.find(key);
+	if (nodes == nullptr) {
+		m_pathCache.countMiss();
+		return nullptr;
+	}
+
+	Coord3D goalPos = *to;
+	if (!key.m_centerInCell) {
+		goalPos.x += PATHFIND_CELL_SIZE_F/2;
+		goalPos.y += PATHFIND_CELL_SIZE_F/2;
+	}
+	ICoord2D goalCell;
+	worldToCell(&goalPos, &goalCell);
+	if (!checkDestination(obj, goalCell.x, goalCell.y, LAYER_GROUND, key.m_radius, key.m_centerInCell)) {
+		m_pathCache.countMiss();
+		return nullptr;
+	}
+	adjustCoordToCell(goalCell.x, goalCell.y, key.m_centerInCell, goalPos, LAYER_GROUND);
+
+	Path *cachedPath = newInstance(Path);
+	Coord3D lastPos;
+	Bool hasNode = false;
+	size_t i;
+	for (i=0; i<nodes->size(); i++) {
+		const PathfindPathCache::Node &node = (*nodes)[i];
+		ICoord2D cell;
+		worldToCell(&node.m_pos, &cell);
+		if (cell.x/PathfindZoneManager::ZONE_BLOCK_SIZE == key.m_toBlock.x &&
+				cell.y/PathfindZoneManager::ZONE_BLOCK_SIZE == key.m_toBlock.y) {
+			break;
+		}
+		cachedPath->appendNode(&node.m_pos, node.m_layer);
+		lastPos = node.m_pos;
+		hasNode = true;
+	}
+
+	Path *path = nullptr;
+	if (hasNode && isLinePassable(obj, key.m_surfaces, LAYER_GROUND, lastPos, goalPos, false, false)) {
+		cachedPath->appendNode(&goalPos, LAYER_GROUND);
+		path = patchPath(obj, locomotorSet, cachedPath, false);
+	}
+	deleteInstance(cachedPath);
+
+	if (path) {
+		m_pathCache.countHit();
+	} else {
+		m_pathCache.countMiss();
+	}
+	return path;
+}
+
+/**
+ * Remembers a path that was found for the object, so that the next objects that move between
+ * the same zone blocks can follow it.
+ */
+void Pathfinder::addCachedPath(const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from,
+																const Coord3D *to, Path *path)
+{
+	PathfindPathCache::Key key;
+	if (path && getPathCacheKey(obj, locomotorSet, from, to, key)) {
+		m_pathCache.add(key, path);
+	}
+}
+
+// Frames after a group move in which its members follow the flow field.
+static const UnsignedInt FLOW_FIELD_LIFETIME = 5*LOGICFRAMES_PER_SECOND;
+// Zone blocks around the group and the goal that the flow field covers.
+static const Int FLOW_FIELD_MARGIN_BLOCKS = 2;
+// Cells around the goal of the flow field in which the members of the group have their own goals.
+static const Int FLOW_FIELD_JOIN_CELLS = 12;
+
+/**
+ * Remembers the goal, the area and the members of a group move. The flow field itself is computed by the
+ * first member of the group that searches a path, because only then the locomotor surfaces are known.
+ */
+void Pathfinder::requestFlowField(const Coord3D *goal, const Coord2D *groupMin, const Coord2D *groupMax,
+																	const ObjectIDVector &members)
+{
+	m_flowField.clear();
+	if (!TheGameLogic->hasPathfindOption(PATHFIND_OPTION_GROUP_FLOW_FIELD) || !m_isMapReady) {
+		return;
+	}
+	ICoord2D goalCell;
+	worldToCell(goal, &goalCell);
+	if (getCell(LAYER_GROUND, goalCell.x, goalCell.y) == nullptr) {
+		return;
+	}
+
+	const Int margin = FLOW_FIELD_MARGIN_BLOCKS*PathfindZoneManager::ZONE_BLOCK_SIZE;
+	IRegion2D bounds;
+	bounds.lo.x = min(goalCell.x, REAL_TO_INT_FLOOR(groupMin->x/PATHFIND_CELL_SIZE_F)) - margin;
+	bounds.lo.y = min(goalCell.y, REAL_TO_INT_FLOOR(groupMin->y/PATHFIND_CELL_SIZE_F)) - margin;
+	bounds.hi.x = max(goalCell.x, REAL_TO_INT_FLOOR(groupMax->x/PATHFIND_CELL_SIZE_F)) + margin;
+	bounds.hi.y = max(goalCell.y, REAL_TO_INT_FLOOR(groupMax->y/PATHFIND_CELL_SIZE_F)) + margin;
+	bounds.lo.x = max(bounds.lo.x, m_extent.lo.x);
+	bounds.lo.y = max(bounds.lo.y, m_extent.lo.y);
+	bounds.hi.x = min(bounds.hi.x, m_extent.hi.x);
+	bounds.hi.y = min(bounds.hi.y, m_extent.hi.y);
+
+	m_flowField.request(goalCell, bounds, TheGameLogic->getFrame(), members);
+}
+
+/**
+ * Returns the cost of a step between neighboring ground cells for the flow field, or UNREACHED if the
+ * step is not valid. Same as examineNeighboringCells, except that units and turns are not considered.
+ */
+UnsignedInt Pathfinder::getFlowFieldStepCost(Int fromX, Int fromY, Int toX, Int toY)
+{
+	if (!m_flowField.isInBounds(fromX, fromY) || !m_flowField.isInBounds(toX, toY)) {
+		return PathfindFlowField::UNREACHED;
+	}
+	PathfindCell *fromCell = getCell(LAYER_GROUND, fromX, fromY);
+	PathfindCell *toCell = getCell(LAYER_GROUND, toX, toY);
+	if (fromCell == nullptr || toCell == nullptr) {
+		return PathfindFlowField::UNREACHED;
+	}
+	if (m_flowField.isHuman()) {
+		// check if the cells are in the logical map.	(computer can move off logical map)
+		ICoord2D fromNdx, toNdx;
+		fromNdx.x = fromX;
+		fromNdx.y = fromY;
+		toNdx.x = toX;
+		toNdx.y = toY;
+		if (checkCellOutsideExtents(fromNdx) || checkCellOutsideExtents(toNdx)) {
+			return PathfindFlowField::UNREACHED;
+		}
+	}
+
+	const LocomotorSurfaceTypeMask surfaces = m_flowField.getSurfaces();
+	const Bool crusher = m_flowField.isCrusher();
+	if (!validMovementPosition(crusher, surfaces, fromCell) || !validMovementPosition(crusher, surfaces, toCell, fromCell)) {
+		return PathfindFlowField::UNREACHED;
+	}
+
+	UnsignedInt cost = COST_ORTHOGONAL;
+	if (fromX != toX && fromY != toY) {
+		// Diagonal steps need one of the adjacent orthogonal cells to be open.
+		PathfindCell *sideCell1 = getCell(LAYER_GROUND, toX, fromY);
+		PathfindCell *sideCell2 = getCell(LAYER_GROUND, fromX, toY);
+		if (!(sideCell1 && validMovementPosition(crusher, surfaces, sideCell1)) &&
+				!(sideCell2 && validMovementPosition(crusher, surfaces, sideCell2))) {
+			return PathfindFlowField::UNREACHED;
+		}
+		cost = COST_DIAGONAL;
+	}
+
+	if (toCell->getPinched()) {
+		cost += COST_DIAGONAL + COST_ORTHOGONAL;
+	} else if (toCell->getType() == PathfindCell::CELL_CLIFF) {
+		Real fromZ = TheTerrainLogic->getGroundHeight(fromX * PATHFIND_CELL_SIZE_F, fromY * PATHFIND_CELL_SIZE_F);
+		Real toZ = TheTerrainLogic->getGroundHeight(toX * PATHFIND_CELL_SIZE_F, toY * PATHFIND_CELL_SIZE_F);
+		if (fabs(fromZ - toZ) < PATHFIND_CELL_SIZE_F) {
+			cost += 7*COST_DIAGONAL;
+		}
+	}
+	return cost;
+}
+
+/**
+ * Computes the cost to the goal from every cell in the bounds of the flow field, with a Dijkstra
+ * search that starts at the goal.
+ */
+void Pathfinder::computeFlowField(LocomotorSurfaceTypeMask surfaces, Bool crusher, Bool isHuman)
+{
+	m_flowField.reset(surfaces, crusher, isHuman);
+
+	const ICoord2D &goal = m_flowField.getGoal();
+	PathfindCell *goalCell = getCell(LAYER_GROUND, goal.x, goal.y);
+	if (goalCell == nullptr || !validMovementPosition(crusher, surfaces, goalCell)) {
+		// Nothing reaches the goal, so the members of the group search their own paths.
+		return;
+	}
+
+	static const ICoord2D delta[] = { {1,0}, {0,1}, {-1,0}, {0,-1}, {1,1}, {-1,1}, {-1,-1}, {1,-1} };
+	const Int numNeighbors = 8;
+
+	PathfindFlowField::OpenCell open;
+	open.m_cost = 0;
+	open.m_x = goal.x;
+	open.m_y = goal.y;
+	m_flowField.setCost(goal.x, goal.y, 0);
+	m_flowField.pushOpenCell(open);
+
+	Int cellCount = 0;
+	PathfindFlowField::OpenCell current;
+	while (m_flowField.popOpenCell(current)) {
+		if (current.m_cost != m_flowField.getCost(current.m_x, current.m_y)) {
+			continue; // a cheaper way to this cell was expanded already.
+		}
+		cellCount++;
+		for (Int i=0; i<numNeighbors; i++) {
+			const Int x = current.m_x + delta[i].x;
+			const Int y = current.m_y + delta[i].y;
+			// The units move from the neighbor to the current cell.
+			const UnsignedInt stepCost = getFlowFieldStepCost(x, y, current.m_x, current.m_y);
+			if (stepCost == PathfindFlowField::UNREACHED) {
+				continue;
+			}
+			const UnsignedInt cost = current.m_cost + stepCost;
+			if (cost < m_flowField.getCost(x, y)) {
+				m_flowField.setCost(x, y, cost);
+				open.m_cost = cost;
+				open.m_x = x;
+				open.m_y = y;
+				m_flowField.pushOpenCell(open);
+			}
+		}
+	}
+
+	// Count the cells like a path search, so that the pathfind queue is throttled the same way.
+	m_cumulativeCellsAllocated += cellCount;
+}
+
+/**
+ * Builds the path of a member of a group move by following the flow field of the group down to the goal,
+ * until the goal of the member is in a straight line. Returns null if the object is not part of the
+ * group move, or the flow field does not lead it to its goal, so that the caller searches the path.
+ */
+Path *Pathfinder::findFlowFieldPath(Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from,
+																		const Coord3D *to)
+{
+	if (!TheGameLogic->hasPathfindOption(PATHFIND_OPTION_GROUP_FLOW_FIELD) || !m_flowField.isRequested() || obj == nullptr) {
+		return nullptr;
+	}
+	if (TheGameLogic->getFrame() > m_flowField.getFrame() + FLOW_FIELD_LIFETIME) {
+		m_flowField.clear();
+		return nullptr;
+	}
+	if (!m_flowField.isMember(obj->getID())) {
+		return nullptr;
+	}
+	if (obj->getAIUpdateInterface() == nullptr || obj->getLayer() != LAYER_GROUND ||
+			TheTerrainLogic->getLayerForDestination(to) != LAYER_GROUND) {
+		return nullptr;
+	}
+	const Coord3D *objPos = obj->getPosition();
+	if (from->x != objPos->x || from->y != objPos->y) {
+		return nullptr;
+	}
+
+	Bool centerInCell;
+	Int radius;
+	getRadiusAndCenter(obj, radius, centerInCell);
+	Coord3D goalPos = *to;
+	if (!centerInCell) {
+		goalPos.x += PATHFIND_CELL_SIZE_F/2;
+		goalPos.y += PATHFIND_CELL_SIZE_F/2;
+	}
+	ICoord2D startCell, goalCell;
+	worldToCell(from, &startCell);
+	worldToCell(&goalPos, &goalCell);
+
+	// A member that was sent somewhere else since the group move searches its own path.
+	const ICoord2D &fieldGoal = m_flowField.getGoal();
+	if (IABS(goalCell.x - fieldGoal.x) > FLOW_FIELD_JOIN_CELLS || IABS(goalCell.y - fieldGoal.y) > FLOW_FIELD_JOIN_CELLS) {
+		return nullptr;
+	}
 
-			newCell->setBlockedByAlly(false);
-			if (info.allyFixedCount>0) {
-#if RTS_GENERALS && RETAIL_COMPATIBLE_PATHFINDING
-				newCostSoFar += 3*COST_DIAGONAL*info.allyFixedCount;
-#else
-				newCostSoFar += 3*COST_DIAGONAL;
-#endif
-				if (!canPathThroughUnits)
-					newCell->setBlockedByAlly(true);
-			}
+	Bool isHuman = true;
+	if (obj->getControllingPlayer() && (obj->getControllingPlayer()->getPlayerType()==PLAYER_COMPUTER)) {
+		isHuman = false; // computer gets to cheat.
+	}
+	const LocomotorSurfaceTypeMask surfaces = locomotorSet.getValidSurfaces();
+	const Bool crusher = obj->getCrusherLevel() > 0;
+	if (!m_flowField.isComputed()) {
+		computeFlowField(surfaces, crusher, isHuman);
+	}
+	if (!m_flowField.matches(surfaces, crusher, isHuman)) {
+		return nullptr;
+	}
+	if (m_flowField.getCost(startCell.x, startCell.y) == PathfindFlowField::UNREACHED) {
+		return nullptr;
+	}
+	if (!checkDestination(obj, goalCell.x, goalCell.y, LAYER_GROUND, radius, centerInCell)) {
+		return nullptr;
+	}
+	adjustCoordToCell(goalCell.x, goalCell.y, centerInCell, goalPos, LAYER_GROUND);
 
-			Int costRemaining = 0;
-			if (goalCell) {
-				if (attackDistance == NO_ATTACK)  {
-					costRemaining = newCell->costToGoal( goalCell );
-				}	else {
-					dx = newCellCoord.x - goalCell->getXIndex();
-					dy = newCellCoord.y - goalCell->getYIndex();
-					costRemaining = COST_ORTHOGONAL*sqrt(dx*dx + dy*dy);
-					costRemaining -= attackDistance/2;
-					if (costRemaining<0)
-						costRemaining=0;
-					if (info.allyGoal) {
-						if (obj->isKindOf(KINDOF_VEHICLE)) {
-							newCostSoFar += 3*COST_ORTHOGONAL;
-						}	else {
-							// Infantry can pass through infantry.
-							newCostSoFar += COST_ORTHOGONAL;
-						}
-					}
-				}
-			}
+	static const ICoord2D delta[] = { {1,0}, {0,1}, {-1,0}, {0,-1}, {1,1}, {-1,1}, {-1,-1}, {1,-1} };
+	const Int numNeighbors = 8;
 
-			if (notZonePassable) {
-				newCostSoFar += 100*COST_ORTHOGONAL;
+	// The first node is the position of the unit, like in prependCells.
+	Path *path = newInstance(Path);
+	path->appendNode(from, LAYER_GROUND);
+
+	ICoord2D cell = startCell;
+	Bool joined = false;
+	for (;;) {
+		if (IABS(cell.x - goalCell.x) <= FLOW_FIELD_JOIN_CELLS && IABS(cell.y - goalCell.y) <= FLOW_FIELD_JOIN_CELLS) {
+			Coord3D cellPos;
+			adjustCoordToCell(cell.x, cell.y, centerInCell, cellPos, LAYER_GROUND);
+			if (isLinePassable(obj, surfaces, LAYER_GROUND, cellPos, goalPos, false, false)) {
+				joined = true;
+				break;
 			}
+		}
 
-			if (newCell->getType()==PathfindCell::CELL_OBSTACLE) {
-				newCostSoFar += 100*COST_ORTHOGONAL;
-			}
+		const UnsignedInt cost = m_flowField.getCost(cell.x, cell.y);
+		if (cost == 0) {
+			break; // at the goal of the flow field.
+		}
 
-			if (m_isTunneling) {
-				if (!validMovementPosition( isCrusher, locomotorSet.getValidSurfaces(), newCell, parentCell )) {
-					newCostSoFar += 10*COST_ORTHOGONAL;
-				}
+		// Step to the neighbor that is on the cheapest way to the goal.
+		ICoord2D next = cell;
+		UnsignedInt nextCost = cost;
+		for (Int i=0; i<numNeighbors; i++) {
+			const Int x = cell.x + delta[i].x;
+			const Int y = cell.y + delta[i].y;
+			const UnsignedInt neighborCost = m_flowField.getCost(x, y);
+			if (neighborCost >= cost) {
+				continue;
 			}
-
-			newCell->setCostSoFar(newCostSoFar);
-			// keep track of path we're building - point back to cell we moved here from
-			newCell->setParentCell(parentCell) ;
-			if (m_isTunneling) {
-				costRemaining = 0; // find the closest valid cell.
+			const UnsignedInt stepCost = getFlowFieldStepCost(cell.x, cell.y, x, y);
+			if (stepCost == PathfindFlowField::UNREACHED) {
+				continue;
 			}
-			newCell->setTotalCost(newCell->getCostSoFar() + costRemaining) ;
-
-			// if newCell was on closed list, remove it from the list
-			if (newCell->getClosed())
-				newCell->removeFromClosedList( m_closedList );
-
-			// if the newCell was already on the open list, remove it so it can be re-inserted in order
-			if (newCell->getOpen())
-				newCell->removeFromOpenList( m_openList );
+			if (neighborCost + stepCost <= nextCost) {
+				next.x = x;
+				next.y = y;
+				nextCost = neighborCost + stepCost;
+			}
+		}
+		if (next.x == cell.x && next.y == cell.y) {
+			break; // shouldn't happen, the costs always lead to the goal.
+		}
 
-			// insert newCell in open list such that open list is sorted, smallest total path cost first
-			newCell->putOnSortedOpenList( m_openList );
+		PathfindCell *prevCell = getCell(LAYER_GROUND, cell.x, cell.y);
+		PathfindCell *nextCell = getCell(LAYER_GROUND, next.x, next.y);
+		Coord3D pos;
+		adjustCoordToCell(next.x, next.y, centerInCell, pos, LAYER_GROUND);
+		path->appendNode(&pos, LAYER_GROUND);
+		// Don't optimize the nodes next to cliffs away, same as prependCells.
+		if ((prevCell->getType() == PathfindCell::CELL_CLIFF) != (nextCell->getType() == PathfindCell::CELL_CLIFF)) {
+			path->getLastNode()->setCanOptimize(false);
 		}
-	return cellCount;
-}
+		cell = next;
+	}
 
+	if (!joined) {
+		deleteInstance(path);
+		return nullptr;
+	}
+	path->appendNode(&goalPos, LAYER_GROUND);
+	path->optimize(obj, surfaces, false);
+	return path;
+}
 
 /**
  * Find a short, valid path between given locations.
@@ -6506,6 +8080,19 @@ Path *Pathfinder::findPath( Object *obj, const LocomotorSet& locomotorSet, const
 	if (!clientSafeQuickDoesPathExist(locomotorSet, from, rawTo)) {
 		return nullptr;
 	}
+
+	// TheSuperHackers @performance Follow the flow field of a group move that the object is part of.
+	Path *flowFieldPath = findFlowFieldPath(obj, locomotorSet, from, rawTo);
+	if (flowFieldPath) {
+		return flowFieldPath;
+	}
+
+	// TheSuperHackers @performance Follow a recent path between the same zone blocks if there is one.
+	Path *cachedPath = findCachedPath(obj, locomotorSet, from, rawTo);
+	if (cachedPath) {
+		return cachedPath;
+	}
+
 	Bool isHuman = true;
 	if (obj && obj->getControllingPlayer() && (obj->getControllingPlayer()->getPlayerType()==PLAYER_COMPUTER)) {
 		isHuman = false; // computer gets to cheat.
@@ -6521,6 +8108,7 @@ Path *Pathfinder::findPath( Object *obj, const LocomotorSet& locomotorSet, const
 
 	Path *pat = internalFindPath(obj, locomotorSet, from, rawTo);
 	if (pat!=nullptr) {
+		addCachedPath(obj, locomotorSet, from, rawTo, pat);
 		return pat;
 	}
 
@@ -7695,6 +9283,12 @@ Path *Pathfinder::internal_findHierarchicalPath( Bool isHuman, const LocomotorSu
 		return nullptr;
 	}
 
+	// TheSuperHackers @feature Optionally search on the portal graph of the zone blocks instead. The graph
+	// only holds ground cells, so searches that start or end on a bridge continue below.
+	if (TheGameLogic->hasPathfindOption(PATHFIND_OPTION_PORTALS) && parentCell->getLayer()==LAYER_GROUND && goalCell->getLayer()==LAYER_GROUND) {
+		return internal_findPortalPath(isHuman, locomotorSurface, from, parentCell, goalCell, crusher, closestOK);
+	}
+
 	parentCell->startPathfind(goalCell);
 
 	// "closed" list is initially empty
@@ -8201,6 +9795,294 @@ Path *Pathfinder::internal_findHierarchicalPath( Bool isHuman, const LocomotorSu
 	return nullptr;
 }
 
+//-------------------------------------------------------------------------------------------------
+static Int portalCost( const ICoord2D &from, const ICoord2D &to )
+{
+	// Same as PathfindCell::costToHierGoal.
+	Int dx = from.x - to.x;
+	Int dy = from.y - to.y;
+	return REAL_TO_INT_FLOOR(COST_ORTHOGONAL*sqrt(dx*dx + dy*dy) + 0.5f);
+}
+
+//-------------------------------------------------------------------------------------------------
+static Bool isPortalNodeBefore( const std::vector<PathfindPortalNode> &nodes, Int a, Int b )
+{
+	if (nodes[a].m_totalCost != nodes[b].m_totalCost) {
+		return nodes[a].m_totalCost < nodes[b].m_totalCost;
+	}
+	return a < b;
+}
+
+/**
+ * Returns the portal graph for the surfaces and crusher flag, replacing the graph that was used least recently.
+ */
+PathfindPortalGraph &Pathfinder::getPortalGraph( LocomotorSurfaceTypeMask locomotorSurface, Bool crusher )
+{
+	ICoord2D blockExtent;
+	m_zoneManager.getExtent(blockExtent);
+
+	Int oldest = 0;
+	Int i;
+	for (i=0; i<MAX_PORTAL_GRAPHS; i++) {
+		if (m_portalGraphs[i].isFor(locomotorSurface, crusher, blockExtent)) {
+			m_portalGraphs[i].setLastUse(++m_portalGraphUseCount);
+			return m_portalGraphs[i];
+		}
+		if (m_portalGraphs[i].getLastUse() < m_portalGraphs[oldest].getLastUse()) {
+			oldest = i;
+		}
+	}
+
+	m_portalGraphs[oldest].init(locomotorSurface, crusher, blockExtent);
+	m_portalGraphs[oldest].setLastUse(++m_portalGraphUseCount);
+	return m_portalGraphs[oldest];
+}
+
+//-------------------------------------------------------------------------------------------------
+Int Pathfinder::addPortalNode( const ICoord2D &cell, zoneStorageType zone, Int costSoFar, const ICoord2D &goal, Int parent )
+{
+	PathfindPortalNode node;
+	node.m_cell = cell;
+	node.m_zone = zone;
+	node.m_costSoFar = costSoFar;
+	node.m_totalCost = costSoFar + portalCost(cell, goal);
+	node.m_parent = parent;
+	m_portalNodes.push_back(node);
+	return (Int)m_portalNodes.size() - 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Pathfinder::pushPortalNode( Int node )
+{
+	Int i = (Int)m_portalOpenList.size();
+	m_portalOpenList.push_back(node);
+	while (i > 0) {
+		Int parent = (i-1)>>1;
+		if (!isPortalNodeBefore(m_portalNodes, node, m_portalOpenList[parent])) {
+			break;
+		}
+		m_portalOpenList[i] = m_portalOpenList[parent];
+		i = parent;
+	}
+	m_portalOpenList[i] = node;
+}
+
+//-------------------------------------------------------------------------------------------------
+Int Pathfinder::popPortalNode()
+{
+	Int head = m_portalOpenList[0];
+	Int last = m_portalOpenList.back();
+	m_portalOpenList.pop_back();
+
+	Int size = (Int)m_portalOpenList.size();
+	if (size > 0) {
+		Int i = 0;
+		for (;;) {
+			Int child = (i<<1)+1;
+			if (child >= size) {
+				break;
+			}
+			if (child+1 < size && isPortalNodeBefore(m_portalNodes, m_portalOpenList[child+1], m_portalOpenList[child])) {
+				child++;
+			}
+			if (!isPortalNodeBefore(m_portalNodes, m_portalOpenList[child], last)) {
+				break;
+			}
+			m_portalOpenList[i] = m_portalOpenList[child];
+			i = child;
+		}
+		m_portalOpenList[i] = last;
+	}
+	return head;
+}
+
+/**
+ * TheSuperHackers @feature Finds a hierarchical path with an A* search on the portal graph of the zone
+ * blocks, instead of examining the border cells of every block that the search reaches. The start and goal
+ * cells are on the ground layer and have their info allocated. Each portal is taken once per search, like
+ * each border cell in internal_findHierarchicalPath, and bridges are linked at their ends like there.
+ */
+Path *Pathfinder::internal_findPortalPath( Bool isHuman, const LocomotorSurfaceTypeMask locomotorSurface, const Coord3D *from,
+	PathfindCell *startCell, PathfindCell *goalCell, Bool crusher, Bool closestOK)
+{
+	PathfindPortalGraph &graph = getPortalGraph(locomotorSurface, crusher);
+	const UnsignedInt searchID = graph.beginSearch();
+
+	ICoord2D goalNdx;
+	goalNdx.x = goalCell->getXIndex();
+	goalNdx.y = goalCell->getYIndex();
+	zoneStorageType goalBlockZone = m_zoneManager.getBlockZone(locomotorSurface, crusher, goalNdx.x, goalNdx.y, m_map);
+	Int goalBlockX = goalNdx.x/PathfindZoneManager::ZONE_BLOCK_SIZE;
+	Int goalBlockY = goalNdx.y/PathfindZoneManager::ZONE_BLOCK_SIZE;
+
+	ICoord2D startNdx;
+	startNdx.x = startCell->getXIndex();
+	startNdx.y = startCell->getYIndex();
+
+	m_portalNodes.clear();
+	m_portalOpenList.clear();
+	pushPortalNode(addPortalNode(startNdx, m_zoneManager.getBlockZone(locomotorSurface, crusher, startNdx.x, startNdx.y, m_map),
+		0, goalNdx, -1));
+
+	// A bridge is linked once from each end.
+	Bool linkedBridgeEnd[LAYER_LAST+1][2];
+	memset(linkedBridgeEnd, 0, sizeof(linkedBridgeEnd));
+
+	Int goalNode = -1;
+	Int closestNode = -1;
+	Int closestDistSqr = 0;
+
+	while (!m_portalOpenList.empty())
+	{
+		const Int nodeIndex = popPortalNode();
+		const PathfindPortalNode node = m_portalNodes[nodeIndex];
+		Int blockX = node.m_cell.x/PathfindZoneManager::ZONE_BLOCK_SIZE;
+		Int blockY = node.m_cell.y/PathfindZoneManager::ZONE_BLOCK_SIZE;
+
+		if (node.m_zone == goalBlockZone && blockX == goalBlockX && blockY == goalBlockY) {
+			goalNode = nodeIndex;
+			break;
+		}
+
+		Int dx = goalNdx.x - node.m_cell.x;
+		Int dy = goalNdx.y - node.m_cell.y;
+		Int distSqr = dx*dx + dy*dy;
+		if (closestNode < 0 || distSqr < closestDistSqr) {
+			closestNode = nodeIndex;
+			closestDistSqr = distSqr;
+		}
+
+		if (node.m_zone == PathfindZoneManager::UNINITIALIZED_ZONE) {
+			continue;
+		}
+
+		if (m_zoneManager.interactsWithBridge(node.m_cell.x, node.m_cell.y)) {
+			Int i;
+			for (i=0; i<=LAYER_LAST; i++) {
+				if (m_layers[i].isUnused() || m_layers[i].isDestroyed()) {
+					continue;
+				}
+				ICoord2D ndx;
+				ICoord2D toNdx;
+				Int end = 0;
+				m_layers[i].getStartCellIndex(&ndx);
+				m_layers[i].getEndCellIndex(&toNdx);
+				if (ndx.x/PathfindZoneManager::ZONE_BLOCK_SIZE != blockX ||
+						ndx.y/PathfindZoneManager::ZONE_BLOCK_SIZE != blockY) {
+					m_layers[i].getStartCellIndex(&toNdx);
+					m_layers[i].getEndCellIndex(&ndx);
+					end = 1;
+				}
+				if (ndx.x<0 || ndx.y<0) continue;
+				if (toNdx.x<0 || toNdx.y<0) continue;
+				if (ndx.x/PathfindZoneManager::ZONE_BLOCK_SIZE != blockX ||
+						ndx.y/PathfindZoneManager::ZONE_BLOCK_SIZE != blockY) {
+					continue;
+				}
+				if (linkedBridgeEnd[i][end]) {
+					continue;
+				}
+				if (m_zoneManager.getBlockZone(locomotorSurface, crusher, ndx.x, ndx.y, m_map) != node.m_zone) {
+					continue;
+				}
+				if (!getCell(LAYER_GROUND, toNdx.x, toNdx.y)) {
+					continue;
+				}
+				linkedBridgeEnd[i][end] = true;
+
+				// Go to the near end of the bridge, then across to the far end.
+				Int bridgeNode = addPortalNode(ndx, node.m_zone, node.m_costSoFar + portalCost(node.m_cell, ndx), goalNdx, nodeIndex);
+				Int costSoFar = m_portalNodes[bridgeNode].m_costSoFar + portalCost(ndx, toNdx);
+				pushPortalNode(addPortalNode(toNdx, m_zoneManager.getBlockZone(locomotorSurface, crusher, toNdx.x, toNdx.y, m_map),
+					costSoFar, goalNdx, bridgeNode));
+			}
+		}
+
+		PathfindPortalGraph::PortalVector &portals = graph.getPortals(m_zoneManager, m_map, m_extent, blockX, blockY);
+		for (size_t p = 0; p < portals.size(); p++) {
+			PathfindPortalGraph::Portal &portal = portals[p];
+			if (portal.m_fromZone != node.m_zone || portal.m_searchID == searchID) {
+				continue;
+			}
+			if (isHuman && checkCellOutsideExtents(portal.m_from)) {
+				continue;
+			}
+			portal.m_searchID = searchID;
+
+			Int cost = portalCost(node.m_cell, portal.m_to);
+			if (portal.m_pinched) {
+				cost += 2*COST_ORTHOGONAL;
+			}
+			pushPortalNode(addPortalNode(portal.m_to, portal.m_toZone, node.m_costSoFar + cost, goalNdx, nodeIndex));
+		}
+	}
+
+	m_isTunneling = false;
+
+	Int lastNode = goalNode;
+	if (lastNode < 0 && closestOK) {
+		lastNode = closestNode;
+	}
+	if (lastNode < 0) {
+		DEBUG_LOG(("%d FindPortalPath failed from (%f,%f) to (%d,%d)", TheGameLogic->getFrame(), from->x, from->y,
+			goalNdx.x, goalNdx.y));
+#ifdef DUMP_PERF_STATS
+		TheGameLogic->incrementOverallFailedPathfinds();
+#endif
+		startCell->releaseInfo();
+		goalCell->releaseInfo();
+		return nullptr;
+	}
+
+	// Collect the cells of the path, from the start to the end.
+	std::vector<ICoord2D> pathCells;
+	if (goalNode >= 0) {
+		pathCells.push_back(goalNdx);
+	}
+	Int n;
+	for (n = lastNode; n >= 0; n = m_portalNodes[n].m_parent) {
+		pathCells.push_back(m_portalNodes[n].m_cell);
+	}
+	std::reverse(pathCells.begin(), pathCells.end());
+
+	// The path can pass a cell twice, for example at the end of a bridge. Cut out such loops,
+	// because the parents of the cells have to form a chain back to the start cell.
+	Int count = 0;
+	Int size = (Int)pathCells.size();
+	Int i, j;
+	for (i=0; i<size; i++) {
+		Int last = i;
+		for (j=i+1; j<size; j++) {
+			if (pathCells[j].x == pathCells[i].x && pathCells[j].y == pathCells[i].y) {
+				last = j;
+			}
+		}
+		pathCells[count++] = pathCells[last];
+		i = last;
+	}
+
+	// Link the cells like internal_findHierarchicalPath does, so that buildHierarchicalPath can follow them.
+	startCell->clearParentCell();
+	startCell->putOnClosedList(m_closedList);
+	PathfindCell *prevCell = startCell;
+	for (i=1; i<count; i++) {
+		PathfindCell *cell = getCell(LAYER_GROUND, pathCells[i].x, pathCells[i].y);
+		if (!cell->allocateInfo(pathCells[i])) {
+			cleanOpenAndClosedLists();
+			goalCell->releaseInfo();
+			return nullptr;
+		}
+		cell->setParentCellHierarchical(prevCell);
+		cell->putOnClosedList(m_closedList);
+		prevCell = cell;
+	}
+
+	Path *path = buildHierarchicalPath( from, prevCell );
+	cleanOpenAndClosedLists();
+	startCell->releaseInfo();
+	goalCell->releaseInfo();
+	return path;
+}
 
 /**
  * Does any broken bridge join from and to?
@@ -8829,6 +10711,19 @@ Path *Pathfinder::findClosestPath( Object *obj, const LocomotorSet& locomotorSet
 		m_isTunneling = true; // We can't move from our current location.  So relax the constraints.
 	}
 
+	// TheSuperHackers @performance Follow the flow field of a group move that the object is part of,
+	// or a recent path between the same zone blocks if there is one.
+	if (!blocked && !m_isTunneling && !goalOnObstacle) {
+		Path *flowFieldPath = findFlowFieldPath(obj, locomotorSet, from, rawTo);
+		if (flowFieldPath) {
+			return flowFieldPath;
+		}
+		Path *cachedPath = findCachedPath(obj, locomotorSet, from, rawTo);
+		if (cachedPath) {
+			return cachedPath;
+		}
+	}
+
 	Bool gotHierarchicalPath = false;
 	if (m_isTunneling) {
 		m_zoneManager.setAllPassable(); // can't optimize.
@@ -8950,6 +10845,9 @@ Path *Pathfinder::findClosestPath( Object *obj, const LocomotorSet& locomotorSet
 				goalCell->releaseInfo();
 			}
 
+			if (!blocked && !startedStuck && !goalOnObstacle) {
+				addCachedPath(obj, locomotorSet, from, rawTo, path);
+			}
 			return path;
 		}
 		// put parent cell onto closed list - its evaluation is finished
@@ -9590,8 +11488,28 @@ Bool Pathfinder::isAttackViewBlockedByObstacle(const Object* attacker, const Coo
 		}
 	}
 
+	// TheSuperHackers @performance Reuse the result of a recent walk with the same inputs.
+	PathfindLineOfSightCache::Key key;
+	key.m_from.x = attackerPos.x;
+	key.m_from.y = attackerPos.y;
+	key.m_to.x = victimPos.x;
+	key.m_to.y = victimPos.y;
+	key.m_layer = layer;
+	key.m_victimLayer = victim ? victim->getLayer() : LAYER_GROUND;
+	key.m_skipCount = info.skipCount;
+	key.m_attacker = attacker->getID();
+	key.m_attackerContainer = getContainerID(attacker);
+	key.m_attackerSlaver = getSlaverID(attacker);
+	key.m_victim = victim ? victim->getID() : INVALID_ID;
+	key.m_victimSlaver = victim ? getSlaverID(victim) : INVALID_ID;
+	Bool blocked;
+	if (m_lineOfSightCache.find(key, blocked)) {
+		return blocked;
+	}
+
 	Int ret = iterateCellsAlongLine(attackerPos, victimPos, layer, attackBlockedByObstacleCallback, &info);
 	//CRCDEBUG_LOG(("Pathfinder::isAttackViewBlockedByObstacle() 4"));
+	m_lineOfSightCache.add(key, ret != 0);
 	return ret != 0;
 }
 
@@ -9829,7 +11747,28 @@ void Pathfinder::changeBridgeState( PathfindLayerEnum layer, Bool repaired)
 {
 	if (m_layers[layer].isUnused()) return;
 	if (m_layers[layer].setDestroyed(!repaired)) {
-		m_zoneManager.markZonesDirty();
+		if (TheGameLogic->hasPathfindOption(PATHFIND_OPTION_INCREMENTAL_ZONES)) {
+			// The bridge only changes the layers that the ground cells under it connect to.
+			IRegion2D cellBounds;
+			m_layers[layer].getCellBounds(&cellBounds);
+			ICoord2D ndx;
+			m_layers[layer].getStartCellIndex(&ndx);
+			cellBounds.lo.x = min(cellBounds.lo.x, ndx.x);
+			cellBounds.lo.y = min(cellBounds.lo.y, ndx.y);
+			cellBounds.hi.x = max(cellBounds.hi.x, ndx.x);
+			cellBounds.hi.y = max(cellBounds.hi.y, ndx.y);
+			m_layers[layer].getEndCellIndex(&ndx);
+			cellBounds.lo.x = min(cellBounds.lo.x, ndx.x);
+			cellBounds.lo.y = min(cellBounds.lo.y, ndx.y);
+			cellBounds.hi.x = max(cellBounds.hi.x, ndx.x);
+			cellBounds.hi.y = max(cellBounds.hi.y, ndx.y);
+			m_zoneManager.repairZones(m_map, m_layers, cellBounds, m_extent);
+		} else {
+			m_zoneManager.markZonesDirty();
+		}
+		m_pathCache.clear();
+		m_flowField.clear();
+		m_lineOfSightCache.clear();
 	}
 }
 
@@ -9940,6 +11879,7 @@ void Pathfinder::updateGoal( Object *obj, const Coord3D *newGoalPos, PathfindLay
 					cellNdx.x = i;
 					cellNdx.y = j;
 					cell->setGoalUnit(obj->getID(), cellNdx);
+					updateGroundCellFlags(cell);
 				}
 			}
 			if (doGround) {
@@ -9952,6 +11892,7 @@ void Pathfinder::updateGoal( Object *obj, const Coord3D *newGoalPos, PathfindLay
 					cellNdx.x = i;
 					cellNdx.y = j;
 					cell->setGoalUnit(obj->getID(), cellNdx);
+					updateGroundCellFlags(cell);
 				}
 			}
 		}
@@ -10055,6 +11996,7 @@ void Pathfinder::removeGoal( Object *obj)
 						cellNdx.x = i;
 						cellNdx.y = j;
 						cell->setGoalUnit(INVALID_ID, cellNdx);
+						updateGroundCellFlags(cell);
 					}
 					if (cell->getGoalAircraft()==obj->getID()) {
 						cellNdx.x = i;
@@ -10069,6 +12011,7 @@ void Pathfinder::removeGoal( Object *obj)
 							cellNdx.x = i;
 							cellNdx.y = j;
 							cell->setGoalUnit(INVALID_ID, cellNdx);
+							updateGroundCellFlags(cell);
 						}
 					}
 				}
@@ -10151,6 +12094,7 @@ void Pathfinder::updatePos( Object *obj, const Coord3D *newPos)
 				if (cell) {
 					if (cell->getPosUnit()==obj->getID()) {
 						cell->setPosUnit(INVALID_ID, cellNdx);
+						updateGroundCellFlags(cell);
 					}
 				}
 				if (layer!=LAYER_GROUND) {
@@ -10159,6 +12103,7 @@ void Pathfinder::updatePos( Object *obj, const Coord3D *newPos)
 					if (cell) {
 						if (cell->getPosUnit()==obj->getID()) {
 							cell->setPosUnit(INVALID_ID, cellNdx);
+							updateGroundCellFlags(cell);
 						}
 					}
 				}
@@ -10174,12 +12119,14 @@ void Pathfinder::updatePos( Object *obj, const Coord3D *newPos)
 				cell = getCell(layer, i, j);
 				if (cell) {
 					cell->setPosUnit(obj->getID(), cellNdx);
+					updateGroundCellFlags(cell);
 				}
 			}
 			if (doGround) {
 				cell = getCell(LAYER_GROUND, i, j);
 				if (cell) {
 					cell->setPosUnit(obj->getID(), cellNdx);
+					updateGroundCellFlags(cell);
 				}
 			}
 		}
@@ -10222,6 +12169,7 @@ void Pathfinder::removePos( Object *obj)
 				if (cell) {
 					if (cell->getPosUnit()==obj->getID()) {
 						cell->setPosUnit(INVALID_ID, cellNdx);
+						updateGroundCellFlags(cell);
 					}
 				}
 				if (layer!=LAYER_GROUND) {
@@ -10230,6 +12178,7 @@ void Pathfinder::removePos( Object *obj)
 					if (cell) {
 						if (cell->getPosUnit()==obj->getID()) {
 							cell->setPosUnit(INVALID_ID, cellNdx);
+							updateGroundCellFlags(cell);
 						}
 					}
 				}
@@ -11361,18 +13310,58 @@ void Pathfinder::crc( Xfer *xfer )
 }
 
 //-----------------------------------------------------------------------------
+/**
+ * TheSuperHackers @fix The pathfinder is saved in its own block after the game logic, see
+ * GameState::init. The map was classified again while the game logic loaded, with the pathfinding
+ * options of the command line, so it is classified once more if the game used other options.
+ * Version Info:
+ * 1: Initial version
+ * 2: The pathfinding options
+ * 3: The path cache and the pending zone calculation
+ * 4: The flow field of the last group move
+ */
 void Pathfinder::xfer( Xfer *xfer )
 {
 
 	// version
-	XferVersion currentVersion = 1;
+	XferVersion currentVersion = 4;
 	XferVersion version = currentVersion;
 	xfer->xferVersion( &version, currentVersion );
 
+	if (version >= 2)
+	{
+		UnsignedInt options = TheGameLogic->getPathfindOptions();
+		xfer->xferUnsignedInt( &options );
+		if (xfer->getXferMode() == XFER_LOAD && options != TheGameLogic->getPathfindOptions())
+		{
+			TheGameLogic->setPathfindOptions( options );
+			newMap();
+		}
+	}
+
+	if (version >= 3)
+	{
+		// Loading classifies the objects again after the zones, which leaves the zones dirty. Calculate
+		// them now and restore the pending recalculation, which clears the cached paths on the same frame.
+		UnsignedInt nextFrameToCalculateZones = m_zoneManager.getNextFrameToCalculateZones();
+		xfer->xferUnsignedInt( &nextFrameToCalculateZones );
+		if (xfer->getXferMode() == XFER_LOAD)
+		{
+			m_zoneManager.calculateZones( m_map, m_layers, m_extent );
+			m_zoneManager.setNextFrameToCalculateZones( nextFrameToCalculateZones );
+		}
+		m_pathCache.xfer( xfer );
+	}
+
+	if (version >= 4)
+	{
+		m_flowField.xfer( xfer );
+	}
+
 }
 
 //-----------------------------------------------------------------------------
 void Pathfinder::loadPostProcess()
 {
-
+	m_lineOfSightCache.clear();
 }
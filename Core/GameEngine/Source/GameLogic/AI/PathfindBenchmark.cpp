@@ -0,0 +1,427 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: PathfindBenchmark.cpp ////////////////////////////////////////////////////////////////////
+// Runs a seeded workload of path queries on a map and reports the cost of the pathfinder
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "GameLogic/PathfindBenchmark.h"
+
+#include "Common/GlobalData.h"
+#include "Common/MessageStream.h"
+#include "Common/Player.h"
+#include "Common/PlayerList.h"
+#include "Common/RandomValue.h"
+#include "Common/ThingFactory.h"
+#include "Common/ThingTemplate.h"
+#include "GameLogic/AI.h"
+#include "GameLogic/AIPathfind.h"
+#include "GameLogic/GameLogic.h"
+#include "GameLogic/Module/AIUpdate.h"
+#include "GameLogic/Object.h"
+#include "GameLogic/TerrainLogic.h"
+#include "GameLogic/Weapon.h"
+#include "GameNetwork/GameInfo.h"
+
+namespace
+{
+const char *const QueryNames[PathfindBenchmark::QUERY_TYPE_COUNT] =
+{
+	"path",
+	"hierarchical",
+	"attack",
+	"safe",
+};
+
+// Ground units with a weapon that exist in both games. The first one that can be created is used.
+const char *const UnitNames[] =
+{
+	"AmericaTankCrusader",
+	"ChinaTankBattleMaster",
+	"GLATankScorpion",
+};
+
+// Frames to wait for the map to load before giving up.
+const Int MAX_START_FRAMES = 30;
+
+// Attempts to find a cell that the benchmark unit can stand on.
+const Int MAX_POSITION_ATTEMPTS = 1000;
+
+const Real SAFE_PATH_REPULSOR_RADIUS = 150.0f;
+
+// Rounds of the zone repair check, and the areas of cells that each round changes.
+const Int ZONE_REPAIR_ROUNDS = 20;
+const Int ZONE_REPAIR_AREAS = 4;
+const Int ZONE_REPAIR_MAX_SIZE = 12;
+
+// Surfaces whose effective zones are compared by the zone repair check.
+const LocomotorSurfaceTypeMask ZoneSurfaces[] =
+{
+	LOCOMOTORSURFACE_GROUND,
+	LOCOMOTORSURFACE_GROUND | LOCOMOTORSURFACE_WATER,
+	LOCOMOTORSURFACE_GROUND | LOCOMOTORSURFACE_CLIFF,
+	LOCOMOTORSURFACE_GROUND | LOCOMOTORSURFACE_RUBBLE,
+};
+
+UnsignedInt nextRandom(UnsignedInt &random)
+{
+	random = random * 1664525u + 1013904223u;
+	return random >> 8;
+}
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+Int64 PathfindBenchmark::getTicks()
+{
+	LARGE_INTEGER tick;
+	QueryPerformanceCounter(&tick);
+	return tick.QuadPart;
+}
+
+//-------------------------------------------------------------------------------------------------
+Real PathfindBenchmark::ticksToMs(Int64 ticks)
+{
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+	return (Real)((double)ticks * 1000.0 / (double)freq.QuadPart);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Starts a single player game on the map, like -file does, and waits until the map is loaded.
+Bool PathfindBenchmark::startGame(const AsciiString &mapName)
+{
+	TheWritableGlobalData->m_pendingFile = mapName;
+
+	// Like the replay playback, send the message directly to the command list, because
+	// TheMessageStream is not updated here.
+	TheCommandList->reset();
+	GameMessage *msg = newInstance(GameMessage)(GameMessage::MSG_NEW_GAME);
+	msg->appendIntegerArgument(GAME_SINGLE_PLAYER);
+	msg->appendIntegerArgument(DIFFICULTY_NORMAL);
+	msg->appendIntegerArgument(0);
+	TheCommandList->appendMessage(msg);
+	InitRandom(0);
+
+	for (Int frame = 0; frame < MAX_START_FRAMES; ++frame)
+	{
+		TheGameLogic->UPDATE();
+		if (TheGameLogic->isInGame() && !TheGameLogic->isLoadingMap() && TheGameLogic->getFrame() > 0)
+			return TRUE;
+	}
+	return FALSE;
+}
+
+//-------------------------------------------------------------------------------------------------
+Object *PathfindBenchmark::createUnit()
+{
+	Team *team = ThePlayerList->getNeutralPlayer()->getDefaultTeam();
+	for (size_t i = 0; i < ARRAY_SIZE(UnitNames); ++i)
+	{
+		const ThingTemplate *tmpl = TheThingFactory->findTemplate(UnitNames[i], FALSE);
+		if (tmpl == nullptr)
+			continue;
+
+		Object *obj = TheThingFactory->newObject(tmpl, team);
+		if (obj == nullptr)
+			continue;
+
+		AIUpdateInterface *ai = obj->getAIUpdateInterface();
+		if (ai != nullptr && ai->chooseLocomotorSet(LOCOMOTORSET_NORMAL) && obj->getWeaponInWeaponSlot(PRIMARY_WEAPON) != nullptr)
+			return obj;
+
+		TheGameLogic->destroyObject(obj);
+	}
+	return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool PathfindBenchmark::pickPosition(Pathfinder *pathfinder, const Object *obj, UnsignedInt &random, Coord3D &pos)
+{
+	const IRegion2D &extent = pathfinder->m_logicalExtent;
+	const Int width = extent.hi.x - extent.lo.x + 1;
+	const Int height = extent.hi.y - extent.lo.y + 1;
+	const LocomotorSet &locomotorSet = obj->getAIUpdateInterface()->getLocomotorSet();
+	const Bool isCrusher = obj->getCrusherLevel() > 0;
+
+	for (Int i = 0; i < MAX_POSITION_ATTEMPTS; ++i)
+	{
+		const Int x = extent.lo.x + (Int)(nextRandom(random) % width);
+		const Int y = extent.lo.y + (Int)(nextRandom(random) % height);
+		if (!pathfinder->validMovementPosition(isCrusher, LAYER_GROUND, locomotorSet, x, y))
+			continue;
+
+		pos.x = ((Real)x + 0.5f) * PATHFIND_CELL_SIZE_F;
+		pos.y = ((Real)y + 0.5f) * PATHFIND_CELL_SIZE_F;
+		pos.z = TheTerrainLogic->getGroundHeight(pos.x, pos.y);
+		return TRUE;
+	}
+	return FALSE;
+}
+
+//-------------------------------------------------------------------------------------------------
+Real PathfindBenchmark::getPathLength(Path *path)
+{
+	Real length = 0.0f;
+	const PathNode *node = path->getFirstNode();
+	while (node != nullptr && node->getNext() != nullptr)
+	{
+		const Coord3D *a = node->getPosition();
+		const Coord3D *b = node->getNext()->getPosition();
+		const Real dx = b->x - a->x;
+		const Real dy = b->y - a->y;
+		length += sqrtf(dx * dx + dy * dy);
+		node = node->getNext();
+	}
+	return length;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Collects per cell the zone and, per surface, the effective zone and the block zone without and with
+// crusher, followed by the zones of the layers.
+void PathfindBenchmark::collectZones(Pathfinder *pathfinder, std::vector<zoneStorageType> &zones)
+{
+	const IRegion2D &extent = pathfinder->m_extent;
+	const PathfindZoneManager &zoneManager = pathfinder->m_zoneManager;
+	zones.clear();
+	for (Int i = extent.lo.x; i <= extent.hi.x; ++i)
+	{
+		for (Int j = extent.lo.y; j <= extent.hi.y; ++j)
+		{
+			const zoneStorageType zone = pathfinder->m_map[i][j].getZone();
+			zones.push_back(zone);
+			for (size_t s = 0; s < ARRAY_SIZE(ZoneSurfaces); ++s)
+			{
+				for (Int crusher = 0; crusher < 2; ++crusher)
+				{
+					zones.push_back(zoneManager.getEffectiveZone(ZoneSurfaces[s], crusher != 0, zone));
+					zones.push_back(zoneManager.getBlockZone(ZoneSurfaces[s], crusher != 0, i, j, pathfinder->m_map));
+				}
+			}
+		}
+	}
+	for (Int layer = 0; layer <= LAYER_LAST; ++layer)
+		zones.push_back(pathfinder->m_layers[layer].getZone());
+}
+
+//-------------------------------------------------------------------------------------------------
+// Calculates the zones of the whole map and returns the number of cells or layers whose zones differ
+// from the zones that they had before.
+Int PathfindBenchmark::compareWithCalculatedZones(Pathfinder *pathfinder)
+{
+	const size_t zonesPerCell = 1 + ARRAY_SIZE(ZoneSurfaces) * 4;
+	std::vector<zoneStorageType> repaired;
+	collectZones(pathfinder, repaired);
+	pathfinder->m_zoneManager.calculateZones(pathfinder->m_map, pathfinder->m_layers, pathfinder->m_extent);
+	std::vector<zoneStorageType> calculated;
+	collectZones(pathfinder, calculated);
+
+	Int mismatches = 0;
+	for (size_t k = 0; k < calculated.size(); k += zonesPerCell)
+	{
+		const size_t count = min(zonesPerCell, calculated.size() - k);
+		if (memcmp(&calculated[k], &repaired[k], count * sizeof(zoneStorageType)) != 0)
+			++mismatches;
+	}
+	return mismatches;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Turns seeded areas of clear cells into cliffs one after another and back again, repairs the zones
+// after every change like for a structure that is built or removed, and compares the zones with a
+// calculation of the whole map. Returns the number of cells or layers whose zones differ.
+Int PathfindBenchmark::checkZoneRepair(Pathfinder *pathfinder, UnsignedInt &random)
+{
+	const IRegion2D &extent = pathfinder->m_extent;
+	const Int width = extent.hi.x - extent.lo.x + 1;
+	const Int height = extent.hi.y - extent.lo.y + 1;
+	PathfindZoneManager &zoneManager = pathfinder->m_zoneManager;
+
+	// Start from the zones of the whole map, like after a save game was loaded.
+	zoneManager.calculateZones(pathfinder->m_map, pathfinder->m_layers, extent);
+
+	Int mismatches = 0;
+	for (Int round = 0; round < ZONE_REPAIR_ROUNDS; ++round)
+	{
+		IRegion2D areas[ZONE_REPAIR_AREAS];
+		std::vector<ICoord2D> changedCells[ZONE_REPAIR_AREAS];
+		for (Int area = 0; area < ZONE_REPAIR_AREAS; ++area)
+		{
+			IRegion2D &cellBounds = areas[area];
+			cellBounds.lo.x = extent.lo.x + (Int)(nextRandom(random) % width);
+			cellBounds.lo.y = extent.lo.y + (Int)(nextRandom(random) % height);
+			cellBounds.hi.x = min(extent.hi.x, cellBounds.lo.x + (Int)(nextRandom(random) % ZONE_REPAIR_MAX_SIZE));
+			cellBounds.hi.y = min(extent.hi.y, cellBounds.lo.y + (Int)(nextRandom(random) % ZONE_REPAIR_MAX_SIZE));
+			for (Int i = cellBounds.lo.x; i <= cellBounds.hi.x; ++i)
+			{
+				for (Int j = cellBounds.lo.y; j <= cellBounds.hi.y; ++j)
+				{
+					if (pathfinder->m_map[i][j].getType() != PathfindCell::CELL_CLEAR)
+						continue;
+					pathfinder->m_map[i][j].setType(PathfindCell::CELL_CLIFF);
+					ICoord2D cell;
+					cell.x = i;
+					cell.y = j;
+					changedCells[area].push_back(cell);
+				}
+			}
+			zoneManager.repairZones(pathfinder->m_map, pathfinder->m_layers, cellBounds, extent);
+		}
+		mismatches += compareWithCalculatedZones(pathfinder);
+
+		for (Int area = ZONE_REPAIR_AREAS - 1; area >= 0; --area)
+		{
+			for (size_t k = 0; k < changedCells[area].size(); ++k)
+			{
+				const ICoord2D &cell = changedCells[area][k];
+				pathfinder->m_map[cell.x][cell.y].setType(PathfindCell::CELL_CLEAR);
+			}
+			zoneManager.repairZones(pathfinder->m_map, pathfinder->m_layers, areas[area], extent);
+		}
+		mismatches += compareWithCalculatedZones(pathfinder);
+	}
+	return mismatches;
+}
+
+//-------------------------------------------------------------------------------------------------
+int PathfindBenchmark::run(const AsciiString &mapName, Int queryCount, UnsignedInt seed)
+{
+	// Note that we use printf here because this is run from cmd.
+	printf("Pathfind benchmark of \"%s\", %d queries, seed %u\n", mapName.str(), queryCount, seed);
+	fflush(stdout);
+
+	if (!startGame(mapName))
+	{
+		printf("Cannot load map\n");
+		return 1;
+	}
+
+	Pathfinder *pathfinder = TheAI->pathfinder();
+	const Int savedCellCount = pathfinder->m_cumulativeCellsAllocated;
+
+	// The map is classified while it loads already. Classify it again to time the terrain classification
+	// and the zone calculation alone, like forceMapRecalculation does.
+	const Int64 classifyStart = getTicks();
+	pathfinder->classifyMap();
+	const Int64 classifyTicks = getTicks() - classifyStart;
+	const ICoord2D *extent = pathfinder->getExtent();
+	printf("Classified %dx%d cells in %.2f ms\n", extent->x + 1, extent->y + 1, ticksToMs(classifyTicks));
+
+	Object *obj = createUnit();
+	if (obj == nullptr)
+	{
+		printf("Cannot create a benchmark unit\n");
+		return 1;
+	}
+	printf("Benchmark unit is %s\n", obj->getTemplate()->getName().str());
+
+	const LocomotorSet &locomotorSet = obj->getAIUpdateInterface()->getLocomotorSet();
+	const Weapon *weapon = obj->getWeaponInWeaponSlot(PRIMARY_WEAPON);
+	const Bool isCrusher = obj->getCrusherLevel() > 0;
+
+	QueryResult results[QUERY_TYPE_COUNT];
+	memset(results, 0, sizeof(results));
+
+	// The positions only depend on the seed and the map, so every build runs the same queries.
+	UnsignedInt random = seed;
+	for (Int i = 0; i < queryCount; ++i)
+	{
+		Coord3D from;
+		Coord3D to;
+		if (!pickPosition(pathfinder, obj, random, from) || !pickPosition(pathfinder, obj, random, to))
+			break;
+
+		const QueryType type = (QueryType)(i % QUERY_TYPE_COUNT);
+		obj->setPosition(&from);
+		pathfinder->m_cumulativeCellsAllocated = 0;
+
+		const Int64 start = getTicks();
+		Path *path = nullptr;
+		switch (type)
+		{
+			case QUERY_PATH:
+				path = pathfinder->findPath(obj, locomotorSet, &from, &to);
+				break;
+			case QUERY_HIERARCHICAL:
+				path = pathfinder->findHierarchicalPath(TRUE, locomotorSet, &from, &to, isCrusher);
+				break;
+			case QUERY_ATTACK:
+				path = pathfinder->findAttackPath(obj, locomotorSet, &from, nullptr, &to, weapon);
+				break;
+			case QUERY_SAFE:
+			{
+				// The threat is close by, so the unit has to move away from it.
+				Coord3D repulsor = from;
+				repulsor.x += (Real)((Int)(nextRandom(random) % 101) - 50);
+				repulsor.y += (Real)((Int)(nextRandom(random) % 101) - 50);
+				path = pathfinder->findSafePath(obj, locomotorSet, &from, &repulsor, &repulsor, SAFE_PATH_REPULSOR_RADIUS);
+				break;
+			}
+		}
+		const Int64 ticks = getTicks() - start;
+
+		QueryResult &result = results[type];
+		++result.queries;
+		result.ticks += ticks;
+		result.cells += pathfinder->m_cumulativeCellsAllocated;
+		if (path != nullptr)
+		{
+			++result.found;
+			result.length += getPathLength(path);
+			deleteInstance(path);
+		}
+	}
+
+	pathfinder->m_cumulativeCellsAllocated = savedCellCount;
+	TheGameLogic->destroyObject(obj);
+
+	printf("%14s %8s %8s %12s %10s %12s %10s\n", "query", "count", "found", "cells", "ms", "paths/s", "length");
+	QueryResult total;
+	memset(&total, 0, sizeof(total));
+	for (Int t = 0; t < QUERY_TYPE_COUNT; ++t)
+	{
+		const QueryResult &result = results[t];
+		const Real ms = ticksToMs(result.ticks);
+		printf("%14s %8d %8d %12.0f %10.2f %12.1f %10.1f\n", QueryNames[t], result.queries, result.found,
+			(double)result.cells, ms, ms > 0.0f ? result.queries * 1000.0f / ms : 0.0f,
+			result.found > 0 ? result.length / result.found : 0.0f);
+
+		total.queries += result.queries;
+		total.found += result.found;
+		total.cells += result.cells;
+		total.ticks += result.ticks;
+		total.length += result.length;
+	}
+	const Real totalMs = ticksToMs(total.ticks);
+	printf("%14s %8d %8d %12.0f %10.2f %12.1f %10.1f\n", "total", total.queries, total.found,
+		(double)total.cells, totalMs, totalMs > 0.0f ? total.queries * 1000.0f / totalMs : 0.0f,
+		total.found > 0 ? total.length / total.found : 0.0f);
+
+	if (TheGameLogic->hasPathfindOption(PATHFIND_OPTION_INCREMENTAL_ZONES))
+	{
+		const Int mismatches = checkZoneRepair(pathfinder, random);
+		printf("Zone repair check: %d cells differ from the calculated zones\n", mismatches);
+		fflush(stdout);
+		if (mismatches != 0)
+			return 1;
+	}
+	fflush(stdout);
+
+	return 0;
+}
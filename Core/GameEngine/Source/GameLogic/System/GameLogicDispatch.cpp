@@ -267,6 +267,10 @@ void GameLogic::clearGameData( Bool showScoreScreen )
 	if(TheStatsCollector)
 		TheStatsCollector->writeFileEnd();
 
+	// TheSuperHackers @feature Record the memory pool sizes that this match needed.
+	if (TheGlobalData->m_memoryPoolProfileFile.isNotEmpty())
+		TheMemoryPoolFactory->writePoolSizeProfile(TheGlobalData->m_memoryPoolProfileFile.str());
+
 	TheScriptActions->closeWindows(FALSE); // Close victory or defeat windows.
 
 	Bool shellGame = FALSE;
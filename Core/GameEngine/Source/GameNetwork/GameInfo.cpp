@@ -316,6 +316,7 @@ void GameInfo::reset()
 	m_mapSize = 0;
   m_superweaponRestriction = 0;
   m_startingCash = TheGlobalData->m_defaultStartingCash;
+	m_pathfindOptions = GetCommandLinePathfindOptions();
 
 	for (Int i=0; i<MAX_SLOTS; ++i)
 	{
@@ -891,6 +892,20 @@ Bool GameInfo::isSandbox()
 
 static const char slotListID		= 'S';
 
+UnsignedInt GetCommandLinePathfindOptions()
+{
+	UnsignedInt options = 0;
+	if (TheGlobalData->m_usePortalPathfinding)
+		options |= PATHFIND_OPTION_PORTALS;
+	if (TheGlobalData->m_usePathCache)
+		options |= PATHFIND_OPTION_PATH_CACHE;
+	if (TheGlobalData->m_useIncrementalZones)
+		options |= PATHFIND_OPTION_INCREMENTAL_ZONES;
+	if (TheGlobalData->m_useGroupFlowField)
+		options |= PATHFIND_OPTION_GROUP_FLOW_FIELD;
+	return options;
+}
+
 AsciiString GameInfoToAsciiString( const GameInfo *game )
 {
 	if (!game)
@@ -930,6 +945,15 @@ AsciiString GameInfoToAsciiString( const GameInfo *game )
 		game->getStartingCash().countMoney(), game->oldFactionsOnly() ? 'Y' : 'N' );
 #endif
 
+	// TheSuperHackers @fix The pathfinding options are only written when some are used, so that the options of
+	// other games stay readable by the retail game. A retail game rejects the options of a game that uses them.
+	if (game->getPathfindOptions() != 0)
+	{
+		AsciiString pathfindOptions;
+		pathfindOptions.format("PF=%X;", game->getPathfindOptions());
+		optionsString.concat(pathfindOptions);
+	}
+
 	//add player info for each slot
 	optionsString.concat(slotListID);
 	optionsString.concat('=');
@@ -1021,6 +1045,7 @@ Bool ParseAsciiStringToGameInfo(GameInfo *game, AsciiString options)
 	Int useStats = TRUE;
   Money startingCash = TheGlobalData->m_defaultStartingCash;
   UnsignedShort restriction = 0; // Always the default
+	UnsignedInt pathfindOptions = 0; // Not written when none are used
 
 	Bool sawMap = FALSE;
 	Bool sawMapCRC = FALSE;
@@ -1140,6 +1165,17 @@ Bool ParseAsciiStringToGameInfo(GameInfo *game, AsciiString options)
       oldFactionsOnly = ( val.compareNoCase( "Y" ) == 0 );
       sawOldFactions = TRUE;
     }
+		else if (key.compare("PF") == 0)
+		{
+			pathfindOptions = 0;
+			sscanf(val.str(), "%X", &pathfindOptions);
+			if ((pathfindOptions & ~(UnsignedInt)PATHFIND_OPTION_ALL) != 0)
+			{
+				optionsOk = false;
+				DEBUG_LOG(("ParseAsciiStringToGameInfo - saw unknown pathfinding options %X; quitting", pathfindOptions));
+				break;
+			}
+		}
 		else if (key.getLength() == 1 && *key.str() == slotListID)
 		{
 			sawSlotlist = true;
@@ -1508,6 +1544,7 @@ Bool ParseAsciiStringToGameInfo(GameInfo *game, AsciiString options)
 		game->setSuperweaponRestriction(restriction);
 		game->setStartingCash(startingCash);
 		game->setOldFactionsOnly(oldFactionsOnly);
+		game->setPathfindOptions(pathfindOptions);
 
 		return true;
 	}
@@ -66,6 +66,12 @@ File* StdBIGFile::openFile( const Char *filename, Int access )
 		return nullptr;
 	}
 
+	// TheSuperHackers @performance Read only files point straight into the mapping of the archive.
+	File *mappedFile = openMappedFile(fileInfo, access);
+	if (mappedFile != nullptr) {
+		return mappedFile;
+	}
+
 	RAMFile *ramFile = nullptr;
 
 	if (BitIsSet(access, File::STREAMING))
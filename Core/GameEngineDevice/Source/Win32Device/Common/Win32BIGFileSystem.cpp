@@ -79,8 +79,24 @@ void Win32BIGFileSystem::update() {
 void Win32BIGFileSystem::postProcessLoad() {
 }
 
-ArchiveFile * Win32BIGFileSystem::openArchiveFile(const Char *filename) {
-	File *fp = TheLocalFileSystem->openFile(filename, File::READ | File::BINARY);
+// TheSuperHackers @performance Makes sure that the listing holds at least size bytes of the directory listing
+// and reads ahead if it does not, in case the header of the archive gives the wrong listing size.
+static Bool readDirectoryListing(File *fp, std::vector<char> &listing, size_t size)
+{
+	const size_t oldSize = listing.size();
+	if (oldSize >= size) {
+		return TRUE;
+	}
+
+	const size_t newSize = (oldSize * 2 > size) ? oldSize * 2 : size;
+	listing.resize(newSize);
+	const Int bytesRead = fp->read(&listing[oldSize], (Int)(newSize - oldSize));
+	listing.resize(oldSize + (bytesRead > 0 ? bytesRead : 0));
+	return listing.size() >= size;
+}
+
+ArchiveFile * Win32BIGFileSystem::tryOpenArchiveFile(const Char *filename, AsciiString &error) {
+	File *fp = openLocalFile(filename);
 	AsciiString archiveFileName;
 	archiveFileName = filename;
 	archiveFileName.toLower();
@@ -90,7 +106,7 @@ ArchiveFile * Win32BIGFileSystem::openArchiveFile(const Char *filename) {
 	DEBUG_LOG(("Win32BIGFileSystem::openArchiveFile - opening BIG file %s", filename));
 
 	if (fp == nullptr) {
-		DEBUG_CRASH(("Could not open archive file %s for parsing", filename));
+		error.format("Could not open archive file %s for parsing", filename);
 		return nullptr;
 	}
 
@@ -99,7 +115,7 @@ ArchiveFile * Win32BIGFileSystem::openArchiveFile(const Char *filename) {
 	fp->read(buffer, 4); // read the "BIG" at the beginning of the file.
 	buffer[4] = 0;
 	if (strcmp(buffer, BIGFileIdentifier) != 0) {
-		DEBUG_CRASH(("Error reading BIG file identifier in file %s", filename));
+		error.format("Error reading BIG file identifier in file %s", filename);
 		fp->close();
 		fp = nullptr;
 		return nullptr;
@@ -124,18 +140,40 @@ ArchiveFile * Win32BIGFileSystem::openArchiveFile(const Char *filename) {
 //		buffer[(4-i)-1] = t;
 //	}
 
+	// TheSuperHackers @performance Read the whole directory listing at once, instead of every path name one
+	// byte at a time. The listing ends where the first file starts, which the header stores at 0x0C.
+	Int headerSize = 0;
+	fp->read(&headerSize, 4);
+	headerSize = betoh(headerSize);
+
+	Int listingSize = headerSize - 0x10;
+	if (numLittleFiles > 0 && listingSize / (8 + _MAX_PATH) > numLittleFiles) {
+		listingSize = numLittleFiles * (8 + _MAX_PATH);
+	}
+	std::vector<char> listing;
+
 	// seek to the beginning of the directory listing.
 	fp->seek(0x10, File::START);
+	readDirectoryListing(fp, listing, listingSize > 0 ? listingSize : 0);
+
 	// read in each directory listing.
 	ArchivedFileInfo *fileInfo = NEW ArchivedFileInfo;
 	// TheSuperHackers @fix Mauller 23/04/2025 Create new file handle when necessary to prevent memory leak
 	ArchiveFile *archiveFile = NEW Win32BIGFile(filename, AsciiString::TheEmptyString);
+	size_t listingIndex = 0;
 
 	for (Int i = 0; i < numLittleFiles; ++i) {
+		// the offset, the size and at least the end of the path name.
+		if (!readDirectoryListing(fp, listing, listingIndex + 9)) {
+			error.format("Directory listing of archive file %s is truncated", filename);
+			break;
+		}
+
 		Int filesize = 0;
 		Int fileOffset = 0;
-		fp->read(&fileOffset, 4);
-		fp->read(&filesize, 4);
+		memcpy(&fileOffset, &listing[listingIndex], 4);
+		memcpy(&filesize, &listing[listingIndex + 4], 4);
+		listingIndex += 8;
 
 		filesize = betoh(filesize);
 		fileOffset = betoh(fileOffset);
@@ -145,11 +183,22 @@ ArchiveFile * Win32BIGFileSystem::openArchiveFile(const Char *filename) {
 		fileInfo->m_size = filesize;
 
 		// read in the path name of the file.
-		Int pathIndex = -1;
-		do {
-			++pathIndex;
-			fp->read(buffer + pathIndex, 1);
-		} while (buffer[pathIndex] != 0);
+		size_t pathEnd = listingIndex;
+		while (listing[pathEnd] != 0 && readDirectoryListing(fp, listing, pathEnd + 2)) {
+			++pathEnd;
+		}
+		if (listing[pathEnd] != 0) {
+			error.format("Directory listing of archive file %s is truncated", filename);
+			break;
+		}
+
+		Int pathIndex = (Int)(pathEnd - listingIndex);
+		if (pathIndex > _MAX_PATH - 1) {
+			pathIndex = _MAX_PATH - 1;
+		}
+		memcpy(buffer, &listing[listingIndex], pathIndex);
+		buffer[pathIndex] = 0;
+		listingIndex = pathEnd + 1;
 
 		Int filenameIndex = pathIndex;
 		while ((filenameIndex >= 0) && (buffer[filenameIndex] != '\\') && (buffer[filenameIndex] != '/')) {
@@ -213,7 +262,7 @@ Bool Win32BIGFileSystem::loadBigFilesFromDirectory(AsciiString dir, AsciiString
 	FilenameList filenameList;
 	TheLocalFileSystem->getFileListInDirectory(dir, "", fileMask, filenameList, TRUE);
 
-	Bool actuallyAdded = FALSE;
+	std::vector<AsciiString> archiveFilenames;
 	FilenameListIter it = filenameList.begin();
 	while (it != filenameList.end()) {
 #if RTS_ZEROHOUR
@@ -226,18 +275,10 @@ Bool Win32BIGFileSystem::loadBigFilesFromDirectory(AsciiString dir, AsciiString
 		}
 #endif
 
-		ArchiveFile *archiveFile = openArchiveFile((*it).str());
-
-		if (archiveFile != nullptr) {
-			DEBUG_LOG(("Win32BIGFileSystem::loadBigFilesFromDirectory - loading %s into the directory tree.", (*it).str()));
-			loadIntoDirectoryTree(archiveFile, overwrite);
-			m_archiveFileMap[(*it)] = archiveFile;
-			DEBUG_LOG(("Win32BIGFileSystem::loadBigFilesFromDirectory - %s inserted into the archive file map.", (*it).str()));
-			actuallyAdded = TRUE;
-		}
-
+		archiveFilenames.push_back(*it);
 		it++;
 	}
 
-	return actuallyAdded;
+	// TheSuperHackers @performance Open the archives in parallel, and load them in the order of the list.
+	return loadArchiveFiles(archiveFilenames, overwrite);
 }
@@ -17,6 +17,7 @@
 */
 
 #include "debug.h"
+#include "DeepCRCDiff.h"
 #include "expander.h"
 #include "KVPair.h"
 #include "misc.h"
@@ -187,6 +188,12 @@ void dumpQueued()
 
 int main(int argc, char *argv[])
 {
+	// TheSuperHackers @feature Compare two deep CRC dumps per section and per object.
+	if (argc == 4 && strcmp(argv[1], "-deep") == 0)
+	{
+		return deepCRCDiff(argv[2], argv[3]);
+	}
+
 	atexit(exitWait);
 	const char *inFname[2];
 	const char *outFname = "out.html";
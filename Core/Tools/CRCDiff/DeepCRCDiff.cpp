@@ -0,0 +1,401 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ---------------------------------------------------------------------------
+// File: DeepCRCDiff.cpp
+// Description: Compares two deep CRC dumps per section and per object.
+// ---------------------------------------------------------------------------
+
+#include "DeepCRCDiff.h"
+#include <map>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//=============================================================================
+
+// The index file lines are:
+//   L <offset> <text>   label, such as a section marker, an object or a string of the data
+//   B <offset>          begin of a snapshot
+//   E <offset>          end of a snapshot
+// The offsets refer to the data of the dump.
+
+struct DumpLabel
+{
+	unsigned int offset;
+	std::string text;
+};
+
+struct DumpRange
+{
+	unsigned int start;
+	unsigned int end;
+	int depth;
+};
+
+struct DumpSection
+{
+	std::string name;
+	unsigned int start;
+	unsigned int end;
+};
+
+struct DumpObject
+{
+	unsigned int id;
+	std::string name;
+	unsigned int start;
+	unsigned int end;
+};
+
+struct Dump
+{
+	std::string data;
+	std::vector<DumpLabel> labels;
+	std::vector<DumpRange> snapshots;
+	std::vector<DumpSection> sections;
+	std::vector<DumpObject> objects;
+};
+
+static const char *const s_objectsSection = "MARKER:Objects";
+static const int s_maxReportedObjects = 100;
+
+//=============================================================================
+
+static bool readDumpData(const char *fname, std::string& data)
+{
+	FILE *fp = fopen(fname, "rb");
+	if (!fp)
+		return false;
+
+	char buf[4096];
+	size_t numRead;
+	while ((numRead = fread(buf, 1, sizeof(buf), fp)) > 0)
+	{
+		data.append(buf, numRead);
+	}
+
+	fclose(fp);
+	return true;
+}
+
+//=============================================================================
+
+static bool readDump(const char *fname, Dump& dump)
+{
+	if (!readDumpData(fname, dump.data))
+	{
+		printf("could not open %s\n", fname);
+		return false;
+	}
+
+	std::string indexName = fname;
+	indexName.append(".idx");
+	FILE *fp = fopen(indexName.c_str(), "rt");
+	if (!fp)
+	{
+		printf("could not open %s\n", indexName.c_str());
+		return false;
+	}
+
+	std::vector<unsigned int> openSnapshots;
+	bool hasPendingObject = false;
+	DumpObject pendingObject;
+
+	char line[1024];
+	while (fgets(line, sizeof(line), fp) != nullptr)
+	{
+		int len = strlen(line);
+		if (len > 0 && line[len-1] == '\n')
+			line[len-1] = '\0';
+
+		char type;
+		unsigned int offset;
+		int textPos = 0;
+		if (sscanf(line, "%c %u %n", &type, &offset, &textPos) < 2)
+			continue;
+
+		if (type == 'L')
+		{
+			DumpLabel label;
+			label.offset = offset;
+			label.text = line + textPos;
+			dump.labels.push_back(label);
+
+			if (!openSnapshots.empty())
+				continue;
+
+			if (label.text.compare(0, 7, "MARKER:") == 0)
+			{
+				if (!dump.sections.empty())
+					dump.sections.back().end = offset;
+
+				DumpSection section;
+				section.name = label.text;
+				section.start = offset;
+				section.end = offset;
+				dump.sections.push_back(section);
+			}
+			else if (label.text.compare(0, 7, "Object ") == 0)
+			{
+				char name[1024];
+				name[0] = '\0';
+				if (sscanf(label.text.c_str(), "Object %u %1023s", &pendingObject.id, name) >= 1)
+				{
+					pendingObject.name = name;
+					hasPendingObject = true;
+				}
+			}
+		}
+		else if (type == 'B')
+		{
+			openSnapshots.push_back(offset);
+		}
+		else if (type == 'E' && !openSnapshots.empty())
+		{
+			DumpRange range;
+			range.start = openSnapshots.back();
+			range.end = offset;
+			openSnapshots.pop_back();
+			range.depth = openSnapshots.size();
+			dump.snapshots.push_back(range);
+
+			if (openSnapshots.empty() && hasPendingObject)
+			{
+				pendingObject.start = range.start;
+				pendingObject.end = range.end;
+				dump.objects.push_back(pendingObject);
+				hasPendingObject = false;
+			}
+		}
+	}
+
+	fclose(fp);
+
+	if (!dump.sections.empty())
+		dump.sections.back().end = dump.data.size();
+
+	return true;
+}
+
+//=============================================================================
+
+// Returns the offset of the first different byte, relative to the start of
+// the ranges, or -1 if the ranges are equal.
+static int findFirstDifference(const Dump& dump1, unsigned int start1, unsigned int end1,
+															 const Dump& dump2, unsigned int start2, unsigned int end2)
+{
+	unsigned int size1 = end1 - start1;
+	unsigned int size2 = end2 - start2;
+	unsigned int size = size1 < size2 ? size1 : size2;
+
+	const char *data1 = dump1.data.data() + start1;
+	const char *data2 = dump2.data.data() + start2;
+	for (unsigned int i = 0; i < size; ++i)
+	{
+		if (data1[i] != data2[i])
+			return i;
+	}
+
+	if (size1 != size2)
+		return size;
+
+	return -1;
+}
+
+//=============================================================================
+
+// Describes where 'offset' lies within [start, end): the innermost nested
+// snapshot and the closest label before it.
+static std::string describeOffset(const Dump& dump, unsigned int start, unsigned int end, unsigned int offset)
+{
+	char buf[256];
+	sprintf(buf, "+0x%X", offset - start);
+	std::string desc = buf;
+
+	const DumpRange *innermost = nullptr;
+	for (size_t i = 0; i < dump.snapshots.size(); ++i)
+	{
+		const DumpRange& range = dump.snapshots[i];
+		if (range.start < start || range.end > end)
+			continue;
+		if (range.start == start && range.end == end)
+			continue;
+		if (offset < range.start || offset >= range.end)
+			continue;
+		if (innermost == nullptr || range.depth > innermost->depth)
+			innermost = &range;
+	}
+
+	if (innermost != nullptr)
+	{
+		sprintf(buf, ", at +0x%X of the nested snapshot at +0x%X (depth %d)",
+			offset - innermost->start, innermost->start - start, innermost->depth);
+		desc.append(buf);
+	}
+
+	const DumpLabel *closest = nullptr;
+	for (size_t i = 0; i < dump.labels.size(); ++i)
+	{
+		const DumpLabel& label = dump.labels[i];
+		if (label.offset < start || label.offset > offset)
+			continue;
+		closest = &label;
+	}
+
+	if (closest != nullptr)
+	{
+		desc.append(", after \"");
+		desc.append(closest->text);
+		desc.append("\"");
+	}
+
+	return desc;
+}
+
+//=============================================================================
+
+static int diffObjects(const Dump& dump1, const Dump& dump2)
+{
+	std::map<unsigned int, size_t> objects2;
+	for (size_t i = 0; i < dump2.objects.size(); ++i)
+	{
+		objects2[dump2.objects[i].id] = i;
+	}
+
+	int numDiffs = 0;
+	std::map<unsigned int, bool> seen;
+	for (size_t i = 0; i < dump1.objects.size(); ++i)
+	{
+		const DumpObject& obj1 = dump1.objects[i];
+		seen[obj1.id] = true;
+
+		std::map<unsigned int, size_t>::const_iterator it = objects2.find(obj1.id);
+		if (it == objects2.end())
+		{
+			if (++numDiffs <= s_maxReportedObjects)
+				printf("  Object %u (%s): only in first dump\n", obj1.id, obj1.name.c_str());
+			continue;
+		}
+
+		const DumpObject& obj2 = dump2.objects[it->second];
+		int diff = findFirstDifference(dump1, obj1.start, obj1.end, dump2, obj2.start, obj2.end);
+		if (diff < 0)
+			continue;
+
+		if (++numDiffs <= s_maxReportedObjects)
+		{
+			std::string desc = describeOffset(dump1, obj1.start, obj1.end, obj1.start + diff);
+			printf("  Object %u (%s): differs at %s\n", obj1.id, obj1.name.c_str(), desc.c_str());
+			if (obj1.name != obj2.name)
+				printf("    template is %s in second dump\n", obj2.name.c_str());
+		}
+	}
+
+	for (size_t i = 0; i < dump2.objects.size(); ++i)
+	{
+		const DumpObject& obj2 = dump2.objects[i];
+		if (seen.find(obj2.id) != seen.end())
+			continue;
+
+		if (++numDiffs <= s_maxReportedObjects)
+			printf("  Object %u (%s): only in second dump\n", obj2.id, obj2.name.c_str());
+	}
+
+	if (numDiffs > s_maxReportedObjects)
+		printf("  ... and %d more objects\n", numDiffs - s_maxReportedObjects);
+
+	printf("  %d of %d objects differ\n", numDiffs, (int)dump1.objects.size());
+	return numDiffs;
+}
+
+//=============================================================================
+
+int deepCRCDiff(const char *fname1, const char *fname2)
+{
+	Dump dump1, dump2;
+	if (!readDump(fname1, dump1) || !readDump(fname2, dump2))
+		return 2;
+
+	printf("Comparing %s (%u bytes) with %s (%u bytes)\n",
+		fname1, (unsigned int)dump1.data.size(), fname2, (unsigned int)dump2.data.size());
+
+	int numDiffSections = 0;
+	for (size_t i = 0; i < dump1.sections.size(); ++i)
+	{
+		const DumpSection& section1 = dump1.sections[i];
+		const DumpSection *section2 = nullptr;
+		for (size_t j = 0; j < dump2.sections.size(); ++j)
+		{
+			if (dump2.sections[j].name == section1.name)
+			{
+				section2 = &dump2.sections[j];
+				break;
+			}
+		}
+
+		if (section2 == nullptr)
+		{
+			printf("%s: only in first dump\n", section1.name.c_str());
+			++numDiffSections;
+			continue;
+		}
+
+		int diff = findFirstDifference(dump1, section1.start, section1.end, dump2, section2->start, section2->end);
+		if (diff < 0)
+		{
+			printf("%s: same\n", section1.name.c_str());
+			continue;
+		}
+
+		++numDiffSections;
+		if (section1.name == s_objectsSection)
+		{
+			printf("%s: differs\n", section1.name.c_str());
+			diffObjects(dump1, dump2);
+		}
+		else
+		{
+			std::string desc = describeOffset(dump1, section1.start, section1.end, section1.start + diff);
+			printf("%s: differs at %s\n", section1.name.c_str(), desc.c_str());
+		}
+	}
+
+	for (size_t j = 0; j < dump2.sections.size(); ++j)
+	{
+		bool found = false;
+		for (size_t i = 0; i < dump1.sections.size(); ++i)
+		{
+			if (dump1.sections[i].name == dump2.sections[j].name)
+			{
+				found = true;
+				break;
+			}
+		}
+
+		if (!found)
+		{
+			printf("%s: only in second dump\n", dump2.sections[j].name.c_str());
+			++numDiffSections;
+		}
+	}
+
+	return numDiffSections != 0 ? 1 : 0;
+}
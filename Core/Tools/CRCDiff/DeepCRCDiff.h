@@ -0,0 +1,31 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ---------------------------------------------------------------------------
+// File: DeepCRCDiff.h
+// Description: Compares two deep CRC dumps per section and per object.
+// The dumps are written by XferDeepCRC together with an index file
+// '<dump>.idx', see -replayBisect.
+// ---------------------------------------------------------------------------
+
+#pragma once
+
+// Prints the sections, objects and nested snapshots that differ between
+// the two dumps. Returns 0 if the dumps are equal, 1 if they differ and
+// 2 if a dump or its index cannot be read.
+int deepCRCDiff(const char *fname1, const char *fname2);
@@ -0,0 +1,278 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ---------------------------------------------------------------------------
+// File: pathfindGridBenchmark.cpp
+// Description: Compares the unit checks of Pathfinder::checkForMovement on the
+// pathfind cells with the checks on the parallel array of ground cell flags.
+//
+// This is a synthetic model, not the game code: it does not link GameEngine, so
+// BenchCell and BenchGrid copy the layout of PathfindCell and the loops of
+// checkForMovement, and the units and search front are generated. It measures
+// the memory access pattern of both checks, not the Pathfinder itself, and its
+// numbers do not carry over to a real map without profiling the game.
+// ---------------------------------------------------------------------------
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "Lib/BaseType.h"
+
+//=============================================================================
+
+static const Int DEFAULT_STEP_COUNT = 2000000;
+// Cells per side, from a small skirmish map to beyond the largest shipped maps.
+static const Int s_gridSizes[] = { 200, 400, 800 };
+static const Int s_radii[] = { 0, 1, 2 };
+
+enum
+{
+	NO_UNITS = 0x00,
+	UNIT_GOAL = 0x01,
+	UNIT_PRESENT_MOVING = 0x02,
+	UNIT_PRESENT_FIXED = 0x03
+};
+
+// A copy of the members of PathfindCell, so that it has the same size. It must be kept in sync by hand.
+struct BenchCell
+{
+	void *m_info;
+	UnsignedInt m_obstacleID;
+	UnsignedInt m_blockedByAlly : 1;
+	UnsignedInt m_obstacleIsFence : 1;
+	UnsignedInt m_obstacleIsTransparent : 1;
+	UnsignedShort m_zone : 14;
+	UnsignedShort m_aircraftGoal : 1;
+	UnsignedShort m_pinched : 1;
+	UnsignedByte m_type : 4;
+	UnsignedByte m_flags : 4;
+	UnsignedByte m_connectsToLayer : 4;
+	UnsignedByte m_layer : 4;
+};
+
+//=============================================================================
+
+class BenchGrid
+{
+public:
+
+	BenchGrid(Int size) : m_size(size)
+	{
+		m_cells.resize(size * size);
+		memset(&m_cells[0], 0, m_cells.size() * sizeof(BenchCell));
+		m_map.resize(size);
+		for (Int i = 0; i < size; ++i)
+			m_map[i] = &m_cells[i * size];
+		m_flags.resize(size * size, NO_UNITS);
+	}
+
+	void setFlags(Int x, Int y, UnsignedByte flags)
+	{
+		m_map[x][y].m_flags = flags;
+		m_flags[x * m_size + y] = flags;
+	}
+
+	Int getSize() const { return m_size; }
+
+	BenchCell *getCell(Int x, Int y)
+	{
+		if (x >= 0 && x < m_size && y >= 0 && y < m_size)
+			return &m_map[x][y];
+		return nullptr;
+	}
+
+	// The loop of checkForMovement before the parallel array of flags.
+	UnsignedInt checkCells(Int x, Int y, Int radius)
+	{
+		UnsignedInt units = 0;
+		for (Int i = x - radius; i <= x + radius; ++i)
+		{
+			for (Int j = y - radius; j <= y + radius; ++j)
+			{
+				BenchCell *cell = getCell(i, j);
+				if (!cell)
+					return 0;
+				if (cell->m_flags == NO_UNITS)
+					continue;
+				units += cell->m_flags;
+			}
+		}
+		return units;
+	}
+
+	// The loop of checkForMovement with the parallel array of flags.
+	UnsignedInt checkFlags(Int x, Int y, Int radius)
+	{
+		const UnsignedByte *flags = nullptr;
+		if (radius > 0 && x - radius >= 0 && x + radius < m_size && y - radius >= 0 && y + radius < m_size)
+			flags = &m_flags[0];
+
+		UnsignedInt units = 0;
+		for (Int i = x - radius; i <= x + radius; ++i)
+		{
+			for (Int j = y - radius; j <= y + radius; ++j)
+			{
+				if (flags && flags[i * m_size + j] == NO_UNITS)
+					continue;
+				BenchCell *cell = getCell(i, j);
+				if (!cell)
+					return 0;
+				if (cell->m_flags == NO_UNITS)
+					continue;
+				units += cell->m_flags;
+			}
+		}
+		return units;
+	}
+
+private:
+
+	Int m_size;
+	std::vector<BenchCell> m_cells;
+	std::vector<BenchCell *> m_map;
+	std::vector<UnsignedByte> m_flags;
+};
+
+//=============================================================================
+
+static UnsignedInt hashValue(UnsignedInt a, UnsignedInt b)
+{
+	UnsignedInt h = a * 0x9E3779B1u ^ (b + 0x7F4A7C15u);
+	h ^= h >> 15;
+	h *= 0x85EBCA6Bu;
+	h ^= h >> 13;
+	return h;
+}
+
+// Places groups of units like in a match: most of the map is empty, some areas are crowded.
+static void placeUnits(BenchGrid &grid)
+{
+	const Int size = grid.getSize();
+	const Int groupCount = size * size / 2000;
+	for (Int g = 0; g < groupCount; ++g)
+	{
+		const Int cx = hashValue(g, 1) % size;
+		const Int cy = hashValue(g, 2) % size;
+		for (Int u = 0; u < 30; ++u)
+		{
+			const Int x = cx + (Int)(hashValue(g, u + 3) % 15) - 7;
+			const Int y = cy + (Int)(hashValue(g, u + 50) % 15) - 7;
+			if (x >= 0 && x < size && y >= 0 && y < size)
+				grid.setFlags(x, y, (UnsignedByte)(UNIT_GOAL + hashValue(x, y) % 3));
+		}
+	}
+}
+
+struct BenchResult
+{
+	double milliseconds;
+	UnsignedInt checksum;
+};
+
+// Walks across the grid like the search front of the pathfinder and checks the neighbors of every cell.
+template <Bool UseFlags>
+static BenchResult runBenchmark(BenchGrid &grid, Int radius, Int stepCount)
+{
+	static const Int delta[8][2] = { {1,0}, {0,1}, {-1,0}, {0,-1}, {1,1}, {-1,1}, {-1,-1}, {1,-1} };
+	const Int size = grid.getSize();
+
+	BenchResult result;
+	result.checksum = 0;
+
+	LARGE_INTEGER start, end, freq;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&start);
+
+	Int x = size / 2;
+	Int y = size / 2;
+	for (Int step = 0; step < stepCount; ++step)
+	{
+		for (Int n = 0; n < 8; ++n)
+		{
+			if (UseFlags)
+				result.checksum += grid.checkFlags(x + delta[n][0], y + delta[n][1], radius);
+			else
+				result.checksum += grid.checkCells(x + delta[n][0], y + delta[n][1], radius);
+		}
+
+		// The search front mostly moves on to a neighbor, sometimes it continues elsewhere.
+		const UnsignedInt h = hashValue(step, 7);
+		if (h % 64 == 0)
+		{
+			x = (h >> 8) % size;
+			y = (h >> 20) % size;
+		}
+		else
+		{
+			x += delta[h % 8][0];
+			y += delta[h % 8][1];
+			if (x < 0 || x >= size) x = size / 2;
+			if (y < 0 || y >= size) y = size / 2;
+		}
+	}
+
+	QueryPerformanceCounter(&end);
+	result.milliseconds = (double)(end.QuadPart - start.QuadPart) * 1000.0 / (double)freq.QuadPart;
+	return result;
+}
+
+//=============================================================================
+
+int main(int argc, char *argv[])
+{
+	Int stepCount = DEFAULT_STEP_COUNT;
+	if (argc > 1)
+		stepCount = atoi(argv[1]);
+	if (stepCount <= 0)
+	{
+		printf("usage: pathfindgridbenchmark [steps]\n");
+		return 2;
+	}
+
+	printf("Synthetic model of the pathfind grid, not the game code\n");
+	printf("Modeled pathfind cell is %d bytes, checking 8 neighbors at %d steps\n", (Int)sizeof(BenchCell), stepCount);
+	printf("%10s %8s %12s %12s %8s\n", "grid", "radius", "cells ms", "flags ms", "speedup");
+
+	int exitCode = 0;
+	for (size_t i = 0; i < sizeof(s_gridSizes) / sizeof(s_gridSizes[0]); ++i)
+	{
+		BenchGrid grid(s_gridSizes[i]);
+		placeUnits(grid);
+
+		for (size_t r = 0; r < sizeof(s_radii) / sizeof(s_radii[0]); ++r)
+		{
+			BenchResult cells = runBenchmark<false>(grid, s_radii[r], stepCount);
+			BenchResult flags = runBenchmark<true>(grid, s_radii[r], stepCount);
+
+			printf("%6dx%-4d %8d %12.2f %12.2f %7.2fx\n", grid.getSize(), grid.getSize(), s_radii[r],
+				cells.milliseconds, flags.milliseconds, cells.milliseconds / flags.milliseconds);
+
+			if (cells.checksum != flags.checksum)
+			{
+				printf("  the checks found different units: checksum %08X vs %08X\n", cells.checksum, flags.checksum);
+				exitCode = 1;
+			}
+		}
+	}
+
+	return exitCode;
+}
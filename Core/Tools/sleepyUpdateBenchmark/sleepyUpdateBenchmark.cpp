@@ -0,0 +1,332 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ---------------------------------------------------------------------------
+// File: sleepyUpdateBenchmark.cpp
+// Description: Compares the binary heap of GameLogic with the timing wheel
+// for scheduling sleepy update modules, see RETAIL_COMPATIBLE_SLEEPY_UPDATES.
+// ---------------------------------------------------------------------------
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "Lib/BaseType.h"
+#include "Common/TimingWheel.h"
+
+//=============================================================================
+
+static const UnsignedInt SLEEP_FOREVER = 0x3fffffff;	// UPDATE_SLEEP_FOREVER
+static const Int DEFAULT_FRAME_COUNT = 30 * 60 * 2;
+static const Int s_moduleCounts[] = { 1000, 10000, 50000 };
+
+// Stands in for an UpdateModule. The frame and phase are packed like UpdateModule::m_nextCallFrameAndPhase.
+struct BenchModule
+{
+	UnsignedInt m_nextCallFrameAndPhase;
+	Int m_indexInLogic;
+	UnsignedInt m_id;
+
+	UnsignedInt friend_getPriority() const { return m_nextCallFrameAndPhase; }
+	UnsignedInt friend_getNextCallFrame() const { return m_nextCallFrameAndPhase >> 2; }
+	Int friend_getIndexInLogic() const { return m_indexInLogic; }
+	void friend_setIndexInLogic(Int index) { m_indexInLogic = index; }
+	void friend_setNextCallFrame(UnsignedInt frame)
+	{
+		if (frame > SLEEP_FOREVER)
+			frame = SLEEP_FOREVER;
+		m_nextCallFrameAndPhase = (frame << 2) | (m_id % 3);
+	}
+};
+
+typedef BenchModule *BenchModulePtr;
+
+//=============================================================================
+
+// The priority queue of GameLogic, reduced to the operations of GameLogic::update and
+// GameLogic::friend_awakenUpdateModule.
+class BenchHeap
+{
+public:
+
+	void push(BenchModulePtr u)
+	{
+		m_sleepyUpdates.push_back(u);
+		u->friend_setIndexInLogic(m_sleepyUpdates.size() - 1);
+		rebalanceParent(m_sleepyUpdates.size() - 1);
+	}
+
+	BenchModulePtr peek(UnsignedInt now) const
+	{
+		if (m_sleepyUpdates.empty())
+			return nullptr;
+		BenchModulePtr u = m_sleepyUpdates.front();
+		return u->friend_getNextCallFrame() > now ? nullptr : u;
+	}
+
+	void reschedule(BenchModulePtr u)
+	{
+		Int i = rebalanceParent(u->friend_getIndexInLogic());
+		rebalanceChild(i);
+	}
+
+private:
+
+	static Bool isLowerPriority(const BenchModulePtr a, const BenchModulePtr b)
+	{
+		return a->friend_getPriority() > b->friend_getPriority();
+	}
+
+	Int rebalanceParent(Int i)
+	{
+		Int parent = ((i+1)>>1)-1;
+		while (parent >= 0 && isLowerPriority(m_sleepyUpdates[parent], m_sleepyUpdates[i]))
+		{
+			BenchModulePtr a = m_sleepyUpdates[parent];
+			BenchModulePtr b = m_sleepyUpdates[i];
+			m_sleepyUpdates[i] = a;
+			m_sleepyUpdates[parent] = b;
+			a->friend_setIndexInLogic(i);
+			b->friend_setIndexInLogic(parent);
+			i = parent;
+			parent = ((parent+1)>>1)-1;
+		}
+		return i;
+	}
+
+	Int rebalanceChild(Int i)
+	{
+		Int sz = m_sleepyUpdates.size();
+		Int child = (i<<1)+1;
+		while (child < sz)
+		{
+			if (child < sz-1 && isLowerPriority(m_sleepyUpdates[child], m_sleepyUpdates[child+1]))
+				++child;
+			if (!isLowerPriority(m_sleepyUpdates[i], m_sleepyUpdates[child]))
+				break;
+			BenchModulePtr a = m_sleepyUpdates[child];
+			BenchModulePtr b = m_sleepyUpdates[i];
+			m_sleepyUpdates[i] = a;
+			m_sleepyUpdates[child] = b;
+			a->friend_setIndexInLogic(i);
+			b->friend_setIndexInLogic(child);
+			i = child;
+			child = (i<<1)+1;
+		}
+		return i;
+	}
+
+	std::vector<BenchModulePtr> m_sleepyUpdates;
+};
+
+//=============================================================================
+
+static UnsignedInt hashValue(UnsignedInt a, UnsignedInt b)
+{
+	UnsignedInt h = a * 0x9E3779B1u ^ (b + 0x7F4A7C15u);
+	h ^= h >> 15;
+	h *= 0x85EBCA6Bu;
+	h ^= h >> 13;
+	return h;
+}
+
+// The sleep time only depends on the module and the frame, so that both queues
+// wake the same modules in every frame, even if they order equal priorities differently.
+static UnsignedInt getSleepTime(const BenchModule &module, UnsignedInt frame)
+{
+	const UnsignedInt h = hashValue(module.m_id, frame);
+	const UnsignedInt pick = h % 100;
+	if (pick < 50)
+		return 1;
+	if (pick < 80)
+		return 2 + (h >> 8) % 30;
+	if (pick < 97)
+		return 30 + (h >> 8) % 300;
+	if (pick < 99)
+		return 300 + (h >> 8) % 30000;
+	return SLEEP_FOREVER;
+}
+
+struct BenchResult
+{
+	double milliseconds;
+	UnsignedInt wakeCount;
+	UnsignedInt checksum;
+};
+
+template <typename Queue>
+static BenchResult runBenchmark(Int moduleCount, Int frameCount)
+{
+	std::vector<BenchModule> modules(moduleCount);
+	for (Int i = 0; i < moduleCount; ++i)
+	{
+		modules[i].m_id = i;
+		modules[i].m_indexInLogic = -1;
+		modules[i].friend_setNextCallFrame(1 + hashValue(i, 0) % 30);
+	}
+
+	Queue queue;
+	for (Int i = 0; i < moduleCount; ++i)
+		queue.push(&modules[i]);
+
+	BenchResult result;
+	result.wakeCount = 0;
+	result.checksum = 0;
+
+	LARGE_INTEGER start, end, freq;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&start);
+
+	for (UnsignedInt now = 1; now <= (UnsignedInt)frameCount; ++now)
+	{
+		// some modules are woken up by others, like with setWakeFrame
+		for (Int i = 0; i < moduleCount / 100; ++i)
+		{
+			BenchModule &module = modules[hashValue(now, i) % moduleCount];
+			module.friend_setNextCallFrame(now + 1 + hashValue(i, now) % 10);
+			queue.reschedule(&module);
+		}
+
+		while (BenchModulePtr u = queue.peek(now))
+		{
+			result.checksum += hashValue(u->m_id, now);
+			++result.wakeCount;
+			u->friend_setNextCallFrame(now + getSleepTime(*u, now));
+			queue.reschedule(u);
+		}
+	}
+
+	QueryPerformanceCounter(&end);
+	result.milliseconds = (double)(end.QuadPart - start.QuadPart) * 1000.0 / (double)freq.QuadPart;
+	return result;
+}
+
+//=============================================================================
+
+// Checks that the timing wheel wakes modules of equal priority in the order in which they were pushed or
+// rescheduled. The modules are due far beyond the reach of the far lists, and are pushed over the whole
+// time, so that they arrive through the overflow list, the far lists and the near lists.
+static Bool testEqualPriorityOrder()
+{
+	const Int moduleCount = 3000;
+	const UnsignedInt dueFrame = 20000;
+
+	std::vector<BenchModule> modules(moduleCount);
+	std::vector<UnsignedInt> scheduled(moduleCount);
+	for (Int i = 0; i < moduleCount; ++i)
+	{
+		modules[i].m_id = i * 3;	// all in the same phase
+		modules[i].m_indexInLogic = -1;
+	}
+
+	TimingWheel<BenchModulePtr> wheel;
+	UnsignedInt nextScheduled = 0;
+	Int pushed = 0;
+	Int woken = 0;
+	UnsignedInt lastPriority = 0;
+	UnsignedInt lastScheduled = 0;
+
+	for (UnsignedInt now = 0; now <= dueFrame + 1; ++now)
+	{
+		while (pushed < moduleCount && (UnsignedInt)pushed * dueFrame / moduleCount <= now)
+		{
+			modules[pushed].friend_setNextCallFrame(dueFrame + hashValue(pushed, 1) % 2);
+			wheel.push(&modules[pushed]);
+			scheduled[pushed] = nextScheduled++;
+			++pushed;
+		}
+
+		if (now < dueFrame && now % 7 == 0)
+		{
+			const Int i = hashValue(now, 2) % pushed;
+			modules[i].friend_setNextCallFrame(dueFrame + hashValue(now, 3) % 2);
+			wheel.reschedule(&modules[i]);
+			scheduled[i] = nextScheduled++;
+		}
+
+		while (BenchModulePtr u = wheel.peek(now))
+		{
+			const UnsignedInt order = scheduled[u->m_id / 3];
+			if (woken > 0 && (u->friend_getPriority() < lastPriority ||
+				(u->friend_getPriority() == lastPriority && order < lastScheduled)))
+			{
+				printf("  the wheel woke module %u (scheduled %u) after module scheduled %u\n",
+					u->m_id, order, lastScheduled);
+				return false;
+			}
+			lastPriority = u->friend_getPriority();
+			lastScheduled = order;
+			++woken;
+
+			u->friend_setNextCallFrame(SLEEP_FOREVER);
+			wheel.reschedule(u);
+		}
+	}
+
+	if (woken != moduleCount)
+	{
+		printf("  the wheel woke %d of %d modules\n", woken, moduleCount);
+		return false;
+	}
+	return true;
+}
+
+//=============================================================================
+
+int main(int argc, char *argv[])
+{
+	Int frameCount = DEFAULT_FRAME_COUNT;
+	if (argc > 1)
+		frameCount = atoi(argv[1]);
+	if (frameCount <= 0)
+	{
+		printf("usage: sleepyupdatebenchmark [frames]\n");
+		return 2;
+	}
+
+	printf("Simulating %d frames\n", frameCount);
+	printf("%10s %12s %12s %12s %8s\n", "modules", "wakes", "heap ms", "wheel ms", "speedup");
+
+	int exitCode = 0;
+	if (!testEqualPriorityOrder())
+	{
+		printf("The timing wheel does not keep the order of equal priorities\n");
+		exitCode = 1;
+	}
+
+	for (size_t i = 0; i < sizeof(s_moduleCounts) / sizeof(s_moduleCounts[0]); ++i)
+	{
+		const Int moduleCount = s_moduleCounts[i];
+		BenchResult heap = runBenchmark<BenchHeap>(moduleCount, frameCount);
+		BenchResult wheel = runBenchmark< TimingWheel<BenchModulePtr> >(moduleCount, frameCount);
+
+		printf("%10d %12u %12.2f %12.2f %7.2fx\n", moduleCount, heap.wakeCount,
+			heap.milliseconds, wheel.milliseconds, heap.milliseconds / wheel.milliseconds);
+
+		if (heap.wakeCount != wheel.wakeCount || heap.checksum != wheel.checksum)
+		{
+			printf("  the queues woke different modules: %u wakes (checksum %08X) vs %u wakes (checksum %08X)\n",
+				heap.wakeCount, heap.checksum, wheel.wakeCount, wheel.checksum);
+			exitCode = 1;
+		}
+	}
+
+	return exitCode;
+}
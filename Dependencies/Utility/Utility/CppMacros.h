@@ -49,6 +49,15 @@
 #define MAYBE_UNUSED
 #endif
 
+// Thread local storage for plain data, such as pointers
+#if __cplusplus >= 201103L
+#define THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
 // noexcept for methods of IUNKNOWN interface
 #if defined(_MSC_VER)
 #define IUNKNOWN_NOEXCEPT noexcept
@@ -162,6 +162,8 @@ public:
 										 SnapshotType which = SNAPSHOT_SAVELOAD  );  ///< save a game
 	SaveCode missionSave();																	 ///< do a in between mission save
 	SaveCode loadGame( AvailableGameInfo gameInfo );							 ///< load a save file
+	SaveCode saveGameToXfer( Xfer *xfer );												 ///< save into an opened xfer without any user interaction or change of the save game info
+	SaveCode loadGameFromXfer( Xfer *xfer );											 ///< load from an opened xfer after the engine was reset
 	SaveGameInfo *getSaveGameInfo() { return &m_gameInfo; }
 
 	// snapshot interaction
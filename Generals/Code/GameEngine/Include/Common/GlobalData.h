@@ -353,6 +353,22 @@ public:
 
 	std::vector<AsciiString> m_simulateReplays; ///< If not empty, simulate this list of replays and exit.
 	Int m_simulateReplayJobs; ///< Maximum number of processes to use for simulation, or SIMULATE_REPLAYS_SEQUENTIAL for sequential simulation
+	AsciiString m_replayBenchmarkFile; ///< If not empty, time each logic frame of the simulated replays and write the summary to this file
+	UnsignedInt m_replaySnapshotInterval; ///< Number of logic frames between in-memory snapshots during replay playback, or 0 for none
+	UnsignedInt m_replaySnapshotMemoryMB; ///< Maximum memory used by the compressed replay snapshots
+	AsciiString m_replayBisectDirectory; ///< If not empty, write deep CRC dumps around the first CRC mismatch of the simulated replays into this directory
+	Bool m_replaySeekCheck; ///< Simulate every snapshot interval of the simulated replays twice and compare the CRCs
+	AsciiString m_memoryPoolProfileFile; ///< If not empty, write the peak memory pool sizes into this file at the end of every match
+	AsciiString m_pathfindBenchmarkMap; ///< If not empty, run the pathfind benchmark on this map and exit
+	Int m_pathfindBenchmarkQueries; ///< Number of path queries of the pathfind benchmark
+	UnsignedInt m_pathfindBenchmarkSeed; ///< Seed of the positions of the pathfind benchmark queries
+	Int m_iniBenchmarkRepeats; ///< If not 0, record the INI field lookups at startup, replay them this many times and exit
+	Int m_workerThreadCount; ///< Number of worker threads for the parallel parts of the logic update, or -1 for one less than the processors
+	Bool m_usePortalPathfinding; ///< Find hierarchical paths on the portal graph of the pathfind zone blocks
+	Bool m_usePathCache; ///< Let units follow recent paths between the same pathfind zone blocks
+	Bool m_useIncrementalZones; ///< Repair the pathfind zones around changed cells instead of recalculating the whole map
+	Bool m_useGroupFlowField; ///< Let the members of large group moves follow one flow field instead of searching a path each
+	Bool m_useINICache; ///< Keep the lines of the INI files in a cache file in the user data directory
 
 	Int m_maxParticleCount;						///< maximum number of particles that can exist
 	Int m_maxFieldParticleCount;			///< maximum number of field-type particles that can exist (roughly)
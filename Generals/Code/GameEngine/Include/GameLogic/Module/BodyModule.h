@@ -230,7 +230,7 @@ public:
 	virtual Bool isIndestructible() const override { return TRUE; }
 
 	//Allows outside systems to apply defensive bonuses or penalties (they all stack as a multiplier!)
-	virtual void applyDamageScalar( Real scalar ) override { m_damageScalar *= scalar; }
+	virtual void applyDamageScalar( Real scalar ) override;
 	virtual Real getDamageScalar() const override { return m_damageScalar; }
 
 	virtual void evaluateVisualCondition() override { }
@@ -360,6 +360,122 @@ public:
 	void friend_removeFromCellList(CellAndObjectIntersection *coi);
 };
 
+//=====================================
+/**
+	The inputs of the cells touched by a PartitionData: the geometry and position of its Object
+	(or GhostObject).
+*/
+//=====================================
+struct PartitionCoverageShape
+{
+	GeometryType	m_geom;
+	Bool					m_isSmall;
+	Coord3D				m_pos;
+	Real					m_angle;
+	Real					m_majorRadius;
+	Real					m_minorRadius;
+
+	Bool isSameAs(const PartitionCoverageShape &that) const
+	{
+		return m_geom == that.m_geom && m_isSmall == that.m_isSmall
+			&& m_pos.x == that.m_pos.x && m_pos.y == that.m_pos.y
+			&& m_angle == that.m_angle && m_majorRadius == that.m_majorRadius && m_minorRadius == that.m_minorRadius;
+	}
+};
+
+//=====================================
+/**
+	The cells touched by a PartitionCoverageShape, in the order in which the COIs of the PartitionData
+	get them. Calculating the coverage only reads the cells and writes nothing shared, so the coverage
+	of many modules can be calculated at once on several threads.
+	The cells are written to an array provided by the caller, which holds up to maxCellCount cells.
+*/
+//=====================================
+class PartitionCellCoverage
+{
+public:
+
+	PartitionCellCoverage(PartitionManager *partitionManager, PartitionCell **cells, Int maxCellCount);
+
+	/// discard the current cells and fill in the cells touched by the given shape.
+	void calcCellsTouched(const PartitionCoverageShape &shape);
+
+	Int getCellCount() const { return m_cellCount; }
+	PartitionCell *getCell(Int i) const { return m_cells[i]; }
+
+private:
+
+	/**
+		If you imagine the array of Partition Cells as pixels, then this method
+		'sets' the pixel [cell] at cell coordinate (x, y).
+	*/
+	void addSubPixToCoverage(PartitionCell *cell);
+
+	/**
+		fill in the pixels covered by the given 'small' shape with the given
+		center and radius. 'small' shapes are special in that they
+		are always assumed to cover at most 4 Cells, and so we can use
+		a more efficient special-purpose filler, rather than a general
+		rasterizer.
+	*/
+	void doSmallFill(
+		Real centerX,
+		Real centerY,
+		Real radius
+	);
+
+	/// helper function for doCircleFill.
+	void hLineCircle(Int x1, Int x2, Int y);
+
+	/**
+		fill in the pixels covered by the given circular shape with the given
+		center and radius. Note that this is used for both spheres and cylinders.
+	*/
+	void doCircleFill(
+		Real centerX,
+		Real centerY,
+		Real radius
+	);
+
+	/**
+		A more advanced implementation of doCircleFill that is 100% accurate.
+	*/
+	void doCircleFillPrecise(Real centerX, Real centerY, Real radius);
+
+	/**
+		fill in the pixels covered by the given rectangular shape with the given
+		center, dimensions, and rotation.
+	*/
+	void doRectFill(
+		Real centerX,
+		Real centerY,
+		Real halfsizeX,
+		Real halfsizeY,
+		Real angle
+	);
+
+	PartitionManager						*m_partitionManager;
+	PartitionCell								**m_cells;
+	Int													m_cellCount;
+	Int													m_maxCellCount;
+};
+
+//=====================================
+/**
+	The coverage of a dirty PartitionData, calculated at the start of PartitionManager::update.
+*/
+//=====================================
+struct PartitionCoverageJob
+{
+	PartitionData								*m_module;
+	PartitionCoverageShape			m_shape;
+	Int													m_firstCell;							///< index of the first cell in PartitionManager::m_coverageCells
+	Int													m_maxCellCount;						///< the COI count of the module
+	Int													m_cellCount;
+
+	void calcCellsTouched(PartitionManager *partitionManager, PartitionCell **cells);
+};
+
 //=====================================
 /**
 	A PartitionData is the part of an Object that understands
@@ -395,6 +511,7 @@ private:
 	ObjectShroudStatus					m_shroudednessPrevious[MAX_PLAYER_COUNT];	///<previous frames value of m_shroudedness
 	Bool												m_everSeenByPlayer[MAX_PLAYER_COUNT];		///<whether this object has ever been seen by a given player.
 	const PartitionCell					*m_lastCell;							///< The last cell I thought my center was in.
+	Int													m_coverageJobIndex;				///< index into PartitionManager::m_coverageJobs, or -1
 
 	/**
 		Given a shape's geometry and size parameters, calculate the maximum number of COIs
@@ -432,53 +549,16 @@ private:
 	void updateCellsTouched();
 
 	/**
-		If you imagine the array of Partition Cells as pixels, then this method
-		'sets' the pixel [cell] at cell coordinate (x, y).
-	*/
-	void addSubPixToCoverage(PartitionCell *cell);
-
-	/**
-		fill in the pixels covered by the given 'small' shape with the given
-		center and radius. 'small' shapes are special in that they
-		are always assumed to cover at most 4 Cells, and so we can use
-		a more efficient special-purpose filler, rather than a general
-		rasterizer.
-	*/
-	void doSmallFill(
-		Real centerX,
-		Real centerY,
-		Real radius
-	);
-
-	/// helper function for doCircleFill.
-	void hLineCircle(Int x1, Int x2, Int y);
-
-	/**
-		fill in the pixels covered by the given circular shape with the given
-		center and radius. Note that this is used for both spheres and cylinders.
-	*/
-	void doCircleFill(
-		Real centerX,
-		Real centerY,
-		Real radius
-	);
-
-	/**
-		A more advanced implementation of doCircleFill that is 100% accurate.
+		same as above, but takes the cells touched by the given shape from a coverage that was calculated
+		already (see PartitionManager::calcCoverageOfDirtyModules).
 	*/
-	void doCircleFillPrecise(Real centerX, Real centerY, Real radius);
+	void updateCellsTouched(const PartitionCoverageShape &shape, PartitionCell * const *cells, Int cellCount);
 
 	/**
-		fill in the pixels covered by the given rectangular shape with the given
-		center, dimensions, and rotation.
+		get the shape of the object, or of the ghost object if the object is gone.
+		returns false if attached to neither.
 	*/
-	void doRectFill(
-		Real centerX,
-		Real centerY,
-		Real halfsizeX,
-		Real halfsizeY,
-		Real angle
-	);
+	Bool getCoverageShape(PartitionCoverageShape *shape) const;
 
 	/**
 		do a careful test of the geometries of 'this' and 'that', and return
@@ -547,6 +627,12 @@ public:
 	void friend_removeAllTouchedCells() { removeAllTouchedCells(); }	///< this is only for use by PartitionManager
 	void friend_updateCellsTouched()	{ updateCellsTouched(); } ///< this is only for use by PartitionManager
 	Int friend_getCoiInUseCount() { return m_coiInUseCount; } ///< this is only for use by PartitionManager
+	Int friend_getCoiArrayCount() const { return m_coiArrayCount; } ///< this is only for use by PartitionManager
+	Bool friend_getCoverageShape(PartitionCoverageShape *shape) const { return getCoverageShape(shape); } ///< this is only for use by PartitionManager
+	void friend_updateCellsTouched(const PartitionCoverageShape &shape, PartitionCell * const *cells, Int cellCount) { updateCellsTouched(shape, cells, cellCount); } ///< this is only for use by PartitionManager
+	PartitionData *friend_getNextDirty() const { return m_nextDirty; } ///< this is only for use by PartitionManager
+	Int friend_getCoverageJobIndex() const { return m_coverageJobIndex; } ///< this is only for use by PartitionManager
+	void friend_setCoverageJobIndex(Int index) { m_coverageJobIndex = index; } ///< this is only for use by PartitionManager
 	Bool friend_collidesWith(const PartitionData *that, CollideLocAndNormal *cinfo) const { return collidesWith(that, cinfo); }	///< this is only for use by PartitionContactList
 
 	// these are only for use by getClosestObjects.
@@ -1186,6 +1272,42 @@ protected:
 #endif
 };
 
+//=====================================
+/**
+	TheSuperHackers @performance Caches recent isClearLineOfSightTerrain results, keyed on the two positions.
+	Flattening the terrain, shutdown and loading a save game clear it.
+*/
+//=====================================
+class PartitionLineOfSightCache
+{
+public:
+	enum { MAX_ENTRIES = 256 };
+
+	PartitionLineOfSightCache();
+
+	void clear();
+	Bool find(const Coord3D& pos, const Coord3D& posOther, Bool& isClear);	///< return true and the cached result if the positions are in the cache
+	void add(const Coord3D& pos, const Coord3D& posOther, Bool isClear);
+
+	Int getHits() const { return m_hits; }
+	Int getMisses() const { return m_misses; }
+
+private:
+	struct Entry
+	{
+		Coord3D	m_pos;
+		Coord3D	m_posOther;
+		Bool		m_isClear;
+		Bool		m_used;
+	};
+
+	static Int getIndex(const Coord3D& pos, const Coord3D& posOther);
+
+	Entry		m_entries[MAX_ENTRIES];
+	Int			m_hits;
+	Int			m_misses;
+};
+
 //=====================================
 /**
 	PartitionManager is the singleton class that manages the entire partition/collision
@@ -1216,6 +1338,12 @@ private:
 
 	std::queue<SightingInfo *> m_pendingUndoShroudReveals;	///< Anything can queue up an Undo to happen later. This is a queue, because "later" is a constant
 
+	std::vector<PartitionCoverageJob>	m_coverageJobs;		///< the coverage of the dirty modules, calculated at the start of update
+	std::vector<PartitionCell *>				m_coverageCells;	///< the cells of m_coverageJobs
+	std::vector<PartitionCell *>				m_updateCells;		///< the cells of a coverage that is calculated on demand
+	std::vector<UnsignedInt>						m_occupiedCellBits;	///< one bit per cell, set while any COI is in the cell
+	PartitionLineOfSightCache						m_lineOfSightCache;	///< recent results of isClearLineOfSightTerrain
+
 #ifdef FASTER_GCO
 	Int							m_maxGcoRadius;
 	RadiusVec				m_radiusVec;
@@ -1244,6 +1372,9 @@ protected:
 	Bool tryPosition( const Coord3D *center, Real dist, Real angle,
 										const FindPositionOptions *options, Coord3D *result );
 
+	/// return true if any of the cells that iteratePotentialCollisions looks at for the given radius has a COI
+	Bool isAnyCellOccupiedAround( const Coord3D *pos, Real boundingSphereRadius );
+
 	typedef Int (*CellAlongLineProc)(PartitionCell* cell, void* userData);
 
 	Int iterateCellsAlongLine(const Coord3D& pos, const Coord3D& posOther, CellAlongLineProc proc, void* userData);
@@ -1270,6 +1401,9 @@ protected:
 	friend void hLineAddValue(Int x1, Int x2, Int y, void *threatValueParms);
 	friend void hLineRemoveValue(Int x1, Int x2, Int y, void *threatValueParms);
 
+	/// calculate the coverage of the dirty modules that need to update their cells, on several threads if worthwhile
+	void calcCoverageOfDirtyModules();
+
 	void processPendingUndoShroudRevealQueue(Bool considerTimestamp = TRUE);				///< keep popping and processing until you get to one that is in the future
 	void resetPendingUndoShroudRevealQueue();					///< Just delete everything in the queue without doing anything with them
 
@@ -1308,6 +1442,9 @@ public:
 	PartitionCell *getCellAt(Int x, Int y);
 	const PartitionCell *getCellAt(Int x, Int y) const;
 
+	// intended only for PartitionCell.
+	void friend_setCellOccupied(Int x, Int y, Bool occupied);
+
 	/// A convenience function to reveal shroud at some location
 	// Queuing does not give you control of the timestamp to enforce the queue.  I own the delay, you don't.
 	void doShroudReveal( Real centerX, Real centerY, Real radius, PlayerMaskType playerMask);
@@ -1421,6 +1558,14 @@ public:
 	/// return the size of a PartitionCell, in world coords.
 	Real getCellSize() { return m_cellSize; }				// only for the use of PartitionData!
 
+	/// return a buffer for at least the given number of cells; only for the use of PartitionData!
+	PartitionCell **friend_getUpdateCells(Int maxCellCount)
+	{
+		if ((Int)m_updateCells.size() < maxCellCount)
+			m_updateCells.resize(maxCellCount);
+		return maxCellCount > 0 ? &m_updateCells[0] : nullptr;
+	}
+
 	/// return (1.0 / getCellSize); this is used frequently, so we cache it for efficiency
 	Real getCellSizeInv() { return m_cellSizeInv; }
 
@@ -1431,6 +1576,9 @@ public:
 	*/
 	Bool isClearLineOfSightTerrain(const Object* obj, const Coord3D& objPos, const Object* other, const Coord3D& otherPos);
 
+	/// forget the cached results of isClearLineOfSightTerrain, because the terrain heights changed
+	void clearLineOfSightCache() { m_lineOfSightCache.clear(); }
+
 	Bool isInListDirtyModules(PartitionData* o) const
 	{
 		return o->isInListDirtyModules(&m_dirtyModules);
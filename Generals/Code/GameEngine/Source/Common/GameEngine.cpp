@@ -40,6 +40,7 @@
 #include "Common/GameAudio.h"
 #include "Common/GameEngine.h"
 #include "Common/INI.h"
+#include "Common/INICache.h"
 #include "Common/INIException.h"
 #include "Common/MessageStream.h"
 #include "Common/ThingFactory.h"
@@ -64,6 +65,7 @@
 #include "Common/SpecialPower.h"
 #include "Common/TerrainTypes.h"
 #include "Common/Upgrade.h"
+#include "Common/WorkerThreadPool.h"
 #include "Common/OptionPreferences.h"
 #include "Common/Xfer.h"
 #include "Common/XferCRC.h"
@@ -274,10 +276,19 @@ GameEngine::~GameEngine()
 	// Reset all subsystems before deletion to prevent crashing due to cross dependencies.
 	reset();
 
+	// Keep the lines of the INI files that were loaded after the start, such as those of the maps. This needs TheLocalFileSystem.
+	if (TheINICache != nullptr)
+		TheINICache->save();
+	delete TheINICache;
+	TheINICache = nullptr;
+
 	TheSubsystemList->shutdownAll();
 	delete TheSubsystemList;
 	TheSubsystemList = nullptr;
 
+	delete TheWorkerThreadPool;
+	TheWorkerThreadPool = nullptr;
+
 	delete TheSkirmishGameInfo;
 	TheSkirmishGameInfo = nullptr;
 
@@ -385,6 +396,13 @@ void GameEngine::init()
 		XferCRC xferCRC;
 		xferCRC.open("lightCRC");
 
+		// TheSuperHackers @performance Start the worker threads for the parallel parts of the logic update.
+		// They are started before the file systems, because the archive files are opened on them as well.
+		Int workerThreadCount = TheGlobalData->m_workerThreadCount;
+		if (workerThreadCount < 0)
+			workerThreadCount = WorkerThreadPool::getDefaultThreadCount();
+		TheWorkerThreadPool = MSGNEW("GameEngineSubsystem") WorkerThreadPool(workerThreadCount);
+
 		initSubsystem(TheLocalFileSystem, "TheLocalFileSystem", createLocalFileSystem(), nullptr);
 		initSubsystem(TheArchiveFileSystem, "TheArchiveFileSystem", createArchiveFileSystem(), nullptr); // this MUST come after TheLocalFileSystem creation
 
@@ -392,6 +410,15 @@ void GameEngine::init()
 		initSubsystem(TheWritableGlobalData, "TheWritableGlobalData", TheWritableGlobalData, &xferCRC, "Data\\INI\\Default\\GameData", "Data\\INI\\GameData");
 		TheWritableGlobalData->parseCustomDefinition();
 
+		// TheSuperHackers @performance Read the INI cache, which lives in the user data directory that is known from here on.
+		if (TheGlobalData->m_useINICache)
+		{
+			AsciiString cacheFilename;
+			cacheFilename.format("%sINICache.dat", TheGlobalData->getPath_UserData().str());
+			TheINICache = MSGNEW("GameEngineSubsystem") INICache;
+			TheINICache->load(cacheFilename);
+		}
+
 
 
 	#if defined(RTS_DEBUG)
@@ -506,6 +533,9 @@ void GameEngine::init()
 		TheWritableGlobalData->m_iniCRC = xferCRC.getCRC();
 		DEBUG_LOG(("INI CRC is 0x%8.8X", TheGlobalData->m_iniCRC));
 
+		if (TheINICache != nullptr)
+			TheINICache->save();
+
 		TheSubsystemList->postProcessLoadAll();
 
 		TheFramePacer->setFramesPerSecondLimit(TheGlobalData->m_framesPerSecondLimit);
@@ -751,6 +781,10 @@ void GameEngine::update()
 		// TheSuperHackers @info Ignores frozen time because the script engine needs updating in the logic update regardless.
 		if (canUpdateGameLogic(FramePacer::IgnoreFrozenTime))
 		{
+			// TheSuperHackers @feature Jumps and snapshots of a replay playback happen between logic frames.
+			TheRecorder->updatePlaybackJump();
+			TheRecorder->updatePlaybackSnapshots();
+
 			TheGameLogic->UPDATE();
 
 			if (!TheFramePacer->isTimeFrozen())
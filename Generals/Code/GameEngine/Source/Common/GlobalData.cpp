@@ -989,6 +989,22 @@ GlobalData::GlobalData()
 
 	m_simulateReplays.clear();
 	m_simulateReplayJobs = SIMULATE_REPLAYS_SEQUENTIAL;
+	m_replayBenchmarkFile.clear();
+	m_replaySnapshotInterval = 0;
+	m_replaySnapshotMemoryMB = 256;
+	m_replayBisectDirectory.clear();
+	m_replaySeekCheck = FALSE;
+	m_memoryPoolProfileFile.clear();
+	m_pathfindBenchmarkMap.clear();
+	m_pathfindBenchmarkQueries = 1000;
+	m_pathfindBenchmarkSeed = 0;
+	m_iniBenchmarkRepeats = 0;
+	m_workerThreadCount = -1;
+	m_usePortalPathfinding = FALSE;
+	m_usePathCache = FALSE;
+	m_useIncrementalZones = FALSE;
+	m_useGroupFlowField = FALSE;
+	m_useINICache = FALSE;
 
 	for (i = LEVEL_FIRST; i <= LEVEL_LAST; ++i)
 		m_healthBonus[i] = 1.0f;
@@ -31,6 +31,9 @@
 #include "Common/Player.h"
 #include "Common/GlobalData.h"
 #include "Common/GameEngine.h"
+#include "Common/GameState.h"
+#include "Common/XferLoadRAM.h"
+#include "Common/XferSaveRAM.h"
 #include "GameClient/ClientInstance.h"
 #include "GameClient/GameWindow.h"
 #include "GameClient/GameWindowManager.h"
@@ -48,6 +51,8 @@
 #include "Common/OptionPreferences.h"
 #include "Common/version.h"
 
+#include "Compression.h"
+
 constexpr const char s_genrep[] = "GENREP";
 constexpr const UnsignedInt replayBufferBytes = 8192;
 
@@ -346,6 +351,10 @@ RecorderClass::RecorderClass()
 	m_archiveReplays = FALSE;
 	m_nextFrame = 0;
 	m_wasDesync = FALSE;
+	m_playbackSnapshotBytes = 0;
+	m_playbackJumpFrame = 0;
+	m_lastMatchingCRCFrame = 0;
+	m_crcMismatchFrame = 0;
 	init(); // just for the heck of it.
 }
 
@@ -392,6 +401,7 @@ void RecorderClass::reset() {
 		m_file = nullptr;
 	}
 	m_fileName.clear();
+	clearPlaybackSnapshots();
 
 	init();
 }
@@ -965,6 +975,241 @@ Bool RecorderClass::isPlaybackInProgress() const
 	return isPlaybackMode() && m_nextFrame != -1;
 }
 
+/**
+ * Takes an in-memory snapshot of the game state if one is due on the current frame.
+ * This must be called between two logic frames, because the snapshot is a full save game.
+ */
+void RecorderClass::updatePlaybackSnapshots()
+{
+	const UnsignedInt interval = TheGlobalData->m_replaySnapshotInterval;
+	if (interval == 0 || !isPlaybackMode() || !isPlaybackInProgress())
+		return;
+
+	const UnsignedInt frame = TheGameLogic->getFrame();
+	if (frame == 0 || frame % interval != 0 || !TheGameLogic->isInGame())
+		return;
+
+	// Frames can be simulated again after seeking backwards
+	for (PlaybackSnapshotList::const_iterator it = m_playbackSnapshots.begin(); it != m_playbackSnapshots.end(); ++it)
+	{
+		if (it->frame == frame)
+			return;
+	}
+
+	takePlaybackSnapshot();
+}
+
+/**
+ * Simulates the playback up to the given frame. If there is a snapshot closer to the frame than the current
+ * frame, or if the frame lies in the past, the game state is restored from the closest earlier snapshot first.
+ * Returns false if the frame cannot be reached.
+ */
+Bool RecorderClass::seekPlayback(UnsignedInt frame)
+{
+	DEBUG_ASSERTCRASH(!TheGameLogic->isInGameLogicUpdate(), ("RecorderClass::seekPlayback - must not be called during the logic update"));
+	if (!isPlaybackMode())
+		return FALSE;
+
+	const PlaybackSnapshot *closest = nullptr;
+	for (PlaybackSnapshotList::const_iterator it = m_playbackSnapshots.begin(); it != m_playbackSnapshots.end(); ++it)
+	{
+		if (it->frame > frame)
+			break;
+		closest = &(*it);
+	}
+
+	const UnsignedInt currentFrame = TheGameLogic->getFrame();
+	if (frame < currentFrame || (closest != nullptr && closest->frame > currentFrame))
+	{
+		if (closest == nullptr)
+		{
+			DEBUG_LOG(("RecorderClass::seekPlayback - no snapshot before frame %d", frame));
+			return FALSE;
+		}
+		if (!restorePlaybackSnapshot(*closest))
+		{
+			DEBUG_LOG(("RecorderClass::seekPlayback - cannot restore snapshot of frame %d", closest->frame));
+			return FALSE;
+		}
+	}
+
+	while (isPlaybackInProgress() && !m_crcInfo.sawCRCMismatch() && TheGameLogic->getFrame() < frame)
+	{
+		updatePlaybackSnapshots();
+		TheGameLogic->UPDATE();
+	}
+
+	return TheGameLogic->getFrame() == frame;
+}
+
+// Frames that a jump goes back at least, so that pressing it again right after a jump goes further back.
+static const UnsignedInt PLAYBACK_JUMP_BACK_FRAMES = 5 * LOGICFRAMES_PER_SECOND;
+
+/**
+ * TheSuperHackers @feature Remembers the last snapshot that is at least a few seconds older than the current
+ * frame. The jump itself is done in updatePlaybackJump, because restoring a snapshot resets the engine,
+ * which must not happen while the message that asked for the jump is processed.
+ */
+Bool RecorderClass::requestPlaybackJumpBack()
+{
+	const UnsignedInt currentFrame = TheGameLogic->getFrame();
+	m_playbackJumpFrame = 0;
+	for (PlaybackSnapshotList::const_iterator it = m_playbackSnapshots.begin(); it != m_playbackSnapshots.end(); ++it)
+	{
+		if (it->frame + PLAYBACK_JUMP_BACK_FRAMES > currentFrame)
+			break;
+		m_playbackJumpFrame = it->frame;
+	}
+	return m_playbackJumpFrame != 0;
+}
+
+void RecorderClass::updatePlaybackJump()
+{
+	if (m_playbackJumpFrame == 0)
+		return;
+
+	const UnsignedInt frame = m_playbackJumpFrame;
+	m_playbackJumpFrame = 0;
+	if (!seekPlayback(frame))
+	{
+		DEBUG_LOG(("RecorderClass::updatePlaybackJump - cannot jump back to frame %d", frame));
+	}
+}
+
+Bool RecorderClass::takePlaybackSnapshot()
+{
+	XferSaveRAM xferSave;
+	xferSave.open("PlaybackSnapshot");
+	const SaveCode result = TheGameState->saveGameToXfer(&xferSave);
+	xferSave.close();
+	if (result != SC_OK)
+	{
+		DEBUG_LOG(("RecorderClass::takePlaybackSnapshot - cannot save frame %d", TheGameLogic->getFrame()));
+		return FALSE;
+	}
+
+	const CompressionType compressionType = CompressionManager::getPreferredCompression();
+	const Int uncompressedSize = xferSave.getDataSize();
+	const Int maxCompressedSize = CompressionManager::getMaxCompressedSize(uncompressedSize, compressionType);
+	std::vector<UnsignedByte> compressed(maxCompressedSize);
+	const Int compressedSize = CompressionManager::compressData(compressionType,
+		(void *)xferSave.getData(), uncompressedSize, &compressed[0], maxCompressedSize);
+	if (compressedSize == 0)
+	{
+		DEBUG_LOG(("RecorderClass::takePlaybackSnapshot - cannot compress frame %d", TheGameLogic->getFrame()));
+		return FALSE;
+	}
+	compressed.resize(compressedSize);
+
+	// Keep the list ordered by frame
+	PlaybackSnapshotList::iterator it = m_playbackSnapshots.begin();
+	while (it != m_playbackSnapshots.end() && it->frame < TheGameLogic->getFrame())
+		++it;
+	it = m_playbackSnapshots.insert(it, PlaybackSnapshot());
+
+	PlaybackSnapshot &snapshot = *it;
+	snapshot.frame = TheGameLogic->getFrame();
+	snapshot.filePosition = m_file->position();
+	snapshot.nextFrame = m_nextFrame;
+	snapshot.crcInfo = m_crcInfo;
+	snapshot.uncompressedSize = uncompressedSize;
+	snapshot.data.swap(compressed);
+	m_playbackSnapshotBytes += compressedSize;
+
+	thinPlaybackSnapshots();
+	return TRUE;
+}
+
+/**
+ * Drops every other snapshot while the memory limit is exceeded. This keeps the remaining snapshots spread
+ * over the whole replay, at the cost of a coarser spacing. The most recent snapshot is always kept.
+ */
+void RecorderClass::thinPlaybackSnapshots()
+{
+	const UnsignedInt64 maxBytes = (UnsignedInt64)TheGlobalData->m_replaySnapshotMemoryMB * 1024 * 1024;
+	while (m_playbackSnapshotBytes > maxBytes && m_playbackSnapshots.size() > 1)
+	{
+		PlaybackSnapshotList::iterator it = m_playbackSnapshots.begin();
+		PlaybackSnapshotList::iterator last = m_playbackSnapshots.end();
+		--last;
+		Bool drop = (m_playbackSnapshots.size() % 2) == 0;
+		while (it != last)
+		{
+			if (drop)
+			{
+				m_playbackSnapshotBytes -= it->data.size();
+				it = m_playbackSnapshots.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+			drop = !drop;
+		}
+	}
+}
+
+void RecorderClass::clearPlaybackSnapshots()
+{
+	m_playbackSnapshots.clear();
+	m_playbackSnapshotBytes = 0;
+	m_playbackJumpFrame = 0;
+}
+
+Bool RecorderClass::restorePlaybackSnapshot(const PlaybackSnapshot &snapshot)
+{
+	std::vector<UnsignedByte> data(snapshot.uncompressedSize);
+	const Int uncompressedSize = CompressionManager::decompressData((void *)&snapshot.data[0], (Int)snapshot.data.size(),
+		&data[0], snapshot.uncompressedSize);
+	if (uncompressedSize != snapshot.uncompressedSize)
+		return FALSE;
+
+	const Int filePosition = snapshot.filePosition;
+	const UnsignedInt nextFrame = snapshot.nextFrame;
+	const CRCInfo crcInfo = snapshot.crcInfo;
+
+	// Keep everything the engine reset discards. The snapshot reference stays valid because
+	// swapping lists does not move their elements.
+	PlaybackSnapshotList snapshots;
+	snapshots.swap(m_playbackSnapshots);
+	const UnsignedInt64 snapshotBytes = m_playbackSnapshotBytes;
+	const AsciiString replayFilename = m_currentReplayFilename;
+	const RecorderModeType mode = m_mode;
+	const UnsignedInt playbackFrameCount = m_playbackFrameCount;
+	const Int originalGameMode = m_originalGameMode;
+
+	TheGameEngine->reset();
+
+	// Reopen the replay, which also restores the game info required to start the game from the save data
+	ReplayHeader header;
+	header.forPlayback = TRUE;
+	header.filename = replayFilename;
+	if (!readReplayHeader(header))
+		return FALSE;
+
+	m_file->seek(filePosition, File::START);
+	m_nextFrame = nextFrame;
+	m_crcInfo = crcInfo;
+	// The CRCs after the snapshot are compared again, so forget which of them matched before.
+	m_lastMatchingCRCFrame = 0;
+	m_crcMismatchFrame = 0;
+	m_mode = mode;
+	m_currentReplayFilename = replayFilename;
+	m_playbackFrameCount = playbackFrameCount;
+	m_originalGameMode = originalGameMode;
+	m_playbackSnapshots.swap(snapshots);
+	m_playbackSnapshotBytes = snapshotBytes;
+
+	TheCommandList->reset();
+
+	XferLoadRAM xferLoad(&data[0], (Int)data.size());
+	xferLoad.open("PlaybackSnapshot");
+	const SaveCode result = TheGameState->loadGameFromXfer(&xferLoad);
+	xferLoad.close();
+
+	return result == SC_OK;
+}
+
 AsciiString RecorderClass::getCurrentReplayFilename()
 {
 	if (isPlaybackMode())
@@ -998,6 +1243,16 @@ void RecorderClass::handleCRCMessage(UnsignedInt newCRC, Int playerIndex, Bool f
 	if (samePlayer || (localPlayerIndex < 0))
 	{
 		UnsignedInt playbackCRC = m_crcInfo.readCRC();
+
+		// TheSuperHackers @info The recorded CRCs only apply to the recorded pathfinding options.
+		// -replaySeekCheck can simulate with others.
+		if (TheGameLogic->getPathfindOptions() != m_gameInfo.getPathfindOptions())
+			return;
+
+		if (TheGameLogic->getFrame() > 0 && newCRC == playbackCRC && !m_crcInfo.sawCRCMismatch())
+		{
+			m_lastMatchingCRCFrame = TheGameLogic->getFrame() - m_crcInfo.GetQueueSize() - 1;
+		}
 		//DEBUG_LOG(("RecorderClass::handleCRCMessage() - Comparing CRCs of InGame:%8.8X Replay:%8.8X Frame:%d from Player %d",
 		//	playbackCRC, newCRC, TheGameLogic->getFrame()-m_crcInfo.GetQueueSize()-1, playerIndex));
 		if (TheGameLogic->getFrame() > 0 && newCRC != playbackCRC && !m_crcInfo.sawCRCMismatch())
@@ -1015,6 +1270,7 @@ void RecorderClass::handleCRCMessage(UnsignedInt newCRC, Int playerIndex, Bool f
 			// Note: We subtract the queue size from the frame number. This way we calculate the correct frame
 			// the mismatch first happened in case the NetCRCInterval is set to 1 during the game.
 			const UnsignedInt mismatchFrame = TheGameLogic->getFrame() - m_crcInfo.GetQueueSize() - 1;
+			m_crcMismatchFrame = mismatchFrame;
 
 			// Now also prints a UI message for it.
 			const UnicodeString mismatchDetailsStr = TheGameText->FETCH_OR_SUBSTITUTE("GUI:CRCMismatchDetails", L"InGame:%8.8X Replay:%8.8X Frame:%d");
@@ -1088,6 +1344,10 @@ Bool RecorderClass::playbackFile(AsciiString filename)
 		}
 	}
 
+	clearPlaybackSnapshots();
+	m_lastMatchingCRCFrame = 0;
+	m_crcMismatchFrame = 0;
+
 	ReplayHeader header;
 	header.forPlayback = TRUE;
 	header.filename = filename;
@@ -1231,6 +1231,8 @@ void SkirmishGameOptionsMenuInit( WindowLayout *layout, void *userData )
 	TheSkirmishGameInfo->setSlot(1, gSlot);
 
 	ParseAsciiStringToGameInfo(TheSkirmishGameInfo, prefs.getSlotList());
+	// TheSuperHackers @fix The pathfinding options come from this run's command line, not the saved preferences.
+	TheSkirmishGameInfo->setPathfindOptions(GetCommandLinePathfindOptions());
 	TheSkirmishGameInfo->setSeed(GetTickCount());
 
 	UnsignedInt isPreorder = 0;
@@ -56,6 +56,8 @@
 #include "GameLogic/Module/SpecialPowerUpdateModule.h"
 #include "GameLogic/ObjectIter.h"
 
+#include "GameNetwork/GameInfo.h"
+
 
 /**
  * NOTE: Only AI objects (ie: having an AIUpdate module) can be in
@@ -1575,6 +1577,9 @@ void clampWaypointPosition( Coord3D &position, Int margin )
 }
 
 
+// Number of ground units in a group move from which the units follow a shared flow field.
+static const Int FLOW_FIELD_MIN_GROUP_SIZE = 10;
+
 /**
  * Move to given position(s)
  */
@@ -1591,6 +1596,20 @@ void AIGroup::groupMoveToPosition( const Coord3D *pos, Bool addWaypoint, Command
 
 	Bool isFormation = getMinMaxAndCenter( &min, &max, &center );
 	if (addWaypoint) isFormation = false;
+
+	// TheSuperHackers @performance Let the members of a large group share one flow field to the destination
+	// instead of searching a path each.
+	if (!addWaypoint && TheGameLogic->hasPathfindOption(PATHFIND_OPTION_GROUP_FLOW_FIELD)) {
+		ObjectIDVector groundMembers;
+		for (std::list<Object *>::iterator it = m_memberList.begin(); it != m_memberList.end(); ++it) {
+			if ((*it)->getAI() && (*it)->getAI()->isDoingGroundMovement()) {
+				groundMembers.push_back((*it)->getID());
+			}
+		}
+		if ((Int)groundMembers.size() >= FLOW_FIELD_MIN_GROUP_SIZE) {
+			TheAI->pathfinder()->requestFlowField(pos, &min, &max, groundMembers);
+		}
+	}
 	if (!addWaypoint && !isFormation) {
 		friend_computeGroundPath(pos, cmdSource);
 		didInfantry = friend_moveInfantryToPos(pos, cmdSource);
@@ -2659,6 +2659,9 @@ void TerrainLogic::flattenTerrain(Object *obj)
 		return;
 	}
 
+	// TheSuperHackers @performance The heights change, so the cached line of sight results are stale.
+	ThePartitionManager->clearLineOfSightCache();
+
 	const Coord3D *pos = obj->getPosition();
 	switch(obj->getGeometryInfo().getGeomType())
 	{
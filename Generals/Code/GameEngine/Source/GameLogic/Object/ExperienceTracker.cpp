@@ -73,12 +73,14 @@ Bool ExperienceTracker::isTrainable() const
 void ExperienceTracker::setTrainable(Bool trainable)
 {
 	m_isTrainable = trainable;
+	m_parent->invalidateCRCState();
 }
 
 //-------------------------------------------------------------------------------------------------
 void ExperienceTracker::resetTrainable()
 {
 	m_isTrainable = m_parent->getTemplate()->isTrainable();
+	m_parent->invalidateCRCState();
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -111,6 +113,7 @@ void ExperienceTracker::setMinVeterancyLevel( VeterancyLevel newLevel, Bool prov
 		VeterancyLevel oldLevel = m_currentLevel;
 		m_currentLevel = newLevel;
 		m_currentExperience = m_parent->getTemplate()->getExperienceRequired(m_currentLevel); //Minimum for this level
+		m_parent->invalidateCRCState();
 		if (m_parent)
 			m_parent->onVeterancyLevelChanged( oldLevel, newLevel, provideFeedback );
 	}
@@ -127,6 +130,7 @@ void ExperienceTracker::setVeterancyLevel( VeterancyLevel newLevel, Bool provide
 		VeterancyLevel oldLevel = m_currentLevel;
 		m_currentLevel = newLevel;
 		m_currentExperience = m_parent->getTemplate()->getExperienceRequired(m_currentLevel); //Minimum for this level
+		m_parent->invalidateCRCState();
 		if (m_parent)
 			m_parent->onVeterancyLevelChanged( oldLevel, newLevel, provideFeedback );
 	}
@@ -195,6 +199,7 @@ void ExperienceTracker::addExperiencePoints( Int experienceGain, Bool canScaleFo
 	}
 
 	m_currentLevel = (VeterancyLevel)levelIndex;
+	m_parent->invalidateCRCState();
 
 	if( oldLevel != m_currentLevel )
 	{
@@ -235,6 +240,7 @@ void ExperienceTracker::setExperienceAndLevel( Int experienceIn, Bool provideFee
 	}
 
 	m_currentLevel = (VeterancyLevel)levelIndex;
+	m_parent->invalidateCRCState();
 
 	if( oldLevel != m_currentLevel )
 	{
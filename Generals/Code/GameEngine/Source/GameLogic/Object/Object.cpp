@@ -784,6 +784,7 @@ void Object::setGeometryInfoZ( Real newZ )
 //=============================================================================
 void Object::friend_setUndetectedDefector( Bool status )
 {
+	invalidateCRCState();
 	if (status)
 		m_privateStatus |= UNDETECTED_DEFECTOR;
 	else
@@ -1699,6 +1700,7 @@ void Object::reactToTurretChange( WhichTurretType turret, Real oldRotation, Real
 void Object::reactToTransformChange(const Matrix3D* oldMtx, const Coord3D* oldPos, Real oldAngle)
 {
 	//USE_PERF_TIMER(Object_reactToTransformChange)
+	invalidateCRCState();
 	if(_isnan(getPosition()->x) || _isnan(getPosition()->y) || _isnan(getPosition()->z)) {
 		DEBUG_CRASH(("Object pos is nan."));
 		TheGameLogic->destroyObject(this);
@@ -2563,6 +2565,7 @@ void Object::setID( ObjectID id )
 
 	// assign new id
 	m_id = id;
+	invalidateCRCState();
 
 	// add new id to lookup table
 	TheGameLogic->addObjectToLookupTable( this );
@@ -2632,6 +2635,7 @@ void Object::friend_notifyOfNewMapBoundary()
 		m_privateStatus &= ~OFF_MAP;
 	else
 		m_privateStatus |= OFF_MAP;
+	invalidateCRCState();
 }
 
 
@@ -3475,9 +3479,9 @@ void Object::onDisabledEdge(Bool becomingDisabled)
 }
 
 //-------------------------------------------------------------------------------------------------
-/** Object CRC implementation */
+/** CRC of the object state, excluding the weapons */
 //-------------------------------------------------------------------------------------------------
-void Object::crc( Xfer *xfer )
+void Object::crcState( Xfer *xfer )
 {
 #ifdef DEBUG_CRC
 //	g_logObjectCRCs = TRUE;
@@ -3586,6 +3590,49 @@ void Object::crc( Xfer *xfer )
 		CRCDEBUG_LOG(("%s", logString.str()));
 	}
 #endif // DEBUG_CRC
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Object CRC implementation */
+//-------------------------------------------------------------------------------------------------
+void Object::crc( Xfer *xfer )
+{
+	// TheSuperHackers @performance The object state changes far less often than it is CRC'd, so the data
+	// of crcState is recorded once and reused until the state is invalidated. The weapons change with
+	// every shot and reload and are always CRC'd directly.
+	Bool useRecording = xfer->getXferMode() == XFER_CRC;
+#ifdef DEBUG_CRC
+	useRecording = useRecording && !g_logObjectCRCs;
+#endif // DEBUG_CRC
+
+	if (useRecording)
+	{
+		if (!m_crcStateRecording.isValid())
+		{
+			XferCRCRecorder recorder(&m_crcStateRecording);
+			recorder.open(AsciiString::TheEmptyString);
+			crcState(&recorder);
+			recorder.close();
+		}
+#ifdef DEBUG_CRC
+		else
+		{
+			// Verify that all changes of the state invalidated the recording
+			CRCRecording verification;
+			XferCRCRecorder recorder(&verification);
+			recorder.open(AsciiString::TheEmptyString);
+			crcState(&recorder);
+			recorder.close();
+			DEBUG_ASSERTCRASH(verification.isEqual(m_crcStateRecording), ("Object::crc - CRC state of object %d (%s) changed without invalidation",
+				m_id, getTemplate()->getName().str()));
+		}
+#endif // DEBUG_CRC
+		static_cast<XferCRC *>(xfer)->xferRecording(&m_crcStateRecording);
+	}
+	else
+	{
+		crcState(xfer);
+	}
 
 	for (Int i=0; i<WEAPONSLOT_COUNT; ++i)
 	{
@@ -3614,6 +3661,9 @@ void Object::crc( Xfer *xfer )
 void Object::xfer( Xfer *xfer )
 {
 
+	// loading changes the CRC state
+	invalidateCRCState();
+
 	// version
 	const XferVersion currentVersion = 8;
 	XferVersion version = currentVersion;
@@ -4075,6 +4125,7 @@ void Object::giveUpgrade( const UpgradeTemplate *upgradeT )
 	if (upgradeT)
 	{
 		m_objectUpgradesCompleted.set( upgradeT->getUpgradeMask() );
+		invalidateCRCState();
 
 		//
 		// iterate through all the upgrade modules of this object and call the method to
@@ -4090,6 +4141,7 @@ void Object::giveUpgrade( const UpgradeTemplate *upgradeT )
 void Object::removeUpgrade( const UpgradeTemplate *upgradeT )
 {
 	m_objectUpgradesCompleted.clear( upgradeT->getUpgradeMask() );
+	invalidateCRCState();
 	for (BehaviorModule** module = m_behaviors; *module; ++module)
 	{
 		UpgradeModuleInterface* upgrade = (*module)->getUpgrade();
@@ -903,6 +903,9 @@ Int APIENTRY WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance,
 		delete TheVersion;
 		TheVersion = nullptr;
 
+		// TheSuperHackers @fix Return the blocks cached by the main thread to their pools, so that the reports do not count them as used.
+		TheMemoryPoolFactory->releaseThreadCaches();
+
 	#ifdef MEMORYPOOL_DEBUG
 		TheMemoryPoolFactory->debugMemoryReport(REPORT_POOLINFO | REPORT_POOL_OVERFLOW | REPORT_SIMPLE_LEAKS, 0, 0);
 	#endif
@@ -110,6 +110,17 @@ public:
 #endif
 	Bool isPlaybackInProgress() const;
 
+	// TheSuperHackers @feature In-memory game state snapshots for fast seeking during replay playback.
+	void updatePlaybackSnapshots();										///< Takes a snapshot if one is due. Call between logic frames only.
+	Bool seekPlayback(UnsignedInt frame);							///< Simulates to the frame, starting from the closest earlier snapshot if that is shorter.
+	Bool requestPlaybackJumpBack();										///< Asks to jump back to an earlier snapshot. Returns false if there is none.
+	void updatePlaybackJump();												///< Does the requested jump. Call between logic frames only.
+	UnsignedInt getPlaybackSnapshotCount() const { return (UnsignedInt)m_playbackSnapshots.size(); }
+	UnsignedInt64 getPlaybackSnapshotBytes() const { return m_playbackSnapshotBytes; }
+
+	UnsignedInt getLastMatchingCRCFrame() const { return m_lastMatchingCRCFrame; } ///< The frame of the last CRC that matched the replay.
+	UnsignedInt getCRCMismatchFrame() const { return m_crcMismatchFrame; }					///< The frame of the first CRC that did not match the replay.
+
 public:
 	void handleCRCMessage(UnsignedInt newCRC, Int playerIndex, Bool fromPlayback);
 
@@ -181,6 +192,22 @@ protected:
 
 	CullBadCommandsResult cullBadCommands(); ///< prevent the user from giving mouse commands that he shouldn't be able to do during playback.
 
+	struct PlaybackSnapshot
+	{
+		UnsignedInt frame;							///< The logic frame the snapshot was taken on.
+		Int filePosition;								///< The replay file position of the next command.
+		UnsignedInt nextFrame;					///< The frame of the next command.
+		CRCInfo crcInfo;								///< The CRCs that were not yet compared.
+		Int uncompressedSize;
+		std::vector<UnsignedByte> data;	///< The compressed save game data.
+	};
+	typedef std::list<PlaybackSnapshot> PlaybackSnapshotList;
+
+	Bool takePlaybackSnapshot();
+	Bool restorePlaybackSnapshot(const PlaybackSnapshot &snapshot);
+	void thinPlaybackSnapshots();
+	void clearPlaybackSnapshots();
+
 	CRCInfo m_crcInfo;
 	File* m_file;
 	AsciiString m_fileName;
@@ -198,6 +225,13 @@ protected:
 	Int m_originalGameMode; // valid in replays
 
 	UnsignedInt m_nextFrame;												///< The Frame that the next message is to be executed on.  This can be -1.
+
+	PlaybackSnapshotList m_playbackSnapshots;				///< Snapshots of the current playback, ordered by frame.
+	UnsignedInt64 m_playbackSnapshotBytes;						///< Compressed size of all snapshots.
+	UnsignedInt m_playbackJumpFrame;								///< The frame of the snapshot to jump back to, or 0 for none.
+
+	UnsignedInt m_lastMatchingCRCFrame;
+	UnsignedInt m_crcMismatchFrame;
 };
 
 extern RecorderClass *TheRecorder;
@@ -33,6 +33,7 @@
 #include "Common/GameType.h"
 #include "Common/Snapshot.h"
 #include "Common/STLTypedefs.h"
+#include "Common/TimingWheel.h"
 #include "Common/ObjectStatusTypes.h"
 #include "GameNetwork/NetworkDefs.h"
 #include "GameLogic/AI.h"
@@ -139,7 +140,11 @@ public:
 	Bool isInGameLogicUpdate() const { return m_isInUpdate; }
 	Bool hasUpdated() const { return m_hasUpdated; } ///< Returns true if the logic frame has advanced in the current client/render update
 	UnsignedInt getFrame();										///< Returns the current simulation frame number
-	UnsignedInt getCRC( Int mode = CRC_CACHED, AsciiString deepCRCFileName = AsciiString::TheEmptyString );		///< Returns the CRC
+	UnsignedInt getCRC( Int mode = CRC_CACHED, AsciiString deepCRCFileName = AsciiString::TheEmptyString, AsciiString deepCRCIndexFileName = AsciiString::TheEmptyString );		///< Returns the CRC
+
+	// TheSuperHackers @feature Writes a deep CRC dump with index file when the CRC of the given frame is calculated.
+	void addDeepCRCDump( UnsignedInt frame, const AsciiString &fileName ) { m_deepCRCDumps[frame] = fileName; }
+	void clearDeepCRCDumps() { m_deepCRCDumps.clear(); }
 
 	void setObjectIDCounter( ObjectID nextObjID ) { m_nextObjID = nextObjID; }
 	ObjectID getObjectIDCounter() { return m_nextObjID; }
@@ -246,6 +251,11 @@ public:
 	// We need to allow access to this, because on a restartGame, we need to restart with the settings we started with
 	Int getRankPointsToAddAtGameStart() const { return m_rankPointsToAddAtGameStart; }
 
+	// TheSuperHackers @fix The pathfinding options of the running game, see PathfindOption in GameInfo.h
+	Bool hasPathfindOption( UnsignedInt option ) const { return (m_pathfindOptions & option) != 0; }
+	UnsignedInt getPathfindOptions() const { return m_pathfindOptions; }
+	void setPathfindOptions( UnsignedInt options ) { m_pathfindOptions = options; }
+
   UnsignedShort getSuperweaponRestriction() const; ///< Get any optional limits on superweapons
   void setSuperweaponRestriction();
 
@@ -286,6 +296,7 @@ private:
 	void pauseGameInput(Bool paused);
 
 	void pushSleepyUpdate(UpdateModulePtr u);
+#if RETAIL_COMPATIBLE_SLEEPY_UPDATES
 	UpdateModulePtr peekSleepyUpdate() const;
 	void popSleepyUpdate();
 	void eraseSleepyUpdate(Int i);
@@ -294,6 +305,7 @@ private:
 	Int rebalanceChildSleepyUpdate(Int i);
 	void remakeSleepyUpdate();
 	void validateSleepyUpdate() const;
+#endif
 
 	bool onNewGame(GameMessage *msg);
 	bool onClearGameData(GameMessage *msg, AIGroupPtr &currentlySelectedGroup);
@@ -392,6 +404,8 @@ private:
 	UnsignedInt	m_CRC;																			///< Cache of previous CRC value
 	typedef std::map<Int, UnsignedInt> CachedCRCMap;
 	CachedCRCMap m_cachedCRCs;															///< CRCs we've seen this frame
+	typedef std::map<UnsignedInt, AsciiString> DeepCRCDumpMap;
+	DeepCRCDumpMap m_deepCRCDumps;													///< Deep CRC dump file names by frame
 	Bool m_shouldValidateCRCs;															///< Should we validate CRCs this frame?
 	//-----------------------------------------------------------------------------------------------
 	//Bool m_loadingScene;
@@ -404,6 +418,7 @@ private:
 	Bool m_hasUpdated;
 
 	Int m_rankPointsToAddAtGameStart;
+	UnsignedInt m_pathfindOptions;
 
 	Bool m_isScoringEnabled;
 	Bool m_showBehindBuildingMarkers;	//used by designers to override the user setting for cinematics
@@ -423,7 +438,12 @@ private:
 	// never modify it directly; please use the proper access methods.
 	// (for an excellent discussion of priority queues, please see:
 	// http://dogma.net/markn/articles/pq_stl/priority.htm)
+#if RETAIL_COMPATIBLE_SLEEPY_UPDATES
 	std::vector<UpdateModulePtr> m_sleepyUpdates;
+#else
+	// TheSuperHackers @performance The timing wheel pushes, reschedules and erases in constant time.
+	TimingWheel<UpdateModulePtr> m_sleepyUpdates;
+#endif
 
 #ifdef ALLOW_NONSLEEPY_UPDATES
 	// this is a plain old list, not a pq.
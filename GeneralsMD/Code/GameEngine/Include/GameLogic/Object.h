@@ -37,6 +37,7 @@
 #include "Common/Thing.h"
 #include "Common/ObjectStatusTypes.h"
 #include "Common/Upgrade.h"
+#include "Common/XferCRC.h"
 
 #include "GameClient/Color.h"
 
@@ -235,6 +236,9 @@ public:
 	void createVeterancyLevelFX(VeterancyLevel oldLevel, VeterancyLevel newLevel);
 	ExperienceTracker* getExperienceTracker() {return m_experienceTracker;}
 	const ExperienceTracker* getExperienceTracker() const {return m_experienceTracker;}
+
+	/// Must be called whenever a value changes that crcState passes to the CRC.
+	void invalidateCRCState() { m_crcStateRecording.invalidate(); }
 	VeterancyLevel getVeterancyLevel() const;
 
 	inline const AsciiString& getName() const { return m_name; }
@@ -652,6 +656,7 @@ protected:
 	virtual void crc( Xfer *xfer ) override;
 	virtual void xfer( Xfer *xfer ) override;
 	virtual void loadPostProcess() override;
+	void crcState( Xfer *xfer );
 
 	void handleShroud();
 	void handleValueMap();
@@ -809,6 +814,8 @@ private:
 
 	UnsignedInt										m_safeOcclusionFrame;	///<flag used by occlusion renderer so it knows when objects have exited their production building.
 
+	CRCRecording									m_crcStateRecording;			///< cached CRC data of crcState
+
 	// --------- BYTE-SIZED THINGS GO HERE
 	Bool													m_isSelectable;
 	Bool													m_modulesReady;
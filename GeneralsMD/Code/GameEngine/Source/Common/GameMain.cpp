@@ -30,7 +30,9 @@
 
 #include "Common/FramePacer.h"
 #include "Common/GameEngine.h"
+#include "Common/INIBenchmark.h"
 #include "Common/ReplaySimulation.h"
+#include "GameLogic/PathfindBenchmark.h"
 
 
 /**
@@ -49,6 +51,15 @@ Int GameMain()
 	{
 		exitcode = ReplaySimulation::simulateReplays(TheGlobalData->m_simulateReplays, TheGlobalData->m_simulateReplayJobs);
 	}
+	else if (TheGlobalData->m_pathfindBenchmarkMap.isNotEmpty())
+	{
+		exitcode = PathfindBenchmark::run(TheGlobalData->m_pathfindBenchmarkMap, TheGlobalData->m_pathfindBenchmarkQueries,
+			TheGlobalData->m_pathfindBenchmarkSeed);
+	}
+	else if (TheGlobalData->m_iniBenchmarkRepeats > 0)
+	{
+		exitcode = INIBenchmark::run(TheGlobalData->m_iniBenchmarkRepeats);
+	}
 	else
 	{
 		// run it
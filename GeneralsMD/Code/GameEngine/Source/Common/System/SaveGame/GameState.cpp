@@ -52,6 +52,8 @@
 #include "GameClient/InGameUI.h"
 #include "GameClient/ParticleSys.h"
 #include "GameClient/TerrainVisual.h"
+#include "GameLogic/AI.h"
+#include "GameLogic/AIPathfind.h"
 #include "GameLogic/GameLogic.h"
 #include "GameLogic/GhostObject.h"
 #include "GameLogic/PartitionManager.h"
@@ -311,6 +313,9 @@ void GameState::init()
 	addSnapshotBlock( "CHUNK_TeamFactory",						TheTeamFactory,						SNAPSHOT_SAVELOAD );
 	addSnapshotBlock( "CHUNK_Players",								ThePlayerList,						SNAPSHOT_SAVELOAD );
 	addSnapshotBlock( "CHUNK_GameLogic",							TheGameLogic,							SNAPSHOT_SAVELOAD );
+	// TheSuperHackers @fix The pathfinder must follow the game logic, which classifies the map on load.
+	// Older games skip this block, like any other unknown block.
+	addSnapshotBlock( "CHUNK_Pathfinder",							TheAI->pathfinder(),			SNAPSHOT_SAVELOAD );
 	addSnapshotBlock( "CHUNK_Radar",									TheRadar,									SNAPSHOT_SAVELOAD );
 	addSnapshotBlock( "CHUNK_ScriptEngine",						TheScriptEngine,					SNAPSHOT_SAVELOAD );
 	addSnapshotBlock( "CHUNK_SidesList",							TheSidesList,							SNAPSHOT_SAVELOAD );
@@ -321,6 +326,8 @@ void GameState::init()
 	addSnapshotBlock( "CHUNK_ParticleSystem",					TheParticleSystemManager,	SNAPSHOT_SAVELOAD );
 	addSnapshotBlock( "CHUNK_TerrainVisual",					TheTerrainVisual,					SNAPSHOT_SAVELOAD );
 	addSnapshotBlock( "CHUNK_GhostObject",						TheGhostObjectManager,		SNAPSHOT_SAVELOAD );
+	// TheSuperHackers @fix The random seeds go last, so that they are applied after everything else has been loaded.
+	addSnapshotBlock( "CHUNK_GameLogicRandom",				TheGameLogicRandomState,	SNAPSHOT_SAVELOAD );
 
 	// add all the snapshot objects to our list of data blocks for deep CRCs of logic
 	addSnapshotBlock( "CHUNK_TeamFactory",						TheTeamFactory,						SNAPSHOT_DEEPCRC_LOGICONLY );
@@ -674,41 +681,12 @@ SaveCode GameState::loadGame( AvailableGameInfo gameInfo )
 	// clear out the game engine
 	TheGameEngine->reset();
 
-	// lock creation of new ghost objects
-	TheGhostObjectManager->saveLockGhostObjects( TRUE );
-
-	LatchRestore<Bool> inLoadGame(m_isInLoadGame, TRUE);
-
 	// load the save data
-	Bool error = FALSE;
-	try
-	{
-
-		// load file
-		xferSaveData( &xferLoad, SNAPSHOT_SAVELOAD );
-
-	}
-	catch( ... )
-	{
-		error = TRUE;
-	}
+	Bool error = loadGameFromXfer( &xferLoad ) != SC_OK;
 
 	// close the file
 	xferLoad.close();
 
-	// un-savelock the ghost objects
-	TheGhostObjectManager->saveLockGhostObjects( FALSE );
-
-	try
-	{
-		// do the post-process from a save game load
-		gameStatePostProcessLoad();
-	}
-	catch (...)
-	{
-		error = TRUE;
-	}
-
 	// check for error
 	if( error == TRUE )
 	{
@@ -757,6 +735,83 @@ SaveCode GameState::loadGame( AvailableGameInfo gameInfo )
 
 }
 
+// ------------------------------------------------------------------------------------------------
+/** Save the game into an xfer that is already open, such as a memory buffer. Unlike saveGame
+	* this does not show any messages to the user */
+// ------------------------------------------------------------------------------------------------
+SaveCode GameState::saveGameToXfer( Xfer *xfer )
+{
+
+	// TheSuperHackers @fix Saving fills in the save game info of the game, which must stay as it is when
+	// nothing is written to the save directory. The save data is a normal save game nonetheless.
+	SaveGameInfo *gameInfo = getSaveGameInfo();
+	const SaveGameInfo savedGameInfo = *gameInfo;
+	gameInfo->saveFileType = SAVE_FILE_TYPE_NORMAL;
+	gameInfo->missionMapName.clear();
+
+	SaveCode result = SC_OK;
+	try
+	{
+
+		xferSaveData( xfer, SNAPSHOT_SAVELOAD );
+
+	}
+	catch( ... )
+	{
+
+		DEBUG_LOG(( "GameState::saveGameToXfer - Error saving to '%s'", xfer->getIdentifier().str() ));
+		result = SC_ERROR;
+
+	}
+
+	*gameInfo = savedGameInfo;
+	return result;
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Load the game from an xfer that is already open. The game engine must have been reset
+	* before. Unlike loadGame this does not show any messages to the user */
+// ------------------------------------------------------------------------------------------------
+SaveCode GameState::loadGameFromXfer( Xfer *xfer )
+{
+
+	// lock creation of new ghost objects
+	TheGhostObjectManager->saveLockGhostObjects( TRUE );
+
+	LatchRestore<Bool> inLoadGame(m_isInLoadGame, TRUE);
+
+	// load the save data
+	Bool error = FALSE;
+	try
+	{
+
+		// load file
+		xferSaveData( xfer, SNAPSHOT_SAVELOAD );
+
+	}
+	catch( ... )
+	{
+		error = TRUE;
+	}
+
+	// un-savelock the ghost objects
+	TheGhostObjectManager->saveLockGhostObjects( FALSE );
+
+	try
+	{
+		// do the post-process from a save game load
+		gameStatePostProcessLoad();
+	}
+	catch (...)
+	{
+		error = TRUE;
+	}
+
+	return error ? SC_INVALID_DATA : SC_OK;
+
+}
+
 //-------------------------------------------------------------------------------------------------
 AsciiString GameState::getSaveDirectory() const
 {
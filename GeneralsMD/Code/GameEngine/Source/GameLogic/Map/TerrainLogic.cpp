@@ -2659,6 +2659,9 @@ void TerrainLogic::flattenTerrain(Object *obj)
 		return;
 	}
 
+	// TheSuperHackers @performance The heights change, so the cached line of sight results are stale.
+	ThePartitionManager->clearLineOfSightCache();
+
 	const Coord3D *pos = obj->getPosition();
 	switch(obj->getGeometryInfo().getGeomType())
 	{
@@ -2882,6 +2885,9 @@ void TerrainLogic::createCraterInTerrain(Object *obj)
   if ( radius <= 0.0f )
     return; // sanity
 
+	// TheSuperHackers @performance The heights change, so the cached line of sight results are stale.
+	ThePartitionManager->clearLineOfSightCache();
+
   ICoord2D iMin, iMax;
   iMin.x = REAL_TO_INT_FLOOR( ( pos->x - radius ) / MAP_XY_FACTOR );
   iMin.y = REAL_TO_INT_FLOOR( ( pos->y - radius ) / MAP_XY_FACTOR );
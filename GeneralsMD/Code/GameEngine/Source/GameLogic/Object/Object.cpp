@@ -859,6 +859,7 @@ void Object::setGeometryInfoZ( Real newZ )
 //=============================================================================
 void Object::friend_setUndetectedDefector( Bool status )
 {
+	invalidateCRCState();
 	if (status)
 		m_privateStatus |= UNDETECTED_DEFECTOR;
 	else
@@ -1859,6 +1860,7 @@ void Object::reactToTurretChange( WhichTurretType turret, Real oldRotation, Real
 void Object::reactToTransformChange(const Matrix3D* oldMtx, const Coord3D* oldPos, Real oldAngle)
 {
 	//USE_PERF_TIMER(Object_reactToTransformChange)
+	invalidateCRCState();
 	if(_isnan(getPosition()->x) || _isnan(getPosition()->y) || _isnan(getPosition()->z)) {
 		DEBUG_CRASH(("Object pos is nan."));
 		TheGameLogic->destroyObject(this);
@@ -2850,6 +2852,7 @@ void Object::setID( ObjectID id )
 
 	// assign new id
 	m_id = id;
+	invalidateCRCState();
 
 	// add new id to lookup table
 	TheGameLogic->addObjectToLookupTable( this );
@@ -2920,6 +2923,7 @@ void Object::friend_notifyOfNewMapBoundary()
 		m_privateStatus &= ~OFF_MAP;
 	else
 		m_privateStatus |= OFF_MAP;
+	invalidateCRCState();
 }
 
 
@@ -3984,9 +3988,9 @@ void Object::onDisabledEdge(Bool becomingDisabled)
 }
 
 //-------------------------------------------------------------------------------------------------
-/** Object CRC implementation */
+/** CRC of the object state, excluding the weapons */
 //-------------------------------------------------------------------------------------------------
-void Object::crc( Xfer *xfer )
+void Object::crcState( Xfer *xfer )
 {
 #ifdef DEBUG_CRC
 //	g_logObjectCRCs = TRUE;
@@ -4095,6 +4099,49 @@ void Object::crc( Xfer *xfer )
 		CRCDEBUG_LOG(("%s", logString.str()));
 	}
 #endif // DEBUG_CRC
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Object CRC implementation */
+//-------------------------------------------------------------------------------------------------
+void Object::crc( Xfer *xfer )
+{
+	// TheSuperHackers @performance The object state changes far less often than it is CRC'd, so the data
+	// of crcState is recorded once and reused until the state is invalidated. The weapons change with
+	// every shot and reload and are always CRC'd directly.
+	Bool useRecording = xfer->getXferMode() == XFER_CRC;
+#ifdef DEBUG_CRC
+	useRecording = useRecording && !g_logObjectCRCs;
+#endif // DEBUG_CRC
+
+	if (useRecording)
+	{
+		if (!m_crcStateRecording.isValid())
+		{
+			XferCRCRecorder recorder(&m_crcStateRecording);
+			recorder.open(AsciiString::TheEmptyString);
+			crcState(&recorder);
+			recorder.close();
+		}
+#ifdef DEBUG_CRC
+		else
+		{
+			// Verify that all changes of the state invalidated the recording
+			CRCRecording verification;
+			XferCRCRecorder recorder(&verification);
+			recorder.open(AsciiString::TheEmptyString);
+			crcState(&recorder);
+			recorder.close();
+			DEBUG_ASSERTCRASH(verification.isEqual(m_crcStateRecording), ("Object::crc - CRC state of object %d (%s) changed without invalidation",
+				m_id, getTemplate()->getName().str()));
+		}
+#endif // DEBUG_CRC
+		static_cast<XferCRC *>(xfer)->xferRecording(&m_crcStateRecording);
+	}
+	else
+	{
+		crcState(xfer);
+	}
 
 	for (Int i=0; i<WEAPONSLOT_COUNT; ++i)
 	{
@@ -4124,6 +4171,9 @@ void Object::crc( Xfer *xfer )
 void Object::xfer( Xfer *xfer )
 {
 
+	// loading changes the CRC state
+	invalidateCRCState();
+
 	// version
 	const XferVersion currentVersion = 9;
 	XferVersion version = currentVersion;
@@ -4594,6 +4644,7 @@ void Object::giveUpgrade( const UpgradeTemplate *upgradeT )
 	if (upgradeT)
 	{
 		m_objectUpgradesCompleted.set( upgradeT->getUpgradeMask() );
+		invalidateCRCState();
 
 		//
 		// iterate through all the upgrade modules of this object and call the method to
@@ -4609,6 +4660,7 @@ void Object::giveUpgrade( const UpgradeTemplate *upgradeT )
 void Object::removeUpgrade( const UpgradeTemplate *upgradeT )
 {
 	m_objectUpgradesCompleted.clear( upgradeT->getUpgradeMask() );
+	invalidateCRCState();
 	for (BehaviorModule** module = m_behaviors; *module; ++module)
 	{
 		UpgradeModuleInterface* upgrade = (*module)->getUpgrade();
@@ -4788,6 +4840,8 @@ void Object::setWeaponBonusCondition(WeaponBonusConditionType wst)
 
 	if( oldCondition != m_weaponBonusCondition )
 	{
+		invalidateCRCState();
+
 		// Our weapon bonus just changed, so we need to immediately update our weapons
 		m_weaponSet.weaponSetOnWeaponBonusChange(this);
 	}
@@ -4801,6 +4855,8 @@ void Object::clearWeaponBonusCondition(WeaponBonusConditionType wst)
 
 	if( oldCondition != m_weaponBonusCondition )
 	{
+		invalidateCRCState();
+
 		// Our weapon bonus just changed, so we need to immediately update our weapons
 		m_weaponSet.weaponSetOnWeaponBonusChange(this);
 	}
@@ -62,6 +62,7 @@
 #include "Common/Radar.h"
 #include "Common/ThingFactory.h"	// for bullet type hack
 #include "Common/ThingTemplate.h"
+#include "Common/WorkerThreadPool.h"
 #include "Common/Xfer.h"
 
 #include "GameLogic/AIPathfind.h"
@@ -1465,7 +1466,8 @@ void PartitionCell::friend_addToCellList(CellAndObjectIntersection *coi)
 	if (coi)
 	{
 		coi->friend_addToCellList(&m_firstCoiInCell);
-		++m_coiCount;
+		if (++m_coiCount == 1)
+			ThePartitionManager->friend_setCellOccupied(m_cellX, m_cellY, true);
 	}
 }
 
@@ -1475,7 +1477,8 @@ void PartitionCell::friend_removeFromCellList(CellAndObjectIntersection *coi)
 	if (coi)
 	{
 		coi->friend_removeFromCellList(&m_firstCoiInCell);
-		--m_coiCount;
+		if (--m_coiCount == 0)
+			ThePartitionManager->friend_setCellOccupied(m_cellX, m_cellY, false);
 	}
 }
 
@@ -1557,6 +1560,7 @@ PartitionData::PartitionData()
 	m_doneFlag = 0;
 	m_dirtyStatus = NOT_DIRTY;
 	m_lastCell = nullptr;
+	m_coverageJobIndex = -1;
 	for (int i = 0; i < MAX_PLAYER_COUNT; ++i)
 	{
 		m_everSeenByPlayer[i] = false;
@@ -1740,37 +1744,71 @@ void PartitionData::removeAllTouchedCells()
 }
 
 // -----------------------------------------------------------------------------
-void PartitionData::addSubPixToCoverage(PartitionCell *cell)
+PartitionCellCoverage::PartitionCellCoverage(PartitionManager *partitionManager, PartitionCell **cells, Int maxCellCount) :
+	m_partitionManager(partitionManager),
+	m_cells(cells),
+	m_cellCount(0),
+	m_maxCellCount(maxCellCount)
 {
-	DEBUG_ASSERTCRASH(m_coiInUseCount < m_coiArrayCount, ("not enough cois allocated for this object"));
-	if (cell)
+}
+
+// -----------------------------------------------------------------------------
+void PartitionCellCoverage::calcCellsTouched(const PartitionCoverageShape &shape)
+{
+	m_cellCount = 0;
+	if (shape.m_isSmall)
 	{
-		// see if we already have a coi for this cell.
-		CellAndObjectIntersection *coi = m_coiArray;
-		CellAndObjectIntersection *coiToUse = nullptr;
-		for (Int i = __min(m_coiInUseCount,m_coiArrayCount); i; --i, ++coi)
+		doSmallFill(shape.m_pos.x, shape.m_pos.y, shape.m_majorRadius);
+	}
+	else
+	{
+		switch(shape.m_geom)
 		{
-			if (coi->getCell() == cell)
+			case GEOMETRY_SPHERE:
+			case GEOMETRY_CYLINDER:
+			{
+#if RETAIL_COMPATIBLE_CRC || RETAIL_COMPATIBLE_CIRCLE_FILL_ALGORITHM
+				doCircleFill(shape.m_pos.x, shape.m_pos.y, shape.m_majorRadius);
+#else
+				// TheSuperHackers @bugfix Stubbjax 29/01/2026 Use precise circle fill to improve
+				// collision accuracy, most notably for objects with geometry radii >= 20 and < 40.
+				doCircleFillPrecise(shape.m_pos.x, shape.m_pos.y, shape.m_majorRadius);
+#endif
+				break;
+			}
+
+			case GEOMETRY_BOX:
 			{
-				coiToUse = coi;
+				doRectFill(shape.m_pos.x, shape.m_pos.y, shape.m_majorRadius, shape.m_minorRadius, shape.m_angle);
 				break;
 			}
-		}
-		DEBUG_ASSERTCRASH(coiToUse != nullptr || m_coiInUseCount < m_coiArrayCount, ("not enough cois allocated for this object"));
-		if (coiToUse == nullptr && m_coiInUseCount < m_coiArrayCount)
+		};
+	}
+}
+
+// -----------------------------------------------------------------------------
+void PartitionCellCoverage::addSubPixToCoverage(PartitionCell *cell)
+{
+	DEBUG_ASSERTCRASH(m_cellCount < m_maxCellCount, ("not enough cois allocated for this object"));
+	if (cell)
+	{
+		// see if we already have a coi for this cell.
+		PartitionCell **cellInUse = m_cells;
+		for (Int i = m_cellCount; i; --i, ++cellInUse)
 		{
-			// nope, no coi for this cell, allocate a new one
-			coiToUse = &m_coiArray[m_coiInUseCount++];
+			if (*cellInUse == cell)
+				return;
 		}
-		if (coiToUse)
+		// nope, no coi for this cell, allocate a new one
+		if (m_cellCount < m_maxCellCount)
 		{
-			coiToUse->addCoverage(cell, this);
+			m_cells[m_cellCount++] = cell;
 		}
 	}
 }
 
 // -----------------------------------------------------------------------------
-void PartitionData::doRectFill(
+void PartitionCellCoverage::doRectFill(
 	Real centerX,
 	Real centerY,
 	Real halfsizeX,
@@ -1781,7 +1819,7 @@ void PartitionData::doRectFill(
 	Real c = (Real)Cos(angle);
 	Real s = (Real)Sin(angle);
 
-	Real actualCellSize = ThePartitionManager->getCellSize();
+	Real actualCellSize = m_partitionManager->getCellSize();
 	Real stepSize = actualCellSize * 0.5f; // in theory, should be getCellSize() exactly, but needs to be smaller to avoid aliasing problems
 	Real ydx = s * stepSize;
 	Real ydy = -c * stepSize;
@@ -1816,8 +1854,8 @@ void PartitionData::doRectFill(
 		for (Int ix = 0; ix < numStepsX; ++ix, x += xdx, y += xdy)
 		{
 			Int cellx, celly;
-			ThePartitionManager->worldToCell(x, y, &cellx, &celly);
-			PartitionCell *cell = ThePartitionManager->getCellAt(cellx, celly);	// might be null if off the edge
+			m_partitionManager->worldToCell(x, y, &cellx, &celly);
+			PartitionCell *cell = m_partitionManager->getCellAt(cellx, celly);	// might be null if off the edge
 			if (cell)
 			{
 				addSubPixToCoverage(cell);
@@ -1828,11 +1866,11 @@ void PartitionData::doRectFill(
 }
 
 // -----------------------------------------------------------------------------
-void PartitionData::hLineCircle(Int x1, Int x2, Int y)
+void PartitionCellCoverage::hLineCircle(Int x1, Int x2, Int y)
 {
 	for (Int x = x1; x <= x2; ++x)
 	{
-		PartitionCell* cell = ThePartitionManager->getCellAt(x, y);
+		PartitionCell* cell = m_partitionManager->getCellAt(x, y);
 		if (cell)
 		{
       addSubPixToCoverage(cell);
@@ -1843,18 +1881,18 @@ void PartitionData::hLineCircle(Int x1, Int x2, Int y)
 // -----------------------------------------------------------------------------
 // Marks all partition cells that intersect a circle of the given center and radius
 // as covered by this object using a variation of the midpoint circle algorithm.
-void PartitionData::doCircleFill(
+void PartitionCellCoverage::doCircleFill(
 	Real centerX,
 	Real centerY,
 	Real radius
 )
 {
-	DEBUG_ASSERTCRASH(m_coiInUseCount == 0, ("expected no coi in use here"));
+	DEBUG_ASSERTCRASH(m_cellCount == 0, ("expected no coi in use here"));
 
 	Int cellCenterX, cellCenterY;
-	ThePartitionManager->worldToCell(centerX, centerY, &cellCenterX, &cellCenterY);
+	m_partitionManager->worldToCell(centerX, centerY, &cellCenterX, &cellCenterY);
 
-	Int cellRadius = ThePartitionManager->worldToCellDist(radius);
+	Int cellRadius = m_partitionManager->worldToCellDist(radius);
 	if (cellRadius < 1)
 		cellRadius = 1;
 
@@ -1894,13 +1932,13 @@ static Bool doesCircleOverlapCell(Real centerX, Real centerY, Real radius, Real
 	return (sqr(distX) + sqr(distY)) < sqr(radius);
 }
 
-void PartitionData::doCircleFillPrecise(Real centerX, Real centerY, Real radius)
+void PartitionCellCoverage::doCircleFillPrecise(Real centerX, Real centerY, Real radius)
 {
 	Int minCellX, minCellY, maxCellX, maxCellY;
-	ThePartitionManager->worldToCell(centerX - radius, centerY - radius, &minCellX, &minCellY);
-	ThePartitionManager->worldToCell(centerX + radius, centerY + radius, &maxCellX, &maxCellY);
+	m_partitionManager->worldToCell(centerX - radius, centerY - radius, &minCellX, &minCellY);
+	m_partitionManager->worldToCell(centerX + radius, centerY + radius, &maxCellX, &maxCellY);
 
-	Real cellSize = ThePartitionManager->getCellSize();
+	Real cellSize = m_partitionManager->getCellSize();
 
 	for (Int x = minCellX; x <= maxCellX; ++x)
 	{
@@ -1911,7 +1949,7 @@ void PartitionData::doCircleFillPrecise(Real centerX, Real centerY, Real radius)
 
 			if (doesCircleOverlapCell(centerX, centerY, radius, cellWorldX, cellWorldY, cellSize))
 			{
-				PartitionCell* cell = ThePartitionManager->getCellAt(x, y);
+				PartitionCell* cell = m_partitionManager->getCellAt(x, y);
 				if (cell)
 				{
 					addSubPixToCoverage(cell);
@@ -1922,15 +1960,15 @@ void PartitionData::doCircleFillPrecise(Real centerX, Real centerY, Real radius)
 }
 
 // -----------------------------------------------------------------------------
-void PartitionData::doSmallFill(
+void PartitionCellCoverage::doSmallFill(
 	Real centerX,
 	Real centerY,
 	Real radius
 )
 {
-	DEBUG_ASSERTCRASH(m_coiInUseCount == 0, ("expected no coi in use here"));
+	DEBUG_ASSERTCRASH(m_cellCount == 0, ("expected no coi in use here"));
 
-	Real halfCellSize = ThePartitionManager->getCellSize() * 0.5f;
+	Real halfCellSize = m_partitionManager->getCellSize() * 0.5f;
 	if (radius > halfCellSize)
 	{
 		DEBUG_CRASH(("object is too large to use a 'small' geometry, truncating size to cellsize"));
@@ -1938,8 +1976,8 @@ void PartitionData::doSmallFill(
 	}
 
 	Int cx1, cy1, cx2, cy2;
-	ThePartitionManager->worldToCell(centerX - radius, centerY - radius, &cx1, &cy1);
-	ThePartitionManager->worldToCell(centerX + radius, centerY + radius, &cx2, &cy2);
+	m_partitionManager->worldToCell(centerX - radius, centerY - radius, &cx1, &cy1);
+	m_partitionManager->worldToCell(centerX + radius, centerY + radius, &cx2, &cy2);
 
 	DEBUG_ASSERTCRASH(absInt(cx2-cx1)<=1,("bad cx"));
 	DEBUG_ASSERTCRASH(absInt(cy2-cy1)<=1,("bad cy"));
@@ -1948,25 +1986,33 @@ void PartitionData::doSmallFill(
 	{
 		for (Int y = cy1; y <= cy2; y++)
 		{
-			PartitionCell *cell = ThePartitionManager->getCellAt(x, y);
-			if (cell)
+			PartitionCell *cell = m_partitionManager->getCellAt(x, y);
+			if (cell && m_cellCount < m_maxCellCount)
 			{
-				m_coiArray[m_coiInUseCount++].addCoverage(cell, this);
+				m_cells[m_cellCount++] = cell;
 			}
 		}
 	}
 
 	#ifdef INTENSE_DEBUG
-	for (int i = 0; i < m_coiInUseCount; i++)
+	for (int i = 0; i < m_cellCount; i++)
 	{
 		for (int j = 0; j < i; j++)
 		{
-			DEBUG_ASSERTCRASH(m_coiArray[i].getCell() != m_coiArray[j].getCell(), ("dup cells"));
+			DEBUG_ASSERTCRASH(m_cells[i] != m_cells[j], ("dup cells"));
 		}
 	}
 	#endif
 }
 
+// -----------------------------------------------------------------------------
+void PartitionCoverageJob::calcCellsTouched(PartitionManager *partitionManager, PartitionCell **cells)
+{
+	PartitionCellCoverage coverage(partitionManager, cells + m_firstCell, m_maxCellCount);
+	coverage.calcCellsTouched(m_shape);
+	m_cellCount = coverage.getCellCount();
+}
+
 //-----------------------------------------------------------------------------
 void PartitionData::addPossibleCollisions(PartitionContactList *ctList)
 {
@@ -2075,73 +2121,71 @@ Bool PartitionManager::geomCollidesWithGeom(const Coord3D* pos1,
 }
 
 //-----------------------------------------------------------------------------
-void PartitionData::updateCellsTouched()
+Bool PartitionData::getCoverageShape(PartitionCoverageShape *shape) const
 {
-	GeometryType geom;
-	Bool isSmall;
-	Coord3D pos;
-	Real angle,majorRadius,minorRadius;
-
-
-	Object *obj = getObject();
+	const Object *obj = getObject();
 
 	if (obj)
 	{
-		//we have no object using this PartitionData but we still have a GhostObject so copy its data.
-		geom = obj->getGeometryInfo().getGeomType();
-		isSmall = obj->getGeometryInfo().getIsSmall();
-		pos = *(obj->getPosition());
-		angle = obj->getOrientation();
-		majorRadius = obj->getGeometryInfo().getMajorRadius();
-		minorRadius = obj->getGeometryInfo().getMinorRadius();
+		shape->m_geom = obj->getGeometryInfo().getGeomType();
+		shape->m_isSmall = obj->getGeometryInfo().getIsSmall();
+		shape->m_pos = *(obj->getPosition());
+		shape->m_angle = obj->getOrientation();
+		shape->m_majorRadius = obj->getGeometryInfo().getMajorRadius();
+		shape->m_minorRadius = obj->getGeometryInfo().getMinorRadius();
 	}
 	else if (m_ghostObject)
 	{
-		geom = m_ghostObject->getGeometryType();
-		isSmall = m_ghostObject->getGeometrySmall();
-		pos = *m_ghostObject->getParentPosition();
-		angle = m_ghostObject->getParentAngle();
-		majorRadius = m_ghostObject->getGeometryMajorRadius();
-		minorRadius = m_ghostObject->getGeometryMinorRadius();
+		//we have no object using this PartitionData but we still have a GhostObject so copy its data.
+		shape->m_geom = m_ghostObject->getGeometryType();
+		shape->m_isSmall = m_ghostObject->getGeometrySmall();
+		shape->m_pos = *m_ghostObject->getParentPosition();
+		shape->m_angle = m_ghostObject->getParentAngle();
+		shape->m_majorRadius = m_ghostObject->getGeometryMajorRadius();
+		shape->m_minorRadius = m_ghostObject->getGeometryMinorRadius();
 	}
 	else
+	{
+		return false;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void PartitionData::updateCellsTouched()
+{
+	PartitionCoverageShape shape;
+	if (!getCoverageShape(&shape))
 	{
 		DEBUG_CRASH(("must be attached to an Object here"));
 		return;
 	}
 
+	PartitionCell **cells = ThePartitionManager->friend_getUpdateCells(m_coiArrayCount);
+	PartitionCellCoverage coverage(ThePartitionManager, cells, m_coiArrayCount);
+	coverage.calcCellsTouched(shape);
+	updateCellsTouched(shape, cells, coverage.getCellCount());
+}
+
+//-----------------------------------------------------------------------------
+void PartitionData::updateCellsTouched(const PartitionCoverageShape &shape, PartitionCell * const *cells, Int cellCount)
+{
 	removeAllTouchedCells();
-	if (isSmall)
+
+	// TheSuperHackers @performance The cells may have been calculated on another thread. The COIs are linked
+	// into the cells here, in the order in which the fill found the cells, so the cell lists are the same either way.
+	DEBUG_ASSERTCRASH(cellCount <= m_coiArrayCount, ("not enough cois allocated for this object"));
+	for (Int i = 0; i < cellCount; ++i)
 	{
-		doSmallFill(pos.x, pos.y, majorRadius);
+		m_coiArray[i].addCoverage(cells[i], this);
 	}
-	else
-	{
-		switch(geom)
-		{
-			case GEOMETRY_SPHERE:
-			case GEOMETRY_CYLINDER:
-			{
-#if RETAIL_COMPATIBLE_CRC || RETAIL_COMPATIBLE_CIRCLE_FILL_ALGORITHM
-				doCircleFill(pos.x, pos.y, majorRadius);
-#else
-				// TheSuperHackers @bugfix Stubbjax 29/01/2026 Use precise circle fill to improve
-				// collision accuracy, most notably for objects with geometry radii >= 20 and < 40.
-				doCircleFillPrecise(pos.x, pos.y, majorRadius);
-#endif
-				break;
-			}
+	m_coiInUseCount = cellCount;
 
-			case GEOMETRY_BOX:
-			{
-				doRectFill(pos.x, pos.y, majorRadius, minorRadius, angle);
-				break;
-			}
-		};
-	}
+	Object *obj = getObject();
 
 	Int currentCellIndexX, currentCellIndexY;
-	ThePartitionManager->worldToCell( pos.x, pos.y, &currentCellIndexX, &currentCellIndexY );
+	ThePartitionManager->worldToCell( shape.m_pos.x, shape.m_pos.y, &currentCellIndexX, &currentCellIndexY );
 	const PartitionCell *currentCell = ThePartitionManager->getCellAt( currentCellIndexX, currentCellIndexY );
 	if(obj && currentCell != m_lastCell )
 	{
@@ -2609,6 +2653,66 @@ void PartitionContactList::processContactList()
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+PartitionLineOfSightCache::PartitionLineOfSightCache() :
+	m_hits(0),
+	m_misses(0)
+{
+	clear();
+}
+
+//-----------------------------------------------------------------------------
+void PartitionLineOfSightCache::clear()
+{
+	for (Int i = 0; i < MAX_ENTRIES; ++i)
+		m_entries[i].m_used = false;
+}
+
+//-----------------------------------------------------------------------------
+Int PartitionLineOfSightCache::getIndex(const Coord3D& pos, const Coord3D& posOther)
+{
+	UnsignedInt bits[4];
+	memcpy(&bits[0], &pos.x, sizeof(bits[0]));
+	memcpy(&bits[1], &pos.y, sizeof(bits[1]));
+	memcpy(&bits[2], &posOther.x, sizeof(bits[2]));
+	memcpy(&bits[3], &posOther.y, sizeof(bits[3]));
+	UnsignedInt h = bits[0];
+	for (Int i = 1; i < 4; ++i)
+		h = h * 31 + bits[i];
+	h ^= h >> 16;
+	return (Int)(h & (MAX_ENTRIES - 1));
+}
+
+//-----------------------------------------------------------------------------
+Bool PartitionLineOfSightCache::find(const Coord3D& pos, const Coord3D& posOther, Bool& isClear)
+{
+	const Entry& entry = m_entries[getIndex(pos, posOther)];
+	if (entry.m_used
+		&& entry.m_pos.x == pos.x && entry.m_pos.y == pos.y && entry.m_pos.z == pos.z
+		&& entry.m_posOther.x == posOther.x && entry.m_posOther.y == posOther.y && entry.m_posOther.z == posOther.z)
+	{
+		isClear = entry.m_isClear;
+		++m_hits;
+		return true;
+	}
+	++m_misses;
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+void PartitionLineOfSightCache::add(const Coord3D& pos, const Coord3D& posOther, Bool isClear)
+{
+	Entry& entry = m_entries[getIndex(pos, posOther)];
+	entry.m_pos = pos;
+	entry.m_posOther = posOther;
+	entry.m_isClear = isClear;
+	entry.m_used = true;
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 PartitionManager::PartitionManager()
 {
@@ -2685,6 +2789,7 @@ void PartitionManager::init()
 		m_cellCountY = REAL_TO_INT_CEIL(m_worldExtents.height() * m_cellSizeInv);
 		m_totalCellCount = m_cellCountX * m_cellCountY;
 		m_cells = MSGNEW("PartitionManager_Cells") PartitionCell[m_totalCellCount];
+		m_occupiedCellBits.assign((m_totalCellCount + 31) / 32, 0);
 		for (Int x = 0; x < m_cellCountX; x++)
 		{
 			for (Int y = 0; y < m_cellCountY; y++)
@@ -2773,6 +2878,8 @@ void PartitionManager::shutdown()
 
 	delete [] m_cells;
 	m_cells = nullptr;
+	m_occupiedCellBits.clear();
+	m_lineOfSightCache.clear();
 
 	m_cellSize = m_cellSizeInv = 0.0f;
 	m_cellCountX = 0;
@@ -2782,6 +2889,78 @@ void PartitionManager::shutdown()
 	m_worldExtents.hi.zero();
 }
 
+//-----------------------------------------------------------------------------
+/**
+	Calculates the cells of a range of coverage jobs. This only reads the cells
+	of the partition manager, so it can run on the worker threads.
+*/
+class PartitionCoverageJobRunner : public ParallelJob
+{
+public:
+	PartitionCoverageJobRunner(PartitionManager *partitionManager, PartitionCoverageJob *jobs, PartitionCell **cells) :
+		m_partitionManager(partitionManager), m_jobs(jobs), m_cells(cells)
+	{
+	}
+
+	virtual void run(Int begin, Int end) override
+	{
+		for (Int i = begin; i < end; ++i)
+		{
+			m_jobs[i].calcCellsTouched(m_partitionManager, m_cells);
+		}
+	}
+
+private:
+	PartitionManager *m_partitionManager;
+	PartitionCoverageJob *m_jobs;
+	PartitionCell **m_cells;
+};
+
+// below this number of modules, waking the worker threads costs more than it saves.
+static const Int MIN_PARALLEL_COVERAGE_JOBS = 64;
+static const Int COVERAGE_JOB_BATCH_SIZE = 16;
+
+//-----------------------------------------------------------------------------
+void PartitionManager::calcCoverageOfDirtyModules()
+{
+	m_coverageJobs.clear();
+	if (TheWorkerThreadPool == nullptr || TheWorkerThreadPool->getThreadCount() == 0)
+		return;
+
+	Int cellCount = 0;
+	for (PartitionData *dirty = m_dirtyModules; dirty; dirty = dirty->friend_getNextDirty())
+	{
+		if (!dirty->isInNeedOfUpdatingCells())
+			continue;
+
+		PartitionCoverageJob job;
+		if (!dirty->friend_getCoverageShape(&job.m_shape))
+			continue;
+
+		job.m_module = dirty;
+		job.m_firstCell = cellCount;
+		job.m_maxCellCount = dirty->friend_getCoiArrayCount();
+		job.m_cellCount = 0;
+		dirty->friend_setCoverageJobIndex((Int)m_coverageJobs.size());
+		m_coverageJobs.push_back(job);
+		cellCount += job.m_maxCellCount;
+	}
+
+	if ((Int)m_coverageJobs.size() < MIN_PARALLEL_COVERAGE_JOBS || cellCount == 0)
+	{
+		for (size_t i = 0; i < m_coverageJobs.size(); ++i)
+			m_coverageJobs[i].m_module->friend_setCoverageJobIndex(-1);
+		m_coverageJobs.clear();
+		return;
+	}
+
+	if ((Int)m_coverageCells.size() < cellCount)
+		m_coverageCells.resize(cellCount);
+
+	PartitionCoverageJobRunner runner(this, &m_coverageJobs[0], &m_coverageCells[0]);
+	TheWorkerThreadPool->runParallel(runner, (Int)m_coverageJobs.size(), COVERAGE_JOB_BATCH_SIZE);
+}
+
 //-----------------------------------------------------------------------------
 //DECLARE_PERF_TIMER(PartitionManager_update)
 void PartitionManager::update()
@@ -2796,6 +2975,13 @@ void PartitionManager::update()
 			m_updatedSinceLastReset = true;
 		}
 
+		PROFILER_PLOT("TerrainLineOfSightCacheHits", (double)m_lineOfSightCache.getHits());
+		PROFILER_PLOT("TerrainLineOfSightCacheMisses", (double)m_lineOfSightCache.getMisses());
+
+		// TheSuperHackers @performance Calculate the cells touched by the dirty modules up front, on the worker
+		// threads. The modules are still linked into the cells and checked for collisions one by one below.
+		calcCoverageOfDirtyModules();
+
 		PartitionContactList ctList;
 		TheContactList = &ctList;
 		while (m_dirtyModules)
@@ -2819,7 +3005,23 @@ void PartitionManager::update()
 
 			if (updateEm)
 			{
-				dirty->friend_updateCellsTouched();
+				// Use the calculated cells unless the module moved or changed shape in the meantime.
+				const Int jobIndex = dirty->friend_getCoverageJobIndex();
+				PartitionCoverageShape shape;
+				if (jobIndex >= 0 && jobIndex < (Int)m_coverageJobs.size()
+					&& m_coverageJobs[jobIndex].m_module == dirty
+					&& m_coverageJobs[jobIndex].m_maxCellCount == dirty->friend_getCoiArrayCount()
+					&& dirty->friend_getCoverageShape(&shape)
+					&& shape.isSameAs(m_coverageJobs[jobIndex].m_shape))
+				{
+					const PartitionCoverageJob &job = m_coverageJobs[jobIndex];
+					dirty->friend_updateCellsTouched(shape, &m_coverageCells[0] + job.m_firstCell, job.m_cellCount);
+				}
+				else
+				{
+					dirty->friend_updateCellsTouched();
+				}
+				dirty->friend_setCoverageJobIndex(-1);
 			}
 
 			if (collideEm && !dirty->getObject()->isKindOf(KINDOF_IMMOBILE))
@@ -2828,6 +3030,8 @@ void PartitionManager::update()
 			}
 		}
 
+		m_coverageJobs.clear();
+
 		ctList.processContactList();
 #ifdef INTENSE_DEBUG
 		DEBUG_ASSERTLOG(cc==0,("updated partition info for %d objects",cc));
@@ -3710,6 +3914,9 @@ SimpleObjectIterator *PartitionManager::iterateObjectsInRange(
 	return iter;
 }
 
+//-----------------------------------------------------------------------------
+static const Real POTENTIAL_COLLISION_SLOP = 1.1f;
+
 //-----------------------------------------------------------------------------
 SimpleObjectIterator* PartitionManager::iteratePotentialCollisions(
 	const Coord3D* pos,
@@ -3719,7 +3926,7 @@ SimpleObjectIterator* PartitionManager::iteratePotentialCollisions(
 )
 {
 	Real maxDist = geom.getBoundingSphereRadius();
-	maxDist *= 1.1f;	// just a little slop
+	maxDist *= POTENTIAL_COLLISION_SLOP;	// just a little slop
 
 	MemoryPoolObjectHolder iterHolder;
 	SimpleObjectIterator *iter = newInstance(SimpleObjectIterator);
@@ -3734,6 +3941,60 @@ SimpleObjectIterator* PartitionManager::iteratePotentialCollisions(
 	return iter;
 }
 
+//-----------------------------------------------------------------------------
+/**
+	TheSuperHackers @performance Tests the bits of the cells that getClosestObjects goes through for
+	iteratePotentialCollisions with a sphere of the given radius. If none of them is set, no object can
+	collide, so the caller can skip creating the iterator.
+*/
+Bool PartitionManager::isAnyCellOccupiedAround( const Coord3D *pos, Real boundingSphereRadius )
+{
+#ifdef FASTER_GCO
+	if (m_occupiedCellBits.empty())
+		return true;
+
+	Int cellCenterX, cellCenterY;
+	worldToCell(pos->x, pos->y, &cellCenterX, &cellCenterY);
+
+	Real maxDist = boundingSphereRadius * POTENTIAL_COLLISION_SLOP;
+	Int maxRadius = m_maxGcoRadius;
+	if (maxDist < HUGE_DIST)
+		maxRadius = minInt(m_maxGcoRadius, worldToCellDist(maxDist));
+
+	for (Int curRadius = 0; curRadius <= maxRadius; ++curRadius)
+	{
+		const OffsetVec& offsets = m_radiusVec[curRadius];
+		for (OffsetVec::const_iterator it = offsets.begin(); it != offsets.end(); ++it)
+		{
+			Int x = cellCenterX + it->x;
+			Int y = cellCenterY + it->y;
+			if (x < 0 || y < 0 || x >= m_cellCountX || y >= m_cellCountY)
+				continue;
+
+			Int index = y * m_cellCountX + x;
+			if (m_occupiedCellBits[index >> 5] & (1u << (index & 31)))
+				return true;
+		}
+	}
+	return false;
+#else
+	return true;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void PartitionManager::friend_setCellOccupied(Int x, Int y, Bool occupied)
+{
+	if (x < 0 || y < 0 || x >= m_cellCountX || y >= m_cellCountY || m_occupiedCellBits.empty())
+		return;
+
+	Int index = y * m_cellCountX + x;
+	if (occupied)
+		m_occupiedCellBits[index >> 5] |= (1u << (index & 31));
+	else
+		m_occupiedCellBits[index >> 5] &= ~(1u << (index & 31));
+}
+
 //-----------------------------------------------------------------------------
 Bool PartitionManager::isColliding( const Object *a, const Object *b ) const
 {
@@ -3782,6 +4043,9 @@ SimpleObjectIterator *PartitionManager::iterateAllObjects(PartitionFilter **filt
 }
 
 // ------------------------------------------------------------------------------------------------
+// the radius of the sphere around a position that must not overlap any object for findPositionAround
+static const Real FIND_POSITION_COLLISION_RADIUS = 5.0f;
+
 // ------------------------------------------------------------------------------------------------
 Bool PartitionManager::tryPosition( const Coord3D *center,
 																		Real dist,
@@ -3858,14 +4122,17 @@ Bool PartitionManager::tryPosition( const Coord3D *center,
 	}
 
 	// object checks
-	if( BitIsSet( options->flags, FPF_IGNORE_ALL_OBJECTS ) == FALSE )
+	// TheSuperHackers @performance Skip them if no object touches the cells around the position.
+	// Nothing could overlap the position then, so the same positions are found.
+	if( BitIsSet( options->flags, FPF_IGNORE_ALL_OBJECTS ) == FALSE &&
+			isAnyCellOccupiedAround( &pos, FIND_POSITION_COLLISION_RADIUS ) )
 	{
 
 		//
 		// iterate the potential collisions at this location using a
 		// very small sphere geometry around the point
 		//
-		GeometryInfo geometry( GEOMETRY_SPHERE, TRUE, 5.0f, 5.0f, 5.0f );
+		GeometryInfo geometry( GEOMETRY_SPHERE, TRUE, FIND_POSITION_COLLISION_RADIUS, FIND_POSITION_COLLISION_RADIUS, FIND_POSITION_COLLISION_RADIUS );
 		ObjectIterator *iter = iteratePotentialCollisions( &pos, geometry, angle, true );
 		MemoryPoolObjectHolder hold( iter );
 //	Bool overlap = FALSE;
@@ -4640,7 +4907,14 @@ Bool PartitionManager::isClearLineOfSightTerrain(const Object* obj, const Coord3
 	return true;
 
 #else
-	return TheTerrainLogic->isClearLineOfSight(pos, posOther);
+	// TheSuperHackers @performance Reuse the result of a recent query between the same positions.
+	Bool isClear;
+	if (m_lineOfSightCache.find(pos, posOther, isClear))
+		return isClear;
+
+	isClear = TheTerrainLogic->isClearLineOfSight(pos, posOther);
+	m_lineOfSightCache.add(pos, posOther, isClear);
+	return isClear;
 #endif
 }
 
@@ -4776,7 +5050,7 @@ void PartitionManager::xfer( Xfer *xfer )
 // ------------------------------------------------------------------------------------------------
 void PartitionManager::loadPostProcess()
 {
-
+	m_lineOfSightCache.clear();
 }
 
 //-----------------------------------------------------------------------------
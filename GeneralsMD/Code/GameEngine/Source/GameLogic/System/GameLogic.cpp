@@ -51,6 +51,7 @@
 #include "Common/Radar.h"
 #include "Common/RandomValue.h"
 #include "Common/Recorder.h"
+#include "Common/ReplayBenchmark.h"
 #include "Common/StatsCollector.h"
 #include "Common/ThingFactory.h"
 #include "Common/Team.h"
@@ -249,6 +250,7 @@ GameLogic::GameLogic()
 	m_isInUpdate = FALSE;
 
 	m_rankPointsToAddAtGameStart = 0;
+	m_pathfindOptions = 0;
 
 	for(Int i = 0; i < MAX_SLOTS; i++)
 	{
@@ -472,11 +474,15 @@ void GameLogic::reset()
 #ifdef ALLOW_NONSLEEPY_UPDATES
 	m_normalUpdates.clear();
 #endif
+#if RETAIL_COMPATIBLE_SLEEPY_UPDATES
 	for (std::vector<UpdateModulePtr>::iterator it = m_sleepyUpdates.begin(); it != m_sleepyUpdates.end(); ++it)
 	{
 		(*it)->friend_setIndexInLogic(-1);
 	}
 	m_sleepyUpdates.clear();
+#else
+	m_sleepyUpdates.release(0);
+#endif
 	m_curUpdateModule = nullptr;
 
 	m_isScoringEnabled = TRUE;
@@ -494,6 +500,7 @@ void GameLogic::reset()
 	TheWeatherSetting = (WeatherSetting*) ws->deleteOverrides();
 
 	m_rankPointsToAddAtGameStart = 0;
+	m_pathfindOptions = 0;
 }
 
 static Object * placeObjectAtPosition(Int slotNum, AsciiString objectTemplateName, Coord3D& pos, Player *pPlayer,
@@ -1278,6 +1285,16 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
     }
   }
 
+	// TheSuperHackers @fix The pathfinding options come from the game info, so that all players use the
+	// host's options and replays use the recorded ones. Games without a game info use the command line.
+	// On a save game they are restored again in Pathfinder::xfer()
+	m_pathfindOptions = TheGameInfo ? TheGameInfo->getPathfindOptions() : GetCommandLinePathfindOptions();
+
+	// TheSuperHackers @feature The seek check compares the simulation of a replay with itself, so it can
+	// also check the pathfinding options of the command line on replays that were recorded without them.
+	if (TheGlobalData->m_replaySeekCheck && TheRecorder && TheRecorder->getMode() == RECORDERMODETYPE_SIMULATION_PLAYBACK)
+		m_pathfindOptions |= GetCommandLinePathfindOptions();
+
 	checkForDuplicateColors( TheGameInfo );
 
 	Bool isSkirmishOrSkirmishReplay = FALSE;
@@ -2577,6 +2594,7 @@ void GameLogic::processDestroyList()
 		}
 #endif
 
+#if RETAIL_COMPATIBLE_SLEEPY_UPDATES
 		/*
 			this looks odd, but is necessary; since erasing a single entry can shuffle others in the list
 			(in order to maintain its heap-ness), we must do two passes: one to find the updates for this
@@ -2609,6 +2627,20 @@ void GameLogic::processDestroyList()
 			eraseSleepyUpdate(idx);
 			DEBUG_ASSERTCRASH(sleepyUpdatesForThisObject[numSUO]->friend_getIndexInLogic() == -1, ("Hmm, expected index to be -1 here"));
 		}
+#else
+		// the wheel erases in constant time, so there is no need to search all sleepy updates for this object.
+		for (BehaviorModule** b = currentObject->getBehaviorModules(); *b; ++b)
+		{
+#ifdef DIRECT_UPDATEMODULE_ACCESS
+			// evil, but necessary at this point. (srj)
+			UpdateModulePtr u = (UpdateModulePtr)((*b)->getUpdate());
+#else
+			UpdateModulePtr u = (*b)->getUpdate();
+#endif
+			if (u && m_sleepyUpdates.contains(u))
+				m_sleepyUpdates.erase(u);
+		}
+#endif
 
 
 		currentObject->removeFromList(&m_objList);//remove from object list
@@ -2832,6 +2864,7 @@ void GameLogic::deselectObject(Object *obj, PlayerMaskType playerMask, Bool affe
 	}
 }
 
+#if RETAIL_COMPATIBLE_SLEEPY_UPDATES
 // ------------------------------------------------------------------------------------------------
 inline void GameLogic::validateSleepyUpdate() const
 {
@@ -3095,6 +3128,20 @@ void GameLogic::popSleepyUpdate()
 	}
 }
 
+#else
+
+// ------------------------------------------------------------------------------------------------
+void GameLogic::pushSleepyUpdate(UpdateModulePtr u)
+{
+	USE_PERF_TIMER(SleepyMaintenance)
+
+	DEBUG_ASSERTCRASH(u != nullptr, ("You may not pass null for sleepy update info"));
+
+	m_sleepyUpdates.push(u);
+}
+
+#endif
+
 // ------------------------------------------------------------------------------------------------
 // this should be called only by UpdateModule, thanks.
 // ------------------------------------------------------------------------------------------------
@@ -3127,6 +3174,7 @@ void GameLogic::friend_awakenUpdateModule(Object* obj, UpdateModulePtr u, Unsign
 	Int idx = u->friend_getIndexInLogic();
 	if (obj->isInList(&m_objList))
 	{
+#if RETAIL_COMPATIBLE_SLEEPY_UPDATES
 		if (idx < 0 || idx >= m_sleepyUpdates.size())
 		{
 			RELEASE_CRASH("fatal error! sleepy update module illegal index.");
@@ -3147,6 +3195,17 @@ void GameLogic::friend_awakenUpdateModule(Object* obj, UpdateModulePtr u, Unsign
 
 		// validate. (harmless except in debug mode)
 		validateSleepyUpdate();
+#else
+		if (!m_sleepyUpdates.contains(u))
+		{
+			RELEASE_CRASH("fatal error! sleepy update module index mismatch.");
+			return;
+		}
+
+		// update the value and move it to its new wake frame.
+		u->friend_setNextCallFrame(whenToWakeUp);
+		m_sleepyUpdates.reschedule(u);
+#endif
 
 		return;
 	}
@@ -3742,6 +3801,7 @@ void GameLogic::update()
 
 	// update (execute) scripts
 	{
+		ReplayBenchmarkScope benchmarkScope(REPLAY_BENCHMARK_SCRIPT_ENGINE);
 		TheScriptEngine->UPDATE();
 	}
 
@@ -3754,6 +3814,7 @@ void GameLogic::update()
 	// Note - TerrainLogic update needs to happen after ScriptEngine update, but before object updates.  jba.
 	// This way changes in bridges are noted in the script engine before being cleared in TerrainLogic->update
 	{
+		ReplayBenchmarkScope benchmarkScope(REPLAY_BENCHMARK_TERRAIN_LOGIC);
 		TheTerrainLogic->UPDATE();
 	}
 
@@ -3771,7 +3832,21 @@ void GameLogic::update()
 
 	if (generateForSolo || generateForMP)
 	{
-		m_CRC = getCRC( CRC_RECALC );
+		{
+			ReplayBenchmarkScope benchmarkScope(REPLAY_BENCHMARK_CRC);
+			m_CRC = getCRC( CRC_RECALC );
+		}
+
+		if (!m_deepCRCDumps.empty())
+		{
+			DeepCRCDumpMap::const_iterator it = m_deepCRCDumps.find(m_frame);
+			if (it != m_deepCRCDumps.end())
+			{
+				AsciiString indexFileName;
+				indexFileName.format("%s.idx", it->second.str());
+				getCRC( CRC_RECALC, it->second, indexFileName );
+			}
+		}
 		bool isPlayback = (TheRecorder && TheRecorder->isPlaybackMode());
 
 		GameMessage *msg = newInstance(GameMessage)(GameMessage::MSG_LOGIC_CRC);
@@ -3839,6 +3914,8 @@ void GameLogic::update()
 #endif
 
 	{
+		ReplayBenchmarkScope benchmarkScope(REPLAY_BENCHMARK_SLEEPY_UPDATES);
+#if RETAIL_COMPATIBLE_SLEEPY_UPDATES
 		while (!m_sleepyUpdates.empty())
 		{
 			UpdateModulePtr u = peekSleepyUpdate();
@@ -3855,6 +3932,11 @@ void GameLogic::update()
 			{
 				break;
 			}
+#else
+		// the wheel returns null once everyone else is sleeping.
+		while (UpdateModulePtr u = m_sleepyUpdates.peek(now))
+		{
+#endif
 
 			UpdateSleepTime sleepLen = UPDATE_SLEEP_NONE;	// default, if it is disabled.
 
@@ -3885,24 +3967,33 @@ void GameLogic::update()
 
 			// else defer it till next frame and re-push it
 			u->friend_setNextCallFrame(now + sleepLen);
+#if RETAIL_COMPATIBLE_SLEEPY_UPDATES
 			rebalanceSleepyUpdate(0);
+#else
+			m_sleepyUpdates.reschedule(u);
+#endif
 		}
 	}
 
+#if RETAIL_COMPATIBLE_SLEEPY_UPDATES
 	validateSleepyUpdate();
+#endif
 
 	// update the Artificial Intelligence system
 	{
+		ReplayBenchmarkScope benchmarkScope(REPLAY_BENCHMARK_AI);
 		TheAI->UPDATE();
 	}
 
 	// production updates
 	{
+		ReplayBenchmarkScope benchmarkScope(REPLAY_BENCHMARK_BUILD_ASSISTANT);
 		TheBuildAssistant->UPDATE();
 	}
 
 	// update partition info
 	{
+		ReplayBenchmarkScope benchmarkScope(REPLAY_BENCHMARK_PARTITION_MANAGER);
 		ThePartitionManager->UPDATE();
 	}
 
@@ -3911,7 +4002,10 @@ void GameLogic::update()
 	//
 
 	// destroy all pending objects
-	processDestroyList();
+	{
+		ReplayBenchmarkScope benchmarkScope(REPLAY_BENCHMARK_DESTROY_LIST);
+		processDestroyList();
+	}
 
 	// reset the command list, destroying all messages
 	TheCommandList->reset();
@@ -4143,7 +4237,7 @@ void GameLogic::destroyObject( Object *obj )
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 Bool inCRCGen = FALSE;
-UnsignedInt GameLogic::getCRC( Int mode, AsciiString deepCRCFileName )
+UnsignedInt GameLogic::getCRC( Int mode, AsciiString deepCRCFileName, AsciiString deepCRCIndexFileName )
 {
 	if (mode != CRC_RECALC)
 		return m_CRC;
@@ -4156,8 +4250,11 @@ UnsignedInt GameLogic::getCRC( Int mode, AsciiString deepCRCFileName )
 	AsciiString marker;
 	if (deepCRCFileName.isNotEmpty())
 	{
-		xferCRC = NEW XferDeepCRC;
-		xferCRC->open(deepCRCFileName.str());
+		XferDeepCRC *xferDeepCRC = NEW XferDeepCRC;
+		xferDeepCRC->open(deepCRCFileName.str());
+		if (deepCRCIndexFileName.isNotEmpty())
+			xferDeepCRC->openIndex(deepCRCIndexFileName);
+		xferCRC = xferDeepCRC;
 	}
 	else
 	{
@@ -4193,8 +4290,15 @@ UnsignedInt GameLogic::getCRC( Int mode, AsciiString deepCRCFileName )
 
 	marker = "MARKER:Objects";
 	xferCRC->xferAsciiString(&marker);
+	const Bool labelObjects = xferCRC->getXferMode() == XFER_SAVE;
 	for( obj = m_objList; obj; obj=obj->getNextObject() )
 	{
+		if (labelObjects)
+		{
+			AsciiString label;
+			label.format("Object %u %s", (UnsignedInt)obj->getID(), obj->getTemplate()->getName().str());
+			xferCRC->xferMarkerLabel(label);
+		}
 		xferCRC->xferSnapshot( obj );
 	}
 	UnsignedInt seed = GetGameLogicRandomSeedCRC();
@@ -5380,11 +5484,15 @@ void GameLogic::loadPostProcess()
 			m_nextObjID = (ObjectID)((UnsignedInt)obj->getID() + 1);
 
 	// blow away the sleepy update and normal update module lists
+#if RETAIL_COMPATIBLE_SLEEPY_UPDATES
 	for (std::vector<UpdateModulePtr>::iterator it = m_sleepyUpdates.begin(); it != m_sleepyUpdates.end(); ++it)
 	{
 		(*it)->friend_setIndexInLogic(-1);
 	}
 	m_sleepyUpdates.clear();
+#else
+	m_sleepyUpdates.release(getFrame());
+#endif
 #ifdef ALLOW_NONSLEEPY_UPDATES
 	m_normalUpdates.clear();
 #else
@@ -5426,15 +5534,21 @@ void GameLogic::loadPostProcess()
 				u->friend_setNextCallFrame(now);
 #endif
 			{
+#if RETAIL_COMPATIBLE_SLEEPY_UPDATES
 				m_sleepyUpdates.push_back(u);
 				u->friend_setIndexInLogic(m_sleepyUpdates.size() - 1);
+#else
+				pushSleepyUpdate(u);
+#endif
 			}
 
 		}
 
 	}
 
+#if RETAIL_COMPATIBLE_SLEEPY_UPDATES
 	// re-sort the priority queue all at once now that all modules are on it
 	remakeSleepyUpdate();
+#endif
 
 }